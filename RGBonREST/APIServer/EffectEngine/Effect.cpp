@@ -0,0 +1,134 @@
+//
+// @file : Effect.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class Effect
+//
+
+#include "Effect.h"
+
+#define EFFECT_PI 3.14159265358979323846
+
+
+/**
+ * A static member function for class Effect that computes the color of an effect at a point of time.
+ * Effects are periodic, and one period takes 1 / speed seconds.
+ * @param parameters the effect to render. colors must not be empty.
+ * @param elapsed seconds since the effect was started.
+ * @param offset how far the target is shifted in the period, from 0 to 1. Only wave uses this, so that targets light
+ * up one after another.
+ * @return returns the color of the target at that point of time.
+ */
+EffectColor Effect::render(const EffectParameters& parameters, double elapsed, double offset) {
+    double phase = elapsed * parameters.speed;
+    double fraction = phase - std::floor(phase); // where we are in the current period, from 0 to 1
+    const EffectColor& first = parameters.colors.front();
+
+    switch (parameters.type) {
+        case EffectStatic:
+            return first;
+        case EffectBreathing: // fade in and out smoothly
+            return Effect::scale(first, (1.0 - std::cos(2.0 * EFFECT_PI * fraction)) / 2.0);
+        case EffectRainbow: // go around the color wheel
+            return Effect::hueToColor(fraction);
+        case EffectWave: { // a breathing effect that reaches each target a bit later
+            double shifted = fraction - offset;
+            return Effect::scale(first, (1.0 - std::cos(2.0 * EFFECT_PI * shifted)) / 2.0);
+        }
+        case EffectStrobe: // on for the first half of the period, off for the rest
+            return fraction < 0.5 ? first : EffectColor{0, 0, 0};
+        case EffectColorCycle: { // fade from each color into the next, one color per period
+            size_t count = parameters.colors.size();
+            size_t index = (size_t) std::floor(phase) % count;
+            return Effect::blend(parameters.colors[index], parameters.colors[(index + 1) % count], fraction);
+        }
+        default:
+            return first;
+    }
+}
+
+/**
+ * A static member function for class Effect that converts the name of an effect into EffectType.
+ * @param name the name of the effect, such as "rainbow" or "color_cycle".
+ * @param type the converted EffectType is stored here.
+ * @return returns true if there was an effect with that name.
+ */
+bool Effect::convertEffectType(const string& name, EffectType& type) {
+    if (name == "static") type = EffectStatic;
+    else if (name == "breathing") type = EffectBreathing;
+    else if (name == "rainbow") type = EffectRainbow;
+    else if (name == "wave") type = EffectWave;
+    else if (name == "strobe") type = EffectStrobe;
+    else if (name == "color_cycle") type = EffectColorCycle;
+    else return false;
+    return true;
+}
+
+/**
+ * A static member function for class Effect that converts EffectType into its name.
+ * @param type the EffectType to convert.
+ * @return returns the name of the effect.
+ */
+string Effect::convertEffectType(EffectType type) {
+    switch (type) {
+        case EffectStatic:
+            return "static";
+        case EffectBreathing:
+            return "breathing";
+        case EffectRainbow:
+            return "rainbow";
+        case EffectWave:
+            return "wave";
+        case EffectStrobe:
+            return "strobe";
+        case EffectColorCycle:
+            return "color_cycle";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * A static member function for class Effect that changes the brightness of a color.
+ * @param color the color to scale.
+ * @param brightness the brightness from 0 to 1.
+ * @return returns the scaled color.
+ */
+EffectColor Effect::scale(const EffectColor& color, double brightness) {
+    return EffectColor{(int) std::lround(color.r * brightness),
+                       (int) std::lround(color.g * brightness),
+                       (int) std::lround(color.b * brightness)};
+}
+
+/**
+ * A static member function for class Effect that mixes two colors.
+ * @param from the color at ratio 0.
+ * @param to the color at ratio 1.
+ * @param ratio how much of to is in the result, from 0 to 1.
+ * @return returns the mixed color.
+ */
+EffectColor Effect::blend(const EffectColor& from, const EffectColor& to, double ratio) {
+    return EffectColor{(int) std::lround(from.r + (to.r - from.r) * ratio),
+                       (int) std::lround(from.g + (to.g - from.g) * ratio),
+                       (int) std::lround(from.b + (to.b - from.b) * ratio)};
+}
+
+/**
+ * A static member function for class Effect that converts a hue into a fully saturated and bright color.
+ * @param hue the hue from 0 to 1, where 0 is red.
+ * @return returns the color of that hue.
+ */
+EffectColor Effect::hueToColor(double hue) {
+    double sector = hue * 6.0;
+    int index = (int) std::floor(sector) % 6;
+    int rising = (int) std::lround((sector - std::floor(sector)) * 255.0);
+    int falling = 255 - rising;
+
+    switch (index) {
+        case 0: return EffectColor{255, rising, 0};
+        case 1: return EffectColor{falling, 255, 0};
+        case 2: return EffectColor{0, 255, rising};
+        case 3: return EffectColor{0, falling, 255};
+        case 4: return EffectColor{rising, 0, 255};
+        default: return EffectColor{255, 0, falling};
+    }
+}
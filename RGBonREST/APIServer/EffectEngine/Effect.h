@@ -0,0 +1,66 @@
+//
+// @file : Effect.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class Effect
+//
+
+#ifndef RGBONREST_EFFECT_H
+#define RGBONREST_EFFECT_H
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cmath>
+
+using std::string;
+using std::vector;
+
+
+/**
+ * An enum that represents built in effects.
+ */
+enum EffectType {
+    EffectStatic = 0,
+    EffectBreathing = 1,
+    EffectRainbow = 2,
+    EffectWave = 3,
+    EffectStrobe = 4,
+    EffectColorCycle = 5
+};
+
+/**
+ * A struct that stores a single color of an effect.
+ */
+typedef struct effectColor {
+    int r;
+    int g;
+    int b;
+} EffectColor;
+
+/**
+ * A struct that stores how an effect looks.
+ * speed is how many cycles the effect goes through in a second.
+ */
+typedef struct effectParameters {
+    EffectType type;
+    vector<EffectColor> colors;
+    double speed = 1.0;
+} EffectParameters;
+
+/**
+ * A class that computes colors of built in effects.
+ * This class has all static member functions, so that an effect is nothing more than its EffectParameters.
+ */
+class Effect {
+private:
+    static EffectColor scale(const EffectColor&, double);
+    static EffectColor blend(const EffectColor&, const EffectColor&, double);
+    static EffectColor hueToColor(double);
+public:
+    static EffectColor render(const EffectParameters&, double, double);
+    static bool convertEffectType(const string&, EffectType&);
+    static string convertEffectType(EffectType);
+};
+
+
+#endif //RGBONREST_EFFECT_H
@@ -0,0 +1,232 @@
+//
+// @file : EffectEngine.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class EffectEngine
+//
+
+#include "EffectEngine.h"
+
+
+/**
+ * A constructor member function for class EffectEngine.
+ * @param argSdks the pointer to the array of AbstractSDK* to push colors to.
+ * @param argFps how many frames to render in a second.
+ */
+EffectEngine::EffectEngine(vector<AbstractSDK*>* argSdks, unsigned int argFps) {
+    this->sdks = argSdks;
+    this->fps = argFps == 0 ? 1 : argFps;
+    this->renderThread = nullptr;
+    this->exitFlag = false;
+}
+
+/**
+ * A destructor member function for class EffectEngine.
+ * This stops the render thread if it is still running.
+ */
+EffectEngine::~EffectEngine() {
+    this->stop();
+}
+
+/**
+ * A member function for class EffectEngine that starts the render thread.
+ */
+void EffectEngine::start() {
+    this->renderThread = new thread(&EffectEngine::renderLoop, this);
+}
+
+/**
+ * A member function for class EffectEngine that stops the render thread.
+ * Colors that were already pushed to executors are still applied.
+ */
+void EffectEngine::stop() {
+    {
+        lock_guard<mutex> lock(this->effectsMutex);
+        this->exitFlag = true;
+    }
+    this->effectsCondition.notify_all();
+
+    if (this->renderThread != nullptr) {
+        this->renderThread->join();
+        delete this->renderThread;
+        this->renderThread = nullptr;
+    }
+}
+
+/**
+ * A member function for class EffectEngine that starts an effect on a target.
+ * If the target already had an effect running, the new one replaces it.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param deviceType the DeviceType to run the effect on.
+ * @param parameters the effect to run. colors must not be empty.
+ */
+void EffectEngine::startEffect(int sdkIndex, DeviceType deviceType, const EffectParameters& parameters) {
+    RunningEffect effect;
+    effect.sdkIndex = sdkIndex;
+    effect.deviceType = deviceType;
+    effect.parameters = parameters;
+    effect.startTime = steady_clock::now();
+
+    {
+        lock_guard<mutex> lock(this->effectsMutex);
+        this->effects[(uint16_t) ((sdkIndex << 8) | deviceType)] = effect;
+    }
+    this->effectsCondition.notify_all(); // wake up the render thread if it was idle
+}
+
+/**
+ * A member function for class EffectEngine that stops the effect on a target.
+ * The target keeps the color it had in the last frame.
+ * @param sdkIndex the index of the SDK in sdks, or -1 for every SDK.
+ * @param deviceType the DeviceType to stop the effect on.
+ * @return returns how many effects were stopped.
+ */
+int EffectEngine::stopEffect(int sdkIndex, DeviceType deviceType) {
+    lock_guard<mutex> lock(this->effectsMutex);
+    int stoppedCount = 0;
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++) {
+        if (sdkIndex != -1 && sdkIndex != i) continue;
+        stoppedCount += (int) this->effects.erase((uint16_t) ((i << 8) | deviceType));
+    }
+    return stoppedCount;
+}
+
+/**
+ * A member function for class EffectEngine that stops every effect.
+ * @return returns how many effects were stopped.
+ */
+int EffectEngine::stopAllEffects() {
+    lock_guard<mutex> lock(this->effectsMutex);
+    int stoppedCount = (int) this->effects.size();
+    this->effects.clear();
+    return stoppedCount;
+}
+
+/**
+ * A member function for class EffectEngine that returns every running effect.
+ * @return returns copies of the running effects.
+ */
+list<RunningEffect> EffectEngine::getEffects() {
+    lock_guard<mutex> lock(this->effectsMutex);
+    list<RunningEffect> result;
+    for (auto const& x : this->effects)
+        result.push_back(x.second);
+    return result;
+}
+
+/**
+ * A member function for class EffectEngine that starts playing an animation that was uploaded to an SDK.
+ * If the animation was already playing, it starts over from the first frame.
+ * Frames are shown at most as often as the render thread ticks, so fps above the rate of the engine skips frames.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param animationId the id that AbstractSDK::uploadAnimation returned.
+ * @param animationFps how many frames of the animation to show in a second.
+ */
+void EffectEngine::startAnimation(int sdkIndex, int animationId, double animationFps) {
+    RunningAnimation animation;
+    animation.sdkIndex = sdkIndex;
+    animation.animationId = animationId;
+    animation.fps = animationFps;
+    animation.startTime = steady_clock::now();
+
+    {
+        lock_guard<mutex> lock(this->effectsMutex);
+        this->animations[pair<int, int>(sdkIndex, animationId)] = animation;
+    }
+    this->effectsCondition.notify_all(); // wake up the render thread if it was idle
+}
+
+/**
+ * A member function for class EffectEngine that stops playing an animation.
+ * The device keeps showing the frame it showed last.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param animationId the id that AbstractSDK::uploadAnimation returned.
+ * @return returns true if the animation was playing.
+ */
+bool EffectEngine::stopAnimation(int sdkIndex, int animationId) {
+    lock_guard<mutex> lock(this->effectsMutex);
+    return this->animations.erase(pair<int, int>(sdkIndex, animationId)) > 0;
+}
+
+/**
+ * A member function for class EffectEngine that renders frames at a fixed rate until stop() was called.
+ * Frames are scheduled from the time the previous frame was due, not from when it finished, so the rate does not drift.
+ * If rendering falls behind, missed frames are skipped instead of being rendered in a burst.
+ */
+void EffectEngine::renderLoop() {
+    auto frameInterval = std::chrono::microseconds(1000000 / this->fps);
+    auto nextFrame = steady_clock::now();
+
+    unique_lock<mutex> lock(this->effectsMutex);
+    while (!this->exitFlag) {
+        if (this->effects.empty() && this->animations.empty()) { // nothing to render, so sleep until something starts.
+            this->effectsCondition.wait(lock, [this] {
+                return this->exitFlag || !this->effects.empty() || !this->animations.empty();
+            });
+            nextFrame = steady_clock::now();
+            continue;
+        }
+
+        auto now = steady_clock::now();
+        this->renderFrame(now);
+        this->renderAnimations(now);
+        this->frameCount++;
+
+        nextFrame += frameInterval;
+        if (nextFrame < now) nextFrame = now + frameInterval; // fell behind, skip missed frames.
+        this->effectsCondition.wait_until(lock, nextFrame, [this] { return this->exitFlag; });
+    }
+}
+
+/**
+ * A member function for class EffectEngine that renders a single frame.
+ * Colors are pushed with SDKExecutor::submitLatest, so an SDK that cannot keep up with the frame rate only applies the
+ * latest frame. This must be called while holding effectsMutex.
+ * @param now the time of this frame.
+ */
+void EffectEngine::renderFrame(steady_clock::time_point now) {
+    for (auto& x : this->effects) {
+        RunningEffect& effect = x.second;
+        double elapsed = std::chrono::duration<double>(now - effect.startTime).count();
+        double offset = (double) effect.deviceType / (RAM + 1); // spreads device types over the period for wave
+        EffectColor color = Effect::render(effect.parameters, elapsed, offset);
+
+        if (color.r == effect.lastColor.r && color.g == effect.lastColor.g && color.b == effect.lastColor.b)
+            continue; // nothing changed for this target
+        effect.lastColor = color;
+
+        AbstractSDK* sdk = this->sdks->at(effect.sdkIndex);
+        DeviceType deviceType = effect.deviceType;
+        sdk->executor->submitLatest(EFFECT_EXECUTOR_KEY_BASE + deviceType, [sdk, deviceType, color] {
+            try {
+                sdk->setRGB(deviceType, color.r, color.g, color.b);
+            } catch (const exception& e) { // not connected, invalid device type, failed RGBs
+            }
+        }, [] {});
+    }
+}
+
+/**
+ * A member function for class EffectEngine that pushes the current frame of every playing animation.
+ * Only the index of the frame is pushed, since the SDK already prepared every frame. Each animation has its own
+ * executor key, so an SDK that cannot keep up only shows the latest frame. This must be called while holding
+ * effectsMutex.
+ * @param now the time of this frame.
+ */
+void EffectEngine::renderAnimations(steady_clock::time_point now) {
+    for (auto& x : this->animations) {
+        RunningAnimation& animation = x.second;
+        double elapsed = std::chrono::duration<double>(now - animation.startTime).count();
+        auto frame = (long long) (elapsed * animation.fps);
+        if (frame == animation.lastFrame) continue; // still the same frame
+        animation.lastFrame = frame;
+
+        AbstractSDK* sdk = this->sdks->at(animation.sdkIndex);
+        int animationId = animation.animationId;
+        sdk->executor->submitLatest(ANIMATION_EXECUTOR_KEY_BASE + animationId, [sdk, animationId, frame] {
+            try {
+                sdk->showAnimationFrame(animationId, (size_t) frame);
+            } catch (const exception& e) { // not connected, deleted animation, failed SetEffect
+            }
+        }, [] {});
+    }
+}
@@ -0,0 +1,101 @@
+//
+// @file : EffectEngine.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class EffectEngine
+//
+
+#ifndef RGBONREST_EFFECTENGINE_H
+#define RGBONREST_EFFECTENGINE_H
+#pragma once
+
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <list>
+#include <exception>
+
+#include "./Effect.h"
+#include "../Utils/Defines.h"
+#include "../SDKEngine/AbstractSDK.h"
+
+using std::thread;
+using std::atomic;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
+using std::map;
+using std::list;
+using std::exception;
+using std::cout;
+using std::endl;
+using std::pair;
+using std::chrono::steady_clock;
+
+
+/**
+ * A struct that stores an effect that is running on a single (SDK, DeviceType) target.
+ */
+typedef struct runningEffect {
+    int sdkIndex;
+    DeviceType deviceType;
+    EffectParameters parameters;
+    steady_clock::time_point startTime;
+    EffectColor lastColor = {-1, -1, -1}; // the color that was pushed last, so that unchanged colors are not pushed.
+} RunningEffect;
+
+/**
+ * A struct that stores an animation that was uploaded to an SDK and is being played.
+ */
+typedef struct runningAnimation {
+    int sdkIndex;
+    int animationId;
+    double fps;
+    steady_clock::time_point startTime;
+    long long lastFrame = -1; // the frame that was pushed last, so that a frame is not pushed twice.
+} RunningAnimation;
+
+/**
+ * A class that renders effects inside the server.
+ * A render thread ticks at a fixed rate, computes the color of every running effect and pushes colors that changed to
+ * the executor of each SDK. So a client sends one request to start an effect instead of one request per frame, and
+ * frame timing does not depend on HTTP.
+ * Animations that were uploaded to an SDK are played by the same thread, which only tells the SDK which frame to show.
+ * The render thread sleeps while there are no effects or animations running.
+ */
+class EffectEngine {
+private:
+    vector<AbstractSDK*>* sdks;
+    unsigned int fps;
+    thread* renderThread;
+    mutex effectsMutex;
+    condition_variable effectsCondition;
+    map<uint16_t, RunningEffect> effects; // (sdkIndex << 8 | deviceType) -> effect
+    map<pair<int, int>, RunningAnimation> animations; // (sdkIndex, animationId) -> animation
+    bool exitFlag;
+
+    void renderLoop();
+    void renderFrame(steady_clock::time_point);
+    void renderAnimations(steady_clock::time_point);
+public:
+    atomic<uint64_t> frameCount{0};
+
+    EffectEngine(vector<AbstractSDK*>*, unsigned int);
+    ~EffectEngine();
+    void start();
+    void stop();
+    void startEffect(int, DeviceType, const EffectParameters&);
+    int stopEffect(int, DeviceType);
+    int stopAllEffects();
+    list<RunningEffect> getEffects();
+    void startAnimation(int, int, double);
+    bool stopAnimation(int, int);
+};
+
+
+#endif //RGBONREST_EFFECTENGINE_H
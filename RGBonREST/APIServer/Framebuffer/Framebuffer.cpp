@@ -0,0 +1,281 @@
+//
+// @file : Framebuffer.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class Framebuffer
+//
+
+#include "Framebuffer.h"
+
+
+/**
+ * A constructor member function for class Framebuffer.
+ * The layout is built when the framebuffer is first prepared. This must be called after every SDK got its executor,
+ * and before any job was submitted to them.
+ * @param argSdks the pointer to the array of AbstractSDK*.
+ */
+Framebuffer::Framebuffer(vector<AbstractSDK*>* argSdks) {
+    this->sdks = argSdks;
+    this->layoutVersion = 0;
+    this->connectionChanges = 1; // not built yet
+    this->builtConnectionChanges = 0;
+
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++) {
+        this->connectedStates.push_back(this->sdks->at(i)->isConnected);
+        this->sdks->at(i)->executor->setJobListener([this, i](int key) { this->onJobDone(i, key); });
+    }
+}
+
+/**
+ * A member function for class Framebuffer that builds the layout again if an SDK connected or disconnected.
+ * Devices are listed by a job on the executor of each SDK, so nothing waits and no SDK is called from two threads.
+ * Call this before write, flush, getLayout and getLedCount.
+ * @return returns a task that is done when the layout is up to date.
+ */
+pplx::task<void> Framebuffer::prepare() {
+    uint64_t changes;
+    {
+        lock_guard<mutex> lock(this->framebufferMutex);
+        if (this->builtConnectionChanges == this->connectionChanges) return pplx::task_from_result();
+        changes = this->connectionChanges;
+    }
+
+    bool isComplete = true;
+    vector<pplx::task<vector<FramebufferDevice>>> tasks;
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++) {
+        AbstractSDK* sdk = this->sdks->at(i);
+        pplx::task_completion_event<vector<FramebufferDevice>> completionEvent;
+        if (!sdk->executor->submit([sdk, completionEvent] { completionEvent.set(Framebuffer::collectDevices(sdk)); })) {
+            completionEvent.set(vector<FramebufferDevice>()); // a busy SDK is left out until the next rebuild
+            isComplete = false;
+        }
+        tasks.push_back(pplx::create_task(completionEvent));
+    }
+
+    return pplx::when_all(tasks.begin(), tasks.end()).then([this, changes, isComplete](const vector<vector<FramebufferDevice>>& devices) {
+        lock_guard<mutex> lock(this->framebufferMutex);
+        if (this->builtConnectionChanges == changes) return; // another request built the same layout first
+        this->rebuild(devices);
+        if (isComplete) this->builtConnectionChanges = changes;
+    });
+}
+
+/**
+ * A member function for class Framebuffer that writes colors into the framebuffer.
+ * Either every write is applied or none is, so a bad index does not leave half a frame behind.
+ * @param writes the writes to apply, in order.
+ * @return returns how many LEDs changed color.
+ * @throws Framebuffer::InvalidLedIndex when a write had an index that is not in the framebuffer.
+ * @throws SDKExceptions::InvalidRGBValue when a write had a color that is not from 0 to 255.
+ */
+size_t Framebuffer::write(const vector<FramebufferWrite>& writes) {
+    lock_guard<mutex> lock(this->framebufferMutex);
+
+    for (auto const& x : writes) { // check everything before writing anything
+        if (x.index >= this->segmentIndices.size())
+            throw Framebuffer::InvalidLedIndex();
+        if (x.r < 0 || x.r > 255 || x.g < 0 || x.g > 255 || x.b < 0 || x.b > 255)
+            throw SDKExceptions::InvalidRGBValue();
+    }
+
+    size_t changed = 0;
+    for (auto const& x : writes)
+        changed += this->writeLed(x);
+
+    this->changedCount += changed;
+    this->unchangedCount += writes.size() - changed;
+    return changed;
+}
+
+/**
+ * A member function for class Framebuffer that sends dirty LEDs of every device to its SDK.
+ * Each device gets one job on the executor of its SDK. The job picks up the dirty range when it runs, so if the
+ * framebuffer is written again before that, a single job still sends everything that changed.
+ */
+void Framebuffer::flush() {
+    lock_guard<mutex> lock(this->framebufferMutex);
+
+    for (size_t i = 0 ; i < this->segments.size() ; i++) {
+        const FramebufferSegment& segment = this->segments[i];
+        if (segment.dirtyBegin == segment.dirtyEnd) continue; // nothing changed for this device
+
+        uint64_t version = this->layoutVersion;
+        this->sdks->at(segment.sdkIndex)->executor->submitLatest((int) (FRAMEBUFFER_EXECUTOR_KEY_BASE + i),
+                                                             [this, i, version] { this->sendSegment(i, version); },
+                                                             [] {});
+    }
+}
+
+/**
+ * A member function for class Framebuffer that returns the layout of the framebuffer.
+ * @return returns a copy of every segment, in the order of their LED indices.
+ */
+vector<FramebufferSegment> Framebuffer::getLayout() {
+    lock_guard<mutex> lock(this->framebufferMutex);
+    return this->segments;
+}
+
+/**
+ * A member function for class Framebuffer that returns how many LEDs are in the framebuffer.
+ * @return returns the number of LEDs of every connected device.
+ */
+size_t Framebuffer::getLedCount() {
+    lock_guard<mutex> lock(this->framebufferMutex);
+    return this->segmentIndices.size();
+}
+
+/**
+ * A member function for class Framebuffer that is called on the executor of an SDK after each of its jobs.
+ * A job that connected or disconnected the SDK makes the layout stale. Any job that was not the framebuffer's own may
+ * have set colors, so the framebuffer no longer knows what the LEDs of that SDK show, and sends them on the next write
+ * even if the color is the same.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param key the executor key of the job, -1 for jobs without a key.
+ */
+void Framebuffer::onJobDone(int sdkIndex, int key) {
+    lock_guard<mutex> lock(this->framebufferMutex);
+    bool isConnected = this->sdks->at(sdkIndex)->isConnected;
+    if (this->connectedStates[sdkIndex] != isConnected) {
+        this->connectedStates[sdkIndex] = isConnected;
+        this->connectionChanges++;
+    }
+
+    if (key >= FRAMEBUFFER_EXECUTOR_KEY_BASE && key < ANIMATION_EXECUTOR_KEY_BASE) return; // a flush of the framebuffer
+    for (auto const& x : this->segments) {
+        if (x.sdkIndex == sdkIndex)
+            std::fill(this->shadowStates.begin() + x.first, this->shadowStates.begin() + x.first + x.ledIds.size(), false);
+    }
+}
+
+/**
+ * A static member function for class Framebuffer that lists the devices of an SDK with their LEDs.
+ * This must run on the executor of the SDK.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns every device in the order of DeviceType and then in the order the SDK lists them, or nothing if
+ * the SDK is not connected.
+ */
+vector<FramebufferDevice> Framebuffer::collectDevices(AbstractSDK* sdk) {
+    vector<FramebufferDevice> devices;
+    if (!sdk->isConnected) return devices;
+
+    for (auto const& category : sdk->devices) {
+        for (auto const& device : *category.second) {
+            try {
+                devices.push_back(FramebufferDevice{device, device->name, device->deviceType, sdk->getLedIds(device)});
+            } catch (const exception& e) { // leave out devices whose LEDs could not be listed
+            }
+        }
+    }
+    return devices;
+}
+
+/**
+ * A member function for class Framebuffer that builds the layout from devices of connected SDKs.
+ * SDKs are laid out in the order of sdks. Every LED starts black, and is sent on the first write even if that is
+ * black, since what devices show is not known. This must be called while holding framebufferMutex.
+ * @param devices the devices of each SDK, from collectDevices.
+ */
+void Framebuffer::rebuild(const vector<vector<FramebufferDevice>>& devices) {
+    this->segments.clear();
+    this->segmentIndices.clear();
+    this->layoutVersion++; // jobs for the old layout will do nothing
+
+    for (int i = 0 ; i < (int) devices.size() ; i++) {
+        for (auto const& x : devices[i]) {
+            FramebufferSegment segment;
+            segment.sdkIndex = i;
+            segment.device = x.device;
+            segment.name = x.name;
+            segment.deviceType = x.deviceType;
+            segment.first = this->segmentIndices.size();
+            segment.ledIds = x.ledIds;
+
+            this->segmentIndices.insert(this->segmentIndices.end(), segment.ledIds.size(), this->segments.size());
+            this->segments.push_back(segment);
+        }
+    }
+    this->colors.assign(this->segmentIndices.size() * 3, 0);
+    this->shadowStates.assign(this->segmentIndices.size(), false);
+}
+
+/**
+ * A member function for class Framebuffer that writes a single LED and marks it dirty if its color changed.
+ * This must be called while holding framebufferMutex, with an index that was checked.
+ * @param ledWrite the write to apply.
+ * @return returns true if the color of the LED changed.
+ */
+bool Framebuffer::writeLed(const FramebufferWrite& ledWrite) {
+    uint8_t* color = &this->colors[ledWrite.index * 3];
+    if (this->shadowStates[ledWrite.index] && color[0] == ledWrite.r && color[1] == ledWrite.g && color[2] == ledWrite.b)
+        return false; // re-sending the same color costs nothing
+
+    color[0] = (uint8_t) ledWrite.r;
+    color[1] = (uint8_t) ledWrite.g;
+    color[2] = (uint8_t) ledWrite.b;
+    this->shadowStates[ledWrite.index] = true;
+
+    FramebufferSegment& segment = this->segments[this->segmentIndices[ledWrite.index]];
+    size_t offset = ledWrite.index - segment.first;
+    markDirty(segment, offset, offset + 1);
+    return true;
+}
+
+/**
+ * A static member function for class Framebuffer that adds a range of LEDs to the dirty range of a device.
+ * This must be called while holding framebufferMutex.
+ * @param segment the segment of the device.
+ * @param begin the first LED of the range, relative to first.
+ * @param end one past the last LED of the range, relative to first.
+ */
+void Framebuffer::markDirty(FramebufferSegment& segment, size_t begin, size_t end) {
+    if (segment.dirtyBegin == segment.dirtyEnd) { // first dirty LEDs of this device
+        segment.dirtyBegin = begin;
+        segment.dirtyEnd = end;
+    } else {
+        segment.dirtyBegin = std::min(segment.dirtyBegin, begin);
+        segment.dirtyEnd = std::max(segment.dirtyEnd, end);
+    }
+}
+
+/**
+ * A member function for class Framebuffer that sends the dirty LEDs of a device to its SDK.
+ * This runs on the executor of the SDK. Colors are copied while holding framebufferMutex, and the SDK is called after
+ * releasing it, so that writes are never blocked by a slow SDK. Nothing is sent while the layout is stale, since the
+ * SDK may have deleted the device when it connected again.
+ * If the SDK fails, the LEDs are marked dirty again so that the next flush sends them, even if they are written with
+ * the same color meanwhile.
+ * @param segmentIndex the index of the segment of the device.
+ * @param version the layoutVersion when this job was submitted.
+ */
+void Framebuffer::sendSegment(size_t segmentIndex, uint64_t version) {
+    const Device* device;
+    AbstractSDK* sdk;
+    vector<LedColor> leds;
+    size_t sentBegin;
+    size_t sentEnd;
+    {
+        lock_guard<mutex> lock(this->framebufferMutex);
+        if (version != this->layoutVersion || this->builtConnectionChanges != this->connectionChanges)
+            return; // the device might not be there anymore
+
+        FramebufferSegment& segment = this->segments[segmentIndex];
+        for (size_t i = segment.dirtyBegin ; i < segment.dirtyEnd ; i++) {
+            const uint8_t* color = &this->colors[(segment.first + i) * 3];
+            leds.push_back(LedColor{segment.ledIds[i], color[0], color[1], color[2]});
+        }
+        sentBegin = segment.dirtyBegin;
+        sentEnd = segment.dirtyEnd;
+        segment.dirtyBegin = segment.dirtyEnd = 0;
+        device = segment.device;
+        sdk = this->sdks->at(segment.sdkIndex);
+    }
+
+    if (leds.empty()) return;
+    this->sentCount += leds.size();
+    try {
+        sdk->setLedColors(device, leds);
+    } catch (const exception& e) { // not connected, failed RGBs.
+        lock_guard<mutex> lock(this->framebufferMutex);
+        if (version != this->layoutVersion) return; // the segment is not there anymore
+        markDirty(this->segments[segmentIndex], sentBegin, sentEnd);
+    }
+}
@@ -0,0 +1,119 @@
+//
+// @file : Framebuffer.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class Framebuffer
+//
+
+#ifndef RGBONREST_FRAMEBUFFER_H
+#define RGBONREST_FRAMEBUFFER_H
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <exception>
+#include <algorithm>
+#include <pplx/pplxtasks.h>
+
+#include "../Utils/Defines.h"
+#include "../SDKEngine/AbstractSDK.h"
+
+using std::mutex;
+using std::lock_guard;
+using std::atomic;
+using std::string;
+using std::vector;
+using std::list;
+using std::exception;
+
+
+/**
+ * A struct that stores a device and its LEDs, as its SDK listed them on its executor.
+ * name and deviceType are copies, so that they can be read without touching the SDK.
+ */
+typedef struct framebufferDevice {
+    const Device* device;
+    string name;
+    DeviceType deviceType;
+    vector<int> ledIds;
+} FramebufferDevice;
+
+/**
+ * A struct that stores the LEDs of a single device in the framebuffer.
+ * The LEDs of a device are framebuffer indices first to first + ledIds.size() - 1.
+ * device is only used on the executor of its SDK, since the SDK may delete it when it connects again.
+ * dirtyBegin and dirtyEnd are the range of LEDs of this device that changed since they were last sent, relative to
+ * first. The range is empty when they are equal.
+ */
+typedef struct framebufferSegment {
+    int sdkIndex;
+    const Device* device;
+    string name;
+    DeviceType deviceType;
+    size_t first;
+    vector<int> ledIds;
+    size_t dirtyBegin = 0;
+    size_t dirtyEnd = 0;
+} FramebufferSegment;
+
+/**
+ * A struct that stores a single write into the framebuffer.
+ */
+typedef struct framebufferWrite {
+    size_t index;
+    int r;
+    int g;
+    int b;
+} FramebufferWrite;
+
+/**
+ * A class that keeps the color of every LED of every connected device in one contiguous array.
+ * Every LED has a stable index, which stays the same as long as the set of connected SDKs does not change.
+ * Writing a color that an LED already has does nothing. Writing a new color marks the LED dirty, and flush() sends only
+ * the dirty LEDs of each device to its SDK through the SDK's executor.
+ * Devices are only ever read on the executors of their SDKs. The framebuffer watches every job of every executor, so it
+ * knows when an SDK connected or disconnected, and when something else than the framebuffer set colors of an SDK.
+ */
+class Framebuffer {
+private:
+    vector<AbstractSDK*>* sdks;
+    mutex framebufferMutex;
+    vector<FramebufferSegment> segments;
+    vector<size_t> segmentIndices; // LED index -> index of its segment
+    vector<uint8_t> colors; // r, g, b of LED 0, then r, g, b of LED 1 ...
+    vector<bool> shadowStates; // LED index -> whether the device has or is about to get the color in colors
+    vector<bool> connectedStates; // isConnected of each SDK, as its executor last saw it
+    uint64_t layoutVersion;
+    uint64_t connectionChanges; // how many times an SDK connected or disconnected
+    uint64_t builtConnectionChanges; // connectionChanges that the layout was built for
+
+    void onJobDone(int, int);
+    void rebuild(const vector<vector<FramebufferDevice>>&);
+    bool writeLed(const FramebufferWrite&);
+    void sendSegment(size_t, uint64_t);
+    static void markDirty(FramebufferSegment&, size_t, size_t);
+    static vector<FramebufferDevice> collectDevices(AbstractSDK*);
+public:
+    atomic<uint64_t> changedCount{0};
+    atomic<uint64_t> unchangedCount{0};
+    atomic<uint64_t> sentCount{0};
+
+    explicit Framebuffer(vector<AbstractSDK*>*);
+    pplx::task<void> prepare();
+    size_t write(const vector<FramebufferWrite>&);
+    void flush();
+    vector<FramebufferSegment> getLayout();
+    size_t getLedCount();
+
+    /**
+     * A class that is for exception when a write had an index that is not in the framebuffer.
+     */
+    class InvalidLedIndex : public exception {
+    };
+};
+
+
+#endif //RGBONREST_FRAMEBUFFER_H
@@ -10,8 +10,35 @@
 
 #include <iostream>
 #include <string>
+#include <map>
+#include <cstdint>
 
 using std::string;
+using std::map;
+
+
+/**
+ * A struct that stores everything that is known about a handled request, for loggers that keep more than strings.
+ * statusCode is the HTTP status that was replied, or 0 when unknown. target is the DeviceType of the request, and
+ * r, g and b its color, each -1 when the request had none. latencyUs is how long SDKs took from when the request was
+ * queued until they were done with it.
+ * An entry can stand for count identical requests in a row, the first at timeUs and the last spanUs after it. timeUs
+ * is microseconds since epoch, or 0 for when the entry is logged.
+ */
+typedef struct logEntry {
+    string endpoint;
+    string parameters;
+    string result;
+    int statusCode = 0;
+    int target = -1;
+    int r = -1;
+    int g = -1;
+    int b = -1;
+    uint64_t latencyUs = 0;
+    uint64_t timeUs = 0;
+    uint32_t count = 1;
+    uint64_t spanUs = 0;
+} LogEntry;
 
 
 /**
@@ -21,7 +48,26 @@ class AbstractLogger {
 public:
     string loggerName;
 public:
+    virtual ~AbstractLogger() = default;
     virtual void log(const string&, const string&, const string&) = 0;
+
+    /**
+     * A member function for class AbstractLogger that logs a handled request with everything known about it.
+     * This default implementation only logs the strings of the entry, so count and spanUs are lost.
+     * @param entry the LogEntry to log.
+     */
+    virtual void logRequest(const LogEntry& entry) {
+        this->log(entry.endpoint, entry.parameters, entry.result);
+    }
+
+    /**
+     * A member function for class AbstractLogger that returns counters of the logger.
+     * These are shown by /general/statistics/ under logger.
+     * @return returns name -> value of every counter. This default implementation has no counters.
+     */
+    virtual map<string, uint64_t> getStatistics() {
+        return map<string, uint64_t>();
+    }
 };
 
 
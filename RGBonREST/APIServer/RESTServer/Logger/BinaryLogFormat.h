@@ -0,0 +1,81 @@
+//
+// @file : BinaryLogFormat.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the layout of segment files that BinaryLogger writes
+//
+
+#ifndef RGBONREST_BINARYLOGFORMAT_H
+#define RGBONREST_BINARYLOGFORMAT_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+#define BINARY_LOG_MAGIC "RORBLOG" // the first 8 bytes of every segment file, including the terminating null
+#define BINARY_LOG_VERSION 2
+#define BINARY_LOG_MAX_ENDPOINTS 256 // endpoint id 0 is used for endpoints that did not fit
+#define BINARY_LOG_ENDPOINT_NAME_SIZE 64
+
+
+/**
+ * A struct that is the header at the start of every segment file.
+ * Every segment has the same endpoint table, so that each segment can be read without the others.
+ * endpoints[id - 1] is the name of endpoint id, for ids from 1 to endpointCount.
+ */
+typedef struct binaryLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t recordCapacity;
+    uint32_t segmentIndex;
+    uint32_t segmentCount;
+    uint32_t endpointCount;
+    char reserved[28];
+    char endpoints[BINARY_LOG_MAX_ENDPOINTS][BINARY_LOG_ENDPOINT_NAME_SIZE];
+} BinaryLogHeader;
+
+/**
+ * A struct that is a single record of a segment file. Every number is in the byte order of the machine that wrote it.
+ * sequence is the position of the record in the whole log plus 1, and is written last so that a slot with sequence 0
+ * was never written. Record n is always at slot (n - 1) % recordCapacity of segment ((n - 1) / recordCapacity) %
+ * segmentCount, and sorting records by sequence puts them in the order they were logged.
+ * timestampUs is microseconds since epoch. statusCode is the HTTP status that was replied, or 0 when unknown.
+ * target is a DeviceType, or -1 when the request had none. r, g and b are only meaningful when hasColor is 1.
+ * A record can stand for count identical requests in a row, the last one spanMs after timestampUs.
+ */
+typedef struct binaryLogRecord {
+    uint64_t sequence;
+    uint64_t timestampUs;
+    uint32_t latencyUs;
+    uint32_t spanMs;
+    uint32_t count;
+    uint16_t endpointId;
+    uint16_t statusCode;
+    int8_t target;
+    uint8_t hasColor;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t reserved[3];
+} BinaryLogRecord;
+
+static_assert(sizeof(BinaryLogHeader) == 64 + BINARY_LOG_MAX_ENDPOINTS * BINARY_LOG_ENDPOINT_NAME_SIZE,
+              "BinaryLogHeader must not have padding");
+static_assert(sizeof(BinaryLogRecord) == 40, "BinaryLogRecord must not have padding");
+
+
+/**
+ * A function that returns the name of a segment file.
+ * @param baseName the log_logfile that the segments belong to.
+ * @param segmentIndex the index of the segment.
+ * @return returns baseName.segmentIndex, for example log.bin.0
+ */
+inline string binaryLogSegmentName(const string& baseName, uint32_t segmentIndex) {
+    return baseName + "." + std::to_string(segmentIndex);
+}
+
+
+#endif //RGBONREST_BINARYLOGFORMAT_H
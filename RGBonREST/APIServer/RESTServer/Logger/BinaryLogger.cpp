@@ -0,0 +1,332 @@
+//
+// @file : BinaryLogger.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class BinaryLogger
+//
+
+#include "BinaryLogger.h"
+
+
+/**
+ * A constructor member function for class BinaryLogger.
+ * Segments that already exist with the same layout are kept, and logging continues after their newest record.
+ * @param argBaseName the name that segment files are named after, as baseName.0, baseName.1 and so on.
+ * @param argSegmentCount how many segment files make up the ring.
+ * @param argRecordCapacity how many records a single segment holds.
+ * @throws BinaryLogger::segmentOpenFailedError when a segment file could not be opened or mapped.
+ */
+BinaryLogger::BinaryLogger(const string& argBaseName, uint32_t argSegmentCount, uint32_t argRecordCapacity) {
+    this->loggerName = "Binary";
+    this->baseName = argBaseName;
+    this->segmentCount = argSegmentCount > 0 ? argSegmentCount : 1;
+    this->recordCapacity = argRecordCapacity > 0 ? argRecordCapacity : 1;
+    this->openSegments();
+    this->startPosition = this->nextPosition.load();
+    cout << "[+] Opened " << this->segmentCount << " log segments" << endl;
+}
+
+/**
+ * A destructor member function for class BinaryLogger.
+ * This writes every mapped page to disk, then unmaps and closes every segment file.
+ */
+BinaryLogger::~BinaryLogger() {
+    this->closeSegments();
+    cout << "[+] Log segments were closed" << endl;
+}
+
+/**
+ * A member function that opens and maps every segment file.
+ * When any segment is missing or has a different layout, every segment is started over, since sequences and
+ * endpoint ids of the remaining ones would not match the new ones.
+ * @throws BinaryLogger::segmentOpenFailedError when a segment file could not be opened or mapped.
+ */
+void BinaryLogger::openSegments() {
+    for (uint32_t i = 0 ; i < this->segmentCount ; i++) {
+        BinaryLogSegment segment;
+        if (!this->openSegment(i, segment)) {
+            this->closeSegments();
+            throw BinaryLogger::segmentOpenFailedError();
+        }
+        this->segments.push_back(segment);
+    }
+
+    bool isValid = true;
+    for (uint32_t i = 0 ; i < this->segmentCount ; i++)
+        isValid = isValid && this->isValidSegment(i);
+
+    if (isValid) {
+        this->loadEndpoints();
+        this->nextPosition = this->findNextPosition();
+    } else {
+        for (uint32_t i = 0 ; i < this->segmentCount ; i++)
+            this->resetSegment(i);
+    }
+}
+
+/**
+ * A member function that opens a single segment file and maps all of it.
+ * A file that does not have the size of a segment is emptied and grown to that size first.
+ * @param segmentIndex the index of the segment to open.
+ * @param segment the BinaryLogSegment to store the opened segment into.
+ * @return returns true if the segment was mapped, false if not.
+ */
+bool BinaryLogger::openSegment(uint32_t segmentIndex, BinaryLogSegment& segment) {
+    string fileName = binaryLogSegmentName(this->baseName, segmentIndex);
+    segment.size = sizeof(BinaryLogHeader) + (size_t) this->recordCapacity * sizeof(BinaryLogRecord);
+    segment.memory = nullptr;
+
+#ifdef _WIN32
+    segment.mappingHandle = nullptr;
+    segment.fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                     OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (segment.fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(segment.fileHandle, &fileSize) || (size_t) fileSize.QuadPart != segment.size) {
+        LARGE_INTEGER zero;
+        zero.QuadPart = 0;
+        SetFilePointerEx(segment.fileHandle, zero, nullptr, FILE_BEGIN);
+        SetEndOfFile(segment.fileHandle); // mapping grows the file back with zeros
+    }
+
+    segment.mappingHandle = CreateFileMappingA(segment.fileHandle, nullptr, PAGE_READWRITE,
+                                               (DWORD) ((uint64_t) segment.size >> 32),
+                                               (DWORD) (segment.size & 0xFFFFFFFF), nullptr);
+    if (segment.mappingHandle == nullptr) {
+        CloseHandle(segment.fileHandle);
+        return false;
+    }
+    segment.memory = (char*) MapViewOfFile(segment.mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, segment.size);
+    if (segment.memory == nullptr) {
+        CloseHandle(segment.mappingHandle);
+        CloseHandle(segment.fileHandle);
+        return false;
+    }
+#else
+    segment.fd = open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+    if (segment.fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(segment.fd, &fileStat) != 0 || (size_t) fileStat.st_size != segment.size) {
+        if (ftruncate(segment.fd, 0) != 0 || ftruncate(segment.fd, (off_t) segment.size) != 0) { // zero filled
+            close(segment.fd);
+            return false;
+        }
+    }
+
+    void* memory = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+    if (memory == MAP_FAILED) {
+        close(segment.fd);
+        return false;
+    }
+    segment.memory = (char*) memory;
+#endif
+    return true;
+}
+
+/**
+ * A member function that writes every mapped segment to disk, then unmaps and closes it.
+ */
+void BinaryLogger::closeSegments() {
+    for (auto const& x : this->segments) {
+#ifdef _WIN32
+        FlushViewOfFile(x.memory, x.size);
+        UnmapViewOfFile(x.memory);
+        CloseHandle(x.mappingHandle);
+        CloseHandle(x.fileHandle);
+#else
+        msync(x.memory, x.size, MS_SYNC);
+        munmap(x.memory, x.size);
+        close(x.fd);
+#endif
+    }
+    this->segments.clear();
+}
+
+/**
+ * A member function that checks if a segment was written with the same layout as this logger uses.
+ * @param segmentIndex the index of the segment to check.
+ * @return returns true if the header matches, false if the segment needs to be started over.
+ */
+bool BinaryLogger::isValidSegment(uint32_t segmentIndex) {
+    BinaryLogHeader* header = this->headerAt(segmentIndex);
+    return memcmp(header->magic, BINARY_LOG_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == BINARY_LOG_VERSION && header->headerSize == sizeof(BinaryLogHeader) &&
+           header->recordSize == sizeof(BinaryLogRecord) && header->recordCapacity == this->recordCapacity &&
+           header->segmentIndex == segmentIndex && header->segmentCount == this->segmentCount &&
+           header->endpointCount <= BINARY_LOG_MAX_ENDPOINTS;
+}
+
+/**
+ * A member function that empties a segment and writes a new header with no endpoints.
+ * @param segmentIndex the index of the segment to start over.
+ */
+void BinaryLogger::resetSegment(uint32_t segmentIndex) {
+    memset(this->segments[segmentIndex].memory, 0, this->segments[segmentIndex].size);
+
+    BinaryLogHeader* header = this->headerAt(segmentIndex);
+    memcpy(header->magic, BINARY_LOG_MAGIC, sizeof(header->magic));
+    header->version = BINARY_LOG_VERSION;
+    header->headerSize = sizeof(BinaryLogHeader);
+    header->recordSize = sizeof(BinaryLogRecord);
+    header->recordCapacity = this->recordCapacity;
+    header->segmentIndex = segmentIndex;
+    header->segmentCount = this->segmentCount;
+    header->endpointCount = 0;
+}
+
+/**
+ * A member function that loads the endpoint table of existing segments, so that new records keep the same ids.
+ */
+void BinaryLogger::loadEndpoints() {
+    BinaryLogHeader* header = this->headerAt(0);
+    for (uint32_t i = 0 ; i < header->endpointCount ; i++) {
+        this->endpointNames[i] = string(header->endpoints[i], strnlen(header->endpoints[i], BINARY_LOG_ENDPOINT_NAME_SIZE));
+        this->endpointHashes[i] = std::hash<string>()(this->endpointNames[i]);
+    }
+    this->endpointCount = header->endpointCount;
+}
+
+/**
+ * A member function that finds where logging continues in existing segments.
+ * @return returns the sequence of the newest record, which is the position of the next one.
+ */
+uint64_t BinaryLogger::findNextPosition() {
+    uint64_t newest = 0;
+    for (uint32_t i = 0 ; i < this->segmentCount ; i++) {
+        auto records = (BinaryLogRecord*) (this->segments[i].memory + sizeof(BinaryLogHeader));
+        for (uint32_t j = 0 ; j < this->recordCapacity ; j++)
+            newest = records[j].sequence > newest ? records[j].sequence : newest;
+    }
+    return newest;
+}
+
+/**
+ * A member function that returns the id of an endpoint, adding it to the endpoint table when it is new.
+ * Endpoints that are known are found without locking anything, by comparing hashes first.
+ * @param endpointName the name of the endpoint.
+ * @return returns the id of the endpoint, or 0 if the endpoint table is full.
+ */
+uint16_t BinaryLogger::getEndpointId(const string& endpointName) {
+    size_t hash = std::hash<string>()(endpointName);
+    uint32_t count = this->endpointCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0 ; i < count ; i++) {
+        if (this->endpointHashes[i] == hash && this->endpointNames[i] == endpointName)
+            return (uint16_t) (i + 1);
+    }
+    return this->addEndpoint(endpointName, hash);
+}
+
+/**
+ * A member function that adds an endpoint to the endpoint table of this logger and of every segment.
+ * @param endpointName the name of the endpoint.
+ * @param hash the hash of the name.
+ * @return returns the id of the endpoint, or 0 if the endpoint table is full.
+ */
+uint16_t BinaryLogger::addEndpoint(const string& endpointName, size_t hash) {
+    lock_guard<mutex> lock(this->m);
+    uint32_t count = this->endpointCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0 ; i < count ; i++) { // another thread may have added it while this one waited
+        if (this->endpointHashes[i] == hash && this->endpointNames[i] == endpointName)
+            return (uint16_t) (i + 1);
+    }
+    if (count >= BINARY_LOG_MAX_ENDPOINTS)
+        return 0;
+
+    this->endpointNames[count] = endpointName;
+    this->endpointHashes[count] = hash;
+    size_t length = endpointName.size() < BINARY_LOG_ENDPOINT_NAME_SIZE - 1 ? endpointName.size() :
+                    BINARY_LOG_ENDPOINT_NAME_SIZE - 1;
+    for (uint32_t i = 0 ; i < this->segmentCount ; i++) {
+        BinaryLogHeader* header = this->headerAt(i);
+        memset(header->endpoints[count], 0, BINARY_LOG_ENDPOINT_NAME_SIZE);
+        memcpy(header->endpoints[count], endpointName.data(), length);
+        header->endpointCount = count + 1;
+    }
+    this->endpointCount.store(count + 1, std::memory_order_release); // publish after the name was written
+    return (uint16_t) (count + 1);
+}
+
+/**
+ * A member function that returns the header of a segment.
+ * @param segmentIndex the index of the segment.
+ * @return returns the pointer to the header in the mapping.
+ */
+BinaryLogHeader* BinaryLogger::headerAt(uint32_t segmentIndex) {
+    return (BinaryLogHeader*) this->segments[segmentIndex].memory;
+}
+
+/**
+ * A member function that returns the slot of a position in the whole log.
+ * @param position the position of the record, which is its sequence - 1.
+ * @return returns the pointer to the record in the mapping.
+ */
+BinaryLogRecord* BinaryLogger::recordAt(uint64_t position) {
+    uint32_t segmentIndex = (uint32_t) ((position / this->recordCapacity) % this->segmentCount);
+    auto records = (BinaryLogRecord*) (this->segments[segmentIndex].memory + sizeof(BinaryLogHeader));
+    return &records[position % this->recordCapacity];
+}
+
+/**
+ * A member function that logs an entry that only has strings.
+ * Only the endpoint is kept, since records have no room for parameters or results. The status code is unknown, so it
+ * is recorded as 0. Handlers log through logRequest, which keeps the status.
+ * @param endpointName A string object that represents the endpoint
+ * @param parameters A string object that represents the message to save in the log. Not kept.
+ * @param result A string object that represents the result of the log. Not kept.
+ */
+void BinaryLogger::log(const string& endpointName, const string& parameters, const string& result) {
+    (void) parameters;
+    (void) result;
+    LogEntry entry;
+    entry.endpoint = endpointName;
+    this->logRequest(entry);
+}
+
+/**
+ * A member function that logs a handled request as a single record.
+ * This can be called from any number of threads at once. It never blocks unless the endpoint is logged for the first
+ * time, and never waits for the disk.
+ * @param entry the LogEntry to log.
+ */
+void BinaryLogger::logRequest(const LogEntry& entry) {
+    uint16_t endpointId = this->getEndpointId(entry.endpoint);
+    uint64_t position = this->nextPosition.fetch_add(1, std::memory_order_relaxed);
+    BinaryLogRecord* record = this->recordAt(position);
+    auto timestamp = entry.timeUs != 0 ? (int64_t) entry.timeUs :
+                     (int64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count();
+
+    record->sequence = 0; // the slot is half written until the sequence is back
+    std::atomic_thread_fence(std::memory_order_release);
+    record->timestampUs = (uint64_t) timestamp;
+    record->latencyUs = entry.latencyUs > UINT32_MAX ? UINT32_MAX : (uint32_t) entry.latencyUs;
+    record->spanMs = entry.spanUs / 1000 > UINT32_MAX ? UINT32_MAX : (uint32_t) (entry.spanUs / 1000);
+    record->count = entry.count;
+    record->endpointId = endpointId;
+    record->statusCode = (uint16_t) entry.statusCode;
+    record->target = (int8_t) (entry.target >= 0 && entry.target <= INT8_MAX ? entry.target : -1);
+    record->hasColor = entry.r >= 0 && entry.r <= 255 && entry.g >= 0 && entry.g <= 255 && entry.b >= 0 && entry.b <= 255;
+    record->r = (uint8_t) (record->hasColor ? entry.r : 0);
+    record->g = (uint8_t) (record->hasColor ? entry.g : 0);
+    record->b = (uint8_t) (record->hasColor ? entry.b : 0);
+    std::atomic_thread_fence(std::memory_order_release);
+    record->sequence = position + 1;
+}
+
+/**
+ * A member function for class BinaryLogger that returns counters of the logger.
+ * @return returns how many records were logged since start, how many records were overwritten by newer ones in the
+ * whole life of the segments, and how many endpoints have an id.
+ */
+map<string, uint64_t> BinaryLogger::getStatistics() {
+    map<string, uint64_t> statistics;
+    uint64_t position = this->nextPosition.load();
+    uint64_t capacity = (uint64_t) this->segmentCount * this->recordCapacity;
+    statistics["logged"] = position - this->startPosition;
+    statistics["overwritten"] = position > capacity ? position - capacity : 0;
+    statistics["endpoints"] = this->endpointCount.load();
+    return statistics;
+}
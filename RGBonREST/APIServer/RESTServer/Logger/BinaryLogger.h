@@ -0,0 +1,105 @@
+//
+// @file : BinaryLogger.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class BinaryLogger
+//
+
+#ifndef RGBONREST_BINARYLOGGER_H
+#define RGBONREST_BINARYLOGGER_H
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+
+#include "AbstractLogger.h"
+#include "BinaryLogFormat.h"
+
+using std::string;
+using std::vector;
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::exception;
+using std::cout;
+using std::endl;
+
+
+/**
+ * A struct that stores a segment file that is mapped into memory.
+ */
+typedef struct binaryLogSegment {
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fd;
+#endif
+    char* memory;
+    size_t size;
+} BinaryLogSegment;
+
+
+/**
+ * A class that is for logging fixed size binary records into memory mapped segment files.
+ * The segments make up a single ring: when the last segment is full, the first one is overwritten. Logging a request
+ * only claims a slot with a single atomic add and writes 40 bytes into the mapping, and the operating system writes
+ * the pages to disk on its own. Strings are not kept, only an endpoint id, the DeviceType, the color, the status and
+ * the latency. Use BinaryLogReader to turn segments into CSV or a sqlite3 database.
+ */
+class BinaryLogger : public AbstractLogger {
+private:
+    string baseName;
+    uint32_t segmentCount;
+    uint32_t recordCapacity;
+    vector<BinaryLogSegment> segments;
+    atomic<uint64_t> nextPosition{0}; // position of the next record in the whole log, which is its sequence - 1
+    uint64_t startPosition;
+
+    string endpointNames[BINARY_LOG_MAX_ENDPOINTS]; // endpointNames[id - 1], only written before endpointCount grows
+    size_t endpointHashes[BINARY_LOG_MAX_ENDPOINTS];
+    atomic<uint32_t> endpointCount{0};
+    mutex m; // only for adding endpoints
+
+    void openSegments();
+    bool openSegment(uint32_t, BinaryLogSegment&);
+    void closeSegments();
+    bool isValidSegment(uint32_t);
+    void resetSegment(uint32_t);
+    void loadEndpoints();
+    uint64_t findNextPosition();
+    uint16_t getEndpointId(const string&);
+    uint16_t addEndpoint(const string&, size_t);
+    BinaryLogHeader* headerAt(uint32_t);
+    BinaryLogRecord* recordAt(uint64_t);
+public:
+    BinaryLogger(const string&, uint32_t, uint32_t);
+    ~BinaryLogger();
+
+    void log(const string&, const string&, const string&) override;
+    void logRequest(const LogEntry&) override;
+    map<string, uint64_t> getStatistics() override;
+    /**
+     * A class that is for exception when a segment file could not be opened or mapped.
+     */
+    class segmentOpenFailedError : public exception {
+    };
+};
+
+
+#endif //RGBONREST_BINARYLOGGER_H
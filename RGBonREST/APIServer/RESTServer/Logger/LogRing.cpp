@@ -0,0 +1,103 @@
+//
+// @file : LogRing.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class LogRing
+//
+
+#include "LogRing.h"
+
+#include <cstring>
+
+
+/**
+ * A constructor member function for class LogRing.
+ * The capacity is rounded up to a power of two so that a position can find its slot with a mask.
+ * @param capacity the minimum number of records that the ring can hold.
+ */
+LogRing::LogRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    this->cells = new LogRingCell[size];
+    this->mask = size - 1;
+    for (size_t i = 0 ; i < size ; i++)
+        this->cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * A destructor member function for class LogRing.
+ * Records that were not popped are lost.
+ */
+LogRing::~LogRing() {
+    delete[] this->cells;
+}
+
+/**
+ * A static member function for class LogRing that copies a string into a fixed size buffer.
+ * The string is cut when it does not fit, and the buffer is always null terminated.
+ * @param destination the buffer to copy into.
+ * @param size the size of the buffer.
+ * @param source the string to copy.
+ */
+void LogRing::copyString(char* destination, size_t size, const string& source) {
+    size_t length = source.size() < size - 1 ? source.size() : size - 1;
+    memcpy(destination, source.data(), length);
+    destination[length] = '\0';
+}
+
+/**
+ * A member function for class LogRing that pushes a record.
+ * This can be called from any number of threads at once, and never blocks.
+ * @param entry the LogEntry to push. Only its strings, count and spanUs are kept.
+ * @param time when the entry was logged, in seconds since epoch.
+ * @return returns true if the record was pushed, false if the ring was full.
+ */
+bool LogRing::push(const LogEntry& entry, int64_t time) {
+    LogRingCell* cell;
+    size_t position = this->enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &this->cells[position & this->mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+        if (difference == 0) { // the slot is free, try to claim it
+            if (this->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        } else if (difference < 0) { // the consumer did not read this slot yet, so the ring is full
+            return false;
+        } else { // another producer claimed this position first
+            position = this->enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record.time = time;
+    cell->record.count = entry.count;
+    cell->record.spanMs = (uint32_t) (entry.spanUs / 1000);
+    LogRing::copyString(cell->record.endpoint, LOG_RECORD_ENDPOINT_SIZE, entry.endpoint);
+    LogRing::copyString(cell->record.parameters, LOG_RECORD_PARAMETERS_SIZE, entry.parameters);
+    LogRing::copyString(cell->record.result, LOG_RECORD_RESULT_SIZE, entry.result);
+    cell->sequence.store(position + 1, std::memory_order_release); // hand the slot to the consumer
+    return true;
+}
+
+/**
+ * A member function for class LogRing that pops the oldest record.
+ * This must only be called from a single thread.
+ * @param record the LogRecord to copy the popped record into.
+ * @return returns true if a record was popped, false if there was no record that is ready.
+ */
+bool LogRing::pop(LogRecord& record) {
+    size_t position = this->dequeuePosition.load(std::memory_order_relaxed);
+    LogRingCell* cell = &this->cells[position & this->mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+    if ((intptr_t) sequence - (intptr_t) (position + 1) < 0) // empty, or the producer is still filling it
+        return false;
+
+    record = cell->record;
+    this->dequeuePosition.store(position + 1, std::memory_order_relaxed);
+    cell->sequence.store(position + this->mask + 1, std::memory_order_release); // hand the slot back to producers
+    return true;
+}
@@ -0,0 +1,73 @@
+//
+// @file : LogRing.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class LogRing
+//
+
+#ifndef RGBONREST_LOGRING_H
+#define RGBONREST_LOGRING_H
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "AbstractLogger.h"
+
+using std::string;
+using std::atomic;
+
+#define LOG_RECORD_ENDPOINT_SIZE 64 // Longest endpoint name kept in a log record, including the terminating null
+#define LOG_RECORD_PARAMETERS_SIZE 256 // Longest parameters kept in a log record, including the terminating null
+#define LOG_RECORD_RESULT_SIZE 128 // Longest result kept in a log record, including the terminating null
+
+
+/**
+ * A struct that stores a single log entry with a fixed size, so that pushing it never allocates.
+ * Strings that do not fit are cut. time is when the entry was logged, in seconds since epoch. count and spanMs are
+ * how many identical requests the entry stands for and how far apart the first and the last were.
+ */
+typedef struct logRecord {
+    int64_t time;
+    uint32_t count;
+    uint32_t spanMs;
+    char endpoint[LOG_RECORD_ENDPOINT_SIZE];
+    char parameters[LOG_RECORD_PARAMETERS_SIZE];
+    char result[LOG_RECORD_RESULT_SIZE];
+} LogRecord;
+
+/**
+ * A struct that is a slot of LogRing.
+ * sequence tells whose turn the slot is: equal to the position when a producer may fill it, position + 1 when the
+ * consumer may read it.
+ */
+typedef struct logRingCell {
+    atomic<size_t> sequence;
+    LogRecord record;
+} LogRingCell;
+
+
+/**
+ * A class that is a bounded lock free queue of LogRecords, for many threads pushing and a single thread popping.
+ * Producers claim a slot with a single compare and swap and never wait for each other or for the consumer.
+ * When every slot is taken, push fails instead of waiting or growing, so memory stays at capacity records.
+ */
+class LogRing {
+private:
+    LogRingCell* cells;
+    size_t mask;
+    atomic<size_t> enqueuePosition{0};
+    char padding[64]; // keeps the positions on separate cache lines, so producers and the consumer do not slow each other
+    atomic<size_t> dequeuePosition{0};
+
+    static void copyString(char*, size_t, const string&);
+public:
+    explicit LogRing(size_t);
+    ~LogRing();
+    bool push(const LogEntry&, int64_t);
+    bool pop(LogRecord&);
+};
+
+
+#endif //RGBONREST_LOGRING_H
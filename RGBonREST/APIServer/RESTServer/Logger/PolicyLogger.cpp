@@ -0,0 +1,207 @@
+//
+// @file : PolicyLogger.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class PolicyLogger
+//
+
+#include "PolicyLogger.h"
+
+
+/**
+ * A constructor member function for class PolicyLogger.
+ * @param argLogger the logger to pass entries to. PolicyLogger owns it and deletes it when destroyed.
+ * @param argSampleRates endpoint -> share of entries to keep, from 0.0 to 1.0. A key that starts with * matches every
+ * endpoint that ends with the rest of the key, and the longest match wins. Exact keys win over those.
+ * @param argIsCoalescing whether runs of identical entries are written as a single entry.
+ */
+PolicyLogger::PolicyLogger(AbstractLogger* argLogger, const map<string, double>& argSampleRates, bool argIsCoalescing) {
+    this->logger = argLogger;
+    this->loggerName = argLogger->loggerName;
+    this->sampleRates = argSampleRates;
+    this->isCoalescing = argIsCoalescing;
+    this->flushThread = new thread(&PolicyLogger::flushLoop, this);
+}
+
+/**
+ * A destructor member function for class PolicyLogger.
+ * This writes every run that is still pending, then deletes the logger it passes entries to.
+ */
+PolicyLogger::~PolicyLogger() {
+    this->stopFlag = true;
+    this->cv.notify_one();
+    this->flushThread->join();
+    delete this->flushThread;
+    this->flushPending(true);
+    delete this->logger;
+}
+
+/**
+ * A member function that logs an entry that only has strings.
+ * @param endpointName A string object that represents the endpoint
+ * @param parameters A string object that represents the message to save in the log.
+ * @param result A string object that represents the result of the log
+ */
+void PolicyLogger::log(const string& endpointName, const string& parameters, const string& result) {
+    LogEntry entry;
+    entry.endpoint = endpointName;
+    entry.parameters = parameters;
+    entry.result = result;
+    this->logRequest(entry);
+}
+
+/**
+ * A member function that decides what happens to a handled request.
+ * An entry that is identical to the pending run of its endpoint joins the run. Any other entry ends the run, and is
+ * then kept or dropped by the sample rate of its endpoint. Entries with an error status are never dropped.
+ * Entries are passed to the logger after the lock is released, so a slow logger does not hold up other requests.
+ * @param entry the LogEntry to log.
+ */
+void PolicyLogger::logRequest(const LogEntry& entry) {
+    LogEntry current = entry;
+    if (current.timeUs == 0)
+        current.timeUs = PolicyLogger::getTimeUs();
+    bool isError = current.statusCode >= 400;
+    vector<LogEntry> readyEntries;
+
+    {
+        lock_guard<mutex> lock(this->m);
+        auto found = this->policies.find(current.endpoint);
+        if (found == this->policies.end()) { // first entry of this endpoint
+            EndpointPolicy policy;
+            policy.sampleRate = this->findSampleRate(current.endpoint);
+            policy.sampleCount = 0;
+            policy.hasPending = false;
+            found = this->policies.emplace(current.endpoint, policy).first;
+        }
+        EndpointPolicy& policy = found->second;
+
+        if (policy.hasPending && PolicyLogger::isSameEntry(policy.pending, current) &&
+            current.timeUs < policy.pending.timeUs + (uint64_t) LOGGER_COALESCE_MAX_MS * 1000) { // join the run
+            uint64_t endUs = current.timeUs + current.spanUs;
+            policy.pending.count += current.count;
+            if (endUs > policy.pending.timeUs + policy.pending.spanUs)
+                policy.pending.spanUs = endUs - policy.pending.timeUs;
+            policy.pending.latencyUs = current.latencyUs > policy.pending.latencyUs ? current.latencyUs :
+                                       policy.pending.latencyUs; // the slowest one of the run
+            this->coalescedCount += current.count;
+            return;
+        }
+        if (policy.hasPending) { // a different entry ends the run
+            readyEntries.push_back(policy.pending);
+            policy.hasPending = false;
+        }
+
+        uint64_t n = policy.sampleCount++;
+        bool isKept = isError || (uint64_t) ((double) (n + 1) * policy.sampleRate) > (uint64_t) ((double) n * policy.sampleRate);
+        if (!isKept) {
+            this->sampledOutCount++;
+        } else if (this->isCoalescing) {
+            policy.pending = current;
+            policy.hasPending = true;
+        } else {
+            readyEntries.push_back(current);
+        }
+    }
+
+    for (auto const& x : readyEntries)
+        this->logger->logRequest(x);
+}
+
+/**
+ * A member function for class PolicyLogger that returns counters of the logger.
+ * @return returns counters of the logger that entries are passed to, and how many entries were dropped by sample
+ * rates or joined a run instead of being written on their own.
+ */
+map<string, uint64_t> PolicyLogger::getStatistics() {
+    map<string, uint64_t> statistics = this->logger->getStatistics();
+    statistics["sampled_out"] = this->sampledOutCount.load();
+    statistics["coalesced"] = this->coalescedCount.load();
+    return statistics;
+}
+
+/**
+ * A member function that finds the sample rate of an endpoint.
+ * @param endpointName the name of the endpoint.
+ * @return returns the sample rate from 0.0 to 1.0. Endpoints that no key matches keep every entry.
+ */
+double PolicyLogger::findSampleRate(const string& endpointName) {
+    double sampleRate = 1.0;
+    auto found = this->sampleRates.find(endpointName);
+    if (found != this->sampleRates.end()) {
+        sampleRate = found->second;
+    } else {
+        size_t longestMatch = 0;
+        bool isMatched = false;
+        for (auto const& x : this->sampleRates) {
+            if (x.first.empty() || x.first[0] != '*')
+                continue;
+            string suffix = x.first.substr(1);
+            bool isSuffix = suffix.size() <= endpointName.size() &&
+                            endpointName.compare(endpointName.size() - suffix.size(), suffix.size(), suffix) == 0;
+            if (isSuffix && (!isMatched || suffix.size() > longestMatch)) {
+                sampleRate = x.second;
+                longestMatch = suffix.size();
+                isMatched = true;
+            }
+        }
+    }
+    return sampleRate < 0.0 ? 0.0 : (sampleRate > 1.0 ? 1.0 : sampleRate);
+}
+
+/**
+ * A member function that runs in the flush thread.
+ * This writes runs that are LOGGER_COALESCE_MAX_MS old every LOGGER_FLUSH_INTERVAL_MS, so that a run is written even
+ * when no other entry of its endpoint comes.
+ */
+void PolicyLogger::flushLoop() {
+    while (!this->stopFlag) {
+        {
+            unique_lock<mutex> lock(this->m);
+            this->cv.wait_for(lock, std::chrono::milliseconds(LOGGER_FLUSH_INTERVAL_MS),
+                              [this] { return this->stopFlag.load(); });
+        }
+        this->flushPending(false);
+    }
+}
+
+/**
+ * A member function that passes pending runs to the logger.
+ * @param isAll true to write every run, false to only write runs that are LOGGER_COALESCE_MAX_MS old.
+ */
+void PolicyLogger::flushPending(bool isAll) {
+    vector<LogEntry> readyEntries;
+    uint64_t now = PolicyLogger::getTimeUs();
+    {
+        lock_guard<mutex> lock(this->m);
+        for (auto& x : this->policies) {
+            EndpointPolicy& policy = x.second;
+            if (policy.hasPending && (isAll || now >= policy.pending.timeUs + (uint64_t) LOGGER_COALESCE_MAX_MS * 1000)) {
+                readyEntries.push_back(policy.pending);
+                policy.hasPending = false;
+            }
+        }
+    }
+
+    for (auto const& x : readyEntries)
+        this->logger->logRequest(x);
+}
+
+/**
+ * A static member function that returns the current time.
+ * @return returns microseconds since epoch.
+ */
+uint64_t PolicyLogger::getTimeUs() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * A static member function that checks if two entries are the same request with the same outcome.
+ * @param a the first LogEntry.
+ * @param b the second LogEntry.
+ * @return returns true if endpoint, parameters, result and status are all the same, false if not.
+ */
+bool PolicyLogger::isSameEntry(const LogEntry& a, const LogEntry& b) {
+    return a.statusCode == b.statusCode && a.endpoint == b.endpoint && a.parameters == b.parameters &&
+           a.result == b.result;
+}
@@ -0,0 +1,84 @@
+//
+// @file : PolicyLogger.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class PolicyLogger
+//
+
+#ifndef RGBONREST_POLICYLOGGER_H
+#define RGBONREST_POLICYLOGGER_H
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+#include "AbstractLogger.h"
+#include "../../Utils/Defines.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::unordered_map;
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::condition_variable;
+using std::thread;
+
+
+/**
+ * A struct that stores the logging state of a single endpoint.
+ * sampleRate is the share of entries that are kept, and sampleCount how many entries were seen so far, so that
+ * exactly one of every 1 / sampleRate entries is kept. pending is the run of identical entries that is not written yet.
+ */
+typedef struct endpointPolicy {
+    double sampleRate;
+    uint64_t sampleCount;
+    bool hasPending;
+    LogEntry pending;
+} EndpointPolicy;
+
+
+/**
+ * A class that is a logger which decides what reaches another logger.
+ * Every endpoint keeps a share of its entries by its sample rate, and errors are always kept. When coalescing, a run
+ * of identical entries of an endpoint is written as a single entry with a count and a time span, once a different
+ * entry comes or the run is LOGGER_COALESCE_MAX_MS old.
+ */
+class PolicyLogger : public AbstractLogger {
+private:
+    AbstractLogger* logger;
+    map<string, double> sampleRates;
+    bool isCoalescing;
+    unordered_map<string, EndpointPolicy> policies;
+    mutex m;
+    condition_variable cv;
+    thread* flushThread;
+    atomic<bool> stopFlag{false};
+
+    atomic<uint64_t> sampledOutCount{0};
+    atomic<uint64_t> coalescedCount{0};
+
+    double findSampleRate(const string&);
+    void flushLoop();
+    void flushPending(bool);
+    static uint64_t getTimeUs();
+    static bool isSameEntry(const LogEntry&, const LogEntry&);
+public:
+    PolicyLogger(AbstractLogger*, const map<string, double>&, bool);
+    ~PolicyLogger();
+
+    void log(const string&, const string&, const string&) override;
+    void logRequest(const LogEntry&) override;
+    map<string, uint64_t> getStatistics() override;
+};
+
+
+#endif //RGBONREST_POLICYLOGGER_H
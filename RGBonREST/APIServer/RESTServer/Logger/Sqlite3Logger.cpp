@@ -9,21 +9,39 @@
 
 /**
  * A constructor member function for class Sqlite3Logger
+ * This opens the database, prepares statements and then starts the writer thread.
  * @param argFileName the file name to save db file as.
+ * @param argSynchronous the synchronous level of sqlite3: OFF, NORMAL, FULL or EXTRA. Anything else means NORMAL.
  */
-Sqlite3Logger::Sqlite3Logger(const string& argFileName) {
+Sqlite3Logger::Sqlite3Logger(const string& argFileName, const string& argSynchronous) : ring(LOGGER_RING_SIZE) {
     this->loggerName = "Sqlite3";
     this->fileName = argFileName;
+    this->synchronous = argSynchronous;
+    transform(this->synchronous.begin(), this->synchronous.end(), this->synchronous.begin(), ::toupper);
+    if (!Sqlite3Logger::isValidSynchronous(this->synchronous)) {
+        cout << "[-] Unknown synchronous level " << argSynchronous << ". Using NORMAL." << endl;
+        this->synchronous = "NORMAL";
+    }
     this->db = nullptr;
+    this->insertStatement = nullptr;
+    this->beginStatement = nullptr;
+    this->commitStatement = nullptr;
+    this->rollbackStatement = nullptr;
     this->connect();
     this->initDB();
+    this->prepareStatements();
+    this->writerThread = new thread(&Sqlite3Logger::writerLoop, this);
 }
 
 /**
  * A destructor member function for class Sqlite3Logger.
- * This will disconnect from sqlite3 database file.
+ * This stops the writer thread after it wrote every entry that was logged, then disconnects from sqlite3 database file.
  */
 Sqlite3Logger::~Sqlite3Logger() {
+    this->stopFlag = true;
+    this->cv.notify_one();
+    this->writerThread->join();
+    delete this->writerThread;
     this->disconnect();
     cout << "[+] Database was disconnected" << endl;
 }
@@ -45,11 +63,85 @@ void Sqlite3Logger::connect() {
 
 /**
  * A member function that initializes sqlite3 db.
- * This will generate table 'log' if it does not exit.
+ * This switches the database to WAL, so that a commit appends to the log instead of rewriting pages, sets the
+ * synchronous level and will generate table 'log' if it does not exit.
+ * Tables from older versions get columns count and span_ms, so that they can keep being used.
  * @throws Sqlite3Logger::queryFailedError when it could not process query.
  */
 void Sqlite3Logger::initDB() {
-    this->executeQuery("CREATE TABLE IF NOT EXISTS logs (time DATETIME, endpoint VARCHAR(255), parameters VARCHAR(255), result VARCHAR(255));");
+    this->executeQuery("PRAGMA journal_mode=WAL;");
+    this->executeQuery("PRAGMA synchronous=" + this->synchronous + ";");
+    this->executeQuery("CREATE TABLE IF NOT EXISTS logs (time DATETIME, endpoint VARCHAR(255), parameters VARCHAR(255), result VARCHAR(255), count INTEGER DEFAULT 1, span_ms INTEGER DEFAULT 0);");
+    if (!this->hasColumn("logs", "count"))
+        this->executeQuery("ALTER TABLE logs ADD COLUMN count INTEGER DEFAULT 1;");
+    if (!this->hasColumn("logs", "span_ms"))
+        this->executeQuery("ALTER TABLE logs ADD COLUMN span_ms INTEGER DEFAULT 0;");
+}
+
+/**
+ * A member function that checks if a table has a column.
+ * @param table the name of the table.
+ * @param column the name of the column.
+ * @return returns true if the table has the column, false if not.
+ * @throws Sqlite3Logger::queryFailedError when sqlite3 could not read the columns of the table.
+ */
+bool Sqlite3Logger::hasColumn(const string& table, const string& column) {
+    sqlite3_stmt* statement = this->prepareStatement("PRAGMA table_info(" + table + ");");
+    bool isFound = false;
+    while (!isFound && sqlite3_step(statement) == SQLITE_ROW) {
+        auto name = (const char*) sqlite3_column_text(statement, 1); // cid, name, type, ...
+        isFound = name != nullptr && column == name;
+    }
+    sqlite3_finalize(statement);
+    return isFound;
+}
+
+/**
+ * A member function that prepares every statement that the writer thread runs, so that none is parsed again.
+ * Values are bound instead of being put into the query, so quotes in parameters can not break the query.
+ * @throws Sqlite3Logger::queryFailedError when sqlite3 could not compile a statement.
+ */
+void Sqlite3Logger::prepareStatements() {
+    this->insertStatement = this->prepareStatement(
+            "INSERT INTO logs (time, endpoint, parameters, result, count, span_ms) "
+            "VALUES(DATETIME(?1, 'unixepoch', 'localtime'), ?2, ?3, ?4, ?5, ?6);");
+    this->beginStatement = this->prepareStatement("BEGIN;");
+    this->commitStatement = this->prepareStatement("COMMIT;");
+    this->rollbackStatement = this->prepareStatement("ROLLBACK;");
+}
+
+/**
+ * A member function that compiles a single statement.
+ * @param query A string object that represents the statement to compile.
+ * @return returns the compiled statement.
+ * @throws Sqlite3Logger::queryFailedError when sqlite3 could not compile the statement.
+ */
+sqlite3_stmt* Sqlite3Logger::prepareStatement(const string& query) {
+    sqlite3_stmt* statement = nullptr;
+    if (sqlite3_prepare_v2(this->db, query.c_str(), -1, &statement, nullptr) != SQLITE_OK)
+        throw Sqlite3Logger::queryFailedError();
+    return statement;
+}
+
+/**
+ * A member function that runs a prepared statement which returns no rows, and resets it for the next run.
+ * @param statement the statement to run.
+ * @return returns true if the statement succeeded, false if not.
+ */
+bool Sqlite3Logger::runStatement(sqlite3_stmt* statement) {
+    bool isSuccess = sqlite3_step(statement) == SQLITE_DONE;
+    sqlite3_reset(statement);
+    return isSuccess;
+}
+
+/**
+ * A static member function that checks if a synchronous level is one that sqlite3 knows.
+ * This is checked before the level is put into the PRAGMA, since sqlite3 silently ignores levels it does not know.
+ * @param level the synchronous level in upper case.
+ * @return returns true if the level is OFF, NORMAL, FULL or EXTRA, false if not.
+ */
+bool Sqlite3Logger::isValidSynchronous(const string& level) {
+    return level == "OFF" || level == "NORMAL" || level == "FULL" || level == "EXTRA";
 }
 
 /**
@@ -59,29 +151,100 @@ void Sqlite3Logger::initDB() {
  * @param result A string object that represents the result of the log
  */
 void Sqlite3Logger::log(const string& endpointName, const string& parameters, const string& result) {
-    // Generate query statements.
-    string query = "INSERT INTO logs VALUES(DATETIME('now', 'localtime'), \"";
-    query += endpointName;
-    query += "\", \"";
-    query += parameters;
-    query += "\", \"";
-    query += result + "\");";
-
-    this->executeQuery(query); // execute the query
+    LogEntry entry;
+    entry.endpoint = endpointName;
+    entry.parameters = parameters;
+    entry.result = result;
+    this->logRequest(entry);
+}
+
+/**
+ * A member function that logs a handled request into sqlite3 db.
+ * This only copies the entry into the ring, the writer thread writes it later. Time is taken here unless the entry
+ * has one, so the entry keeps the time it was logged at no matter when it is written.
+ * @param entry the LogEntry to log.
+ */
+void Sqlite3Logger::logRequest(const LogEntry& entry) {
+    auto logTime = entry.timeUs != 0 ? (int64_t) (entry.timeUs / 1000000) : (int64_t) time(nullptr);
+    if (!this->ring.push(entry, logTime))
+        this->droppedCount++; // the writer is behind, drop instead of making the request wait
+}
+
+/**
+ * A member function for class Sqlite3Logger that returns counters of the logger.
+ * @return returns how many entries were written, dropped because the ring was full, or failed to be written.
+ */
+map<string, uint64_t> Sqlite3Logger::getStatistics() {
+    map<string, uint64_t> statistics;
+    statistics["logged"] = this->loggedCount.load();
+    statistics["dropped"] = this->droppedCount.load();
+    statistics["failed"] = this->failedCount.load();
+    return statistics;
+}
+
+/**
+ * A member function that runs in the writer thread.
+ * This writes entries every LOGGER_FLUSH_INTERVAL_MS, and keeps writing without waiting while batches come out full.
+ * When stopped, it writes every entry that is left before returning.
+ */
+void Sqlite3Logger::writerLoop() {
+    while (!this->stopFlag) {
+        {
+            unique_lock<mutex> lock(this->m);
+            this->cv.wait_for(lock, std::chrono::milliseconds(LOGGER_FLUSH_INTERVAL_MS),
+                              [this] { return this->stopFlag.load(); });
+        }
+        while (this->writeBatch()); // write until a batch comes out short
+    }
+    while (this->writeBatch());
+}
+
+/**
+ * A member function that writes up to LOGGER_BATCH_SIZE entries from the ring in a single transaction.
+ * This must only be called from the writer thread.
+ * @return returns true if the batch was full, so that there may be more entries waiting.
+ */
+bool Sqlite3Logger::writeBatch() {
+    LogRecord record;
+    if (!this->ring.pop(record)) // nothing to write, do not open an empty transaction
+        return false;
+
+    bool isInTransaction = this->runStatement(this->beginStatement);
+    int count = 0;
+    uint64_t written = 0;
+    do {
+        sqlite3_bind_int64(this->insertStatement, 1, record.time);
+        sqlite3_bind_text(this->insertStatement, 2, record.endpoint, -1, SQLITE_STATIC);
+        sqlite3_bind_text(this->insertStatement, 3, record.parameters, -1, SQLITE_STATIC);
+        sqlite3_bind_text(this->insertStatement, 4, record.result, -1, SQLITE_STATIC);
+        sqlite3_bind_int64(this->insertStatement, 5, record.count);
+        sqlite3_bind_int64(this->insertStatement, 6, record.spanMs);
+        if (this->runStatement(this->insertStatement))
+            written++;
+        else
+            this->failedCount++;
+        count++;
+    } while (count < LOGGER_BATCH_SIZE && this->ring.pop(record));
+
+    if (isInTransaction && !this->runStatement(this->commitStatement)) {
+        this->runStatement(this->rollbackStatement);
+        this->failedCount += written;
+        written = 0;
+    }
+    this->loggedCount += written;
+    return count == LOGGER_BATCH_SIZE;
 }
 
 /**
  * A member function that executes query according to the given query string.
- * Since this member function will be called from various threads,
- * it uses a mutex to protect the variable from race condition.
+ * This is only used before the writer thread starts, so it does not need to lock anything.
  * @param query A string object that represents the query expression to be executed.
  */
 void Sqlite3Logger::executeQuery(const string& query) {
-    this->m.lock(); // lock mutex
     int result;
     char* err_msg = nullptr;
     result = sqlite3_exec(db, query.c_str(), nullptr, nullptr, &err_msg);
-    this->m.unlock(); // unlock mutex
+    sqlite3_free(err_msg);
     if(result != SQLITE_OK) {
         throw Sqlite3Logger::queryFailedError(); // if sqlite3 cannot process file, throw exception.
     }
@@ -91,5 +254,9 @@ void Sqlite3Logger::executeQuery(const string& query) {
  * A member function that disconnects from the sqlite3 database file.
  */
 void Sqlite3Logger::disconnect() {
+    sqlite3_finalize(this->insertStatement);
+    sqlite3_finalize(this->beginStatement);
+    sqlite3_finalize(this->commitStatement);
+    sqlite3_finalize(this->rollbackStatement);
     sqlite3_close(this->db);
 }
\ No newline at end of file
@@ -12,9 +12,16 @@
 #include <iostream>
 #include <exception>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <ctime>
+#include <algorithm>
 
 #include <sqlite3.h>
 #include "AbstractLogger.h"
+#include "LogRing.h"
+#include "../../Utils/Defines.h"
 
 using std::string;
 using std::cout;
@@ -22,28 +29,57 @@ using std::endl;
 using std::exception;
 using std::mutex;
 using std::to_string;
+using std::condition_variable;
+using std::unique_lock;
+using std::thread;
+using std::atomic;
 
 
 /**
  * A class that is for logging into sqlite3 db.
  * This classes uses features from sqlite3.h from https://www.sqlite.org/download.html.
- * Also this function is meant to be used with threads, so it uses mutex to avoid race condition.
+ * Request threads never touch the database. log only copies the entry into a LogRing, and a single writer thread
+ * drains the ring and writes entries in batches, each batch in a single transaction with a prepared statement.
+ * When the ring is full the entry is dropped and counted instead of making the request wait.
+ * The database is opened in WAL mode, and how often sqlite3 syncs to disk is set by the synchronous level.
  */
 class Sqlite3Logger : public AbstractLogger {
 private:
     string fileName;
+    string synchronous;
     sqlite3* db;
-    mutex m;
+    sqlite3_stmt* insertStatement;
+    sqlite3_stmt* beginStatement;
+    sqlite3_stmt* commitStatement;
+    sqlite3_stmt* rollbackStatement;
+    LogRing ring;
+    thread* writerThread;
+    atomic<bool> stopFlag{false};
+    mutex m; // only for waking up the writer thread
+    condition_variable cv;
+
+    atomic<uint64_t> loggedCount{0};
+    atomic<uint64_t> droppedCount{0};
+    atomic<uint64_t> failedCount{0};
 
     void initDB();
+    bool hasColumn(const string&, const string&);
     void connect();
+    void prepareStatements();
+    sqlite3_stmt* prepareStatement(const string&);
+    bool runStatement(sqlite3_stmt*);
+    static bool isValidSynchronous(const string&);
     void executeQuery(const string&);
     void disconnect();
+    void writerLoop();
+    bool writeBatch();
 public:
-    explicit Sqlite3Logger(const string&);
+    Sqlite3Logger(const string&, const string&);
     ~Sqlite3Logger();
 
     void log(const string&, const string&, const string&) override;
+    void logRequest(const LogEntry&) override;
+    map<string, uint64_t> getStatistics() override;
     /**
      * A class that is for exception when connection had failed.
      */
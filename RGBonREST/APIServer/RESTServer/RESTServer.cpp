@@ -7,18 +7,27 @@
 #include "RESTServer.h"
 
 
+ShutdownSignal* RESTServer::activeShutdownSignal = nullptr;
+volatile sig_atomic_t RESTServer::receivedSignal = 0;
+
 /**
  * A constructor member function for class RESTServer.
- * This initializes all listeners in REST API using http_listener.open, http_listener.support.
+ * This initializes all endpoints and the http_listener that serves them using http_listener.open,
+ * http_listener.support.
  */
 RESTServer::RESTServer() {
     this->configValues = Misc::readConfig();
     string tmpAddr = "http://" + configValues.ip + ":" + std::to_string(configValues.port);
     cout << "[+] Starting server at " << tmpAddr << endl;
 
-    this->baseAddress = wstring(tmpAddr.begin(), tmpAddr.end()); // The base URL for API itself.
+    this->baseAddress = utility::conversions::to_string_t(tmpAddr); // The base URL for API itself.
 
     this->sdks = nullptr;
+    this->listener = nullptr;
+    this->udpServer = nullptr;
+    this->webSocketServer = nullptr;
+    this->effectEngine = nullptr;
+    this->framebuffer = nullptr;
     this->logger = nullptr;
 
     if (this->configValues.logEnabled) {
@@ -28,6 +37,9 @@ RESTServer::RESTServer() {
         } catch (const Sqlite3Logger::connectionFailedError &ex) { // if Sqlite3 failed to open db file
             cout << "[+] Cannot open database. Logging disabled." << endl; // disable logging.
             this->logger = nullptr;
+        } catch (const BinaryLogger::segmentOpenFailedError &ex) { // if a segment file could not be mapped
+            cout << "[+] Cannot open log segments. Logging disabled." << endl;
+            this->logger = nullptr;
         }
     } else {
         cout << "[+] Logging Disabled";
@@ -35,9 +47,16 @@ RESTServer::RESTServer() {
     }
 
     this->generateSDKInstances(); // Generate all SDK instances
+    this->generateStreamServers(); // Start servers that take colors without HTTP
+    this->generateEffectEngine(); // Start rendering effects inside the server
 
-    this->initListeners(); // Init all http_listener instances.
-    this->activateListeners(); // Activate and call .open and .support for all http_listeners.
+    this->shutdownSignal = new ShutdownSignal();
+    RESTServer::activeShutdownSignal = this->shutdownSignal;
+    std::signal(SIGINT, RESTServer::signalHandler); // Stop gracefully on Ctrl+C
+    std::signal(SIGTERM, RESTServer::signalHandler); // Stop gracefully when terminated
+
+    this->initEndPoints(); // Init all endpoints.
+    this->activateListener(); // Build the route table, then call .open and .support for the http_listener.
 
     this->serverThread = new thread(&RESTServer::startServer, this); // start server thread
     this->serverThread->join(); // join thread
@@ -45,149 +64,350 @@ RESTServer::RESTServer() {
 
 /**
  * A destructor member function that destroys class RESTServer.
- * This closes all instances and deletes instances that were generated by activateListeners().
+ * This waits for in-flight handlers to finish, then closes the http_listener and deletes instances that were generated
+ * by initEndPoints() and activateListener().
  * Then it will exit(0).
  */
 RESTServer::~RESTServer() {
     this->exitFlag = true;
-    for (auto const& x : this->endpoints) {
-        x->listener->close(); // close listener
-        delete(x->listener); // delete http_listener instance
+    std::signal(SIGINT, SIG_DFL); // a second Ctrl+C while draining stops right away
+    std::signal(SIGTERM, SIG_DFL);
+    RESTServer::activeShutdownSignal = nullptr;
+    this->drainRequests(); // let handlers that are still running reply before the listener goes away
+    this->listener->close().wait(); // close listener
+    delete(this->listener); // delete http_listener instance
+    delete(this->udpServer); // stops receiving frames
+    delete(this->webSocketServer); // closes every stream client
+    delete(this->effectEngine); // stops rendering effects
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++)
+        delete(this->sdks->at(i)->executor); // runs commands that are still queued, then stops
+    delete(this->framebuffer); // after executors, since queued flushes read from it
+    for (auto const& x : *this->sdks)
+        delete(x); // plugins are unloaded here
+    delete(this->sdks);
+    for (auto const& x : this->endpoints)
         delete(x); // delete EndPoint instance
-    }
+    delete(this->logger); // writes log entries that are still waiting
+    delete(this->shutdownSignal);
     cout << "[+] Stopped server. Press any key to exit" << endl;
     system("pause");
 }
 
 /**
- * A member function for class RESTServer that activates all http_listener instances.
+ * A member function for class RESTServer that activates the http_listener instance.
  * This member function will do following processes:
- * 1. Generate a http_listener instance.
- * 2. http_listener::open and http_listener::wait http_listener.
- * 3. http_listener::support
- */
-void RESTServer::activateListeners() {
-    for (auto const&x : this->endpoints) {
-        http_listener* listener;
-        listener = new http_listener(x->uri);
-        listener->open().wait();
-        listener->support(x->method, x->handler);
-        x->listener = listener;
+ * 1. Compile all endpoints into the route table.
+ * 2. Generate a single http_listener instance on the base address.
+ * 3. http_listener::support with dispatchRequest for every method.
+ * 4. http_listener::open and http_listener::wait http_listener.
+ */
+void RESTServer::activateListener() {
+    for (auto const& x : this->endpoints)
+        this->routes[x->uri][x->method] = x; // routes are looked up by path first, then by method.
+
+    this->listener = new http_listener(this->baseAddress);
+    this->listener->support([this](const http_request &request) { this->dispatchRequest(request); });
+    this->listener->open().wait();
+}
+
+/**
+ * A member function for class RESTServer that dispatches a request to its endpoint using the route table.
+ * Looking up a route costs one hash of the request path and a lookup among the methods of that path.
+ * @param request the request that was sent by the listener itself.
+ */
+void RESTServer::dispatchRequest(const http_request& request) {
+    utility::string_t path = request.relative_uri().path();
+    if (path.size() > 1 && path.back() == U('/')) // treat /corsair/set_rgb/ the same as /corsair/set_rgb
+        path.pop_back();
+
+    auto route = this->routes.find(path);
+    if (route == this->routes.end()) { // no endpoint with this path at all
+        request.reply(status_codes::NotFound);
+        return;
+    }
+
+    auto endPoint = route->second.find(request.method());
+    if (endPoint == route->second.end()) { // endpoint exists, but does not support this method
+        request.reply(status_codes::MethodNotAllowed);
+        return;
     }
+
+    this->handleRequest(endPoint->second, request);
+}
+
+/**
+ * A member function for class RESTServer that runs the handler of an endpoint.
+ * Handlers return as soon as their work is scheduled, so the listener thread is never blocked by a request.
+ * This keeps track of how many handlers are running until their tasks are done, so that the server can drain them
+ * before shutting down. Requests that arrive after shutdown was requested are refused with 503 Service Unavailable.
+ * @param endPoint the EndPoint that the request was sent to.
+ * @param request the request that was sent by the listener itself.
+ */
+void RESTServer::handleRequest(const EndPoint* endPoint, const http_request& request) {
+    if (!this->acceptingRequests) {
+        request.reply(status_codes::ServiceUnavailable, "Server is stopping.");
+        return;
+    }
+
+    this->inFlightCount++;
+    string uri = utility::conversions::to_utf8string(endPoint->uri);
+    pplx::task<void> handlerTask;
+    try {
+        handlerTask = endPoint->handler(request);
+    } catch (const std::exception &ex) { // never let a handler take the listener thread down with it
+        handlerTask = pplx::task_from_exception<void>(std::current_exception());
+    }
+
+    handlerTask.then([this, uri](const pplx::task<void>& previous) {
+        try {
+            previous.get();
+        } catch (const std::exception &ex) {
+            cout << "[-] Unhandled exception in handler for " << uri << endl;
+        }
+
+        if (--this->inFlightCount == 0) { // wake up drainRequests if it is waiting for this handler
+            lock_guard<mutex> lock(this->shutdownMutex);
+            this->shutdownCondition.notify_all();
+        }
+    });
+}
+
+/**
+ * A member function for class RESTServer that waits for in-flight handlers to finish.
+ * New requests are refused from this point on. This waits at most SHUTDOWN_DRAIN_TIMEOUT_MS milliseconds.
+ */
+void RESTServer::drainRequests() {
+    this->acceptingRequests = false;
+
+    unique_lock<mutex> lock(this->shutdownMutex);
+    bool drained = this->shutdownCondition.wait_for(lock, std::chrono::milliseconds(SHUTDOWN_DRAIN_TIMEOUT_MS),
+                                                    [this] { return this->inFlightCount == 0; });
+    if (!drained)
+        cout << "[-] " << this->inFlightCount << " handler(s) did not finish in time" << endl;
 }
 
 /**
- * A member function for class RESTServer that initializes endpoints for http_listener instances.
+ * A member function for class RESTServer that initializes endpoints for the http_listener instance.
+ * Each endpoint's uri is relative to the base address. Adding an SDK adds routes here, not listeners.
  */
-void RESTServer::initListeners() {
+void RESTServer::initEndPoints() {
     this->endpoints.push_back( // For endpoint /general/connection
                 generateEndPoint(
-                            this->baseAddress + U("/general/connection"),
+                            U("/general/connection"),
                             methods::GET,
-                            [this](const http_request &request) { RequestHandler::General::connection(request, this->logger);
+                            [this](const http_request &request) { return RequestHandler::General::connection(request, this->logger);
                             }));
 
     this->endpoints.push_back( // For endpoint /general/stop_server
                     generateEndPoint(
-                            this->baseAddress + U("/general/stop_server"),
+                            U("/general/stop_server"),
                             methods::DEL,
-                            [this](const http_request &request) { RequestHandler::General::stop_server(request, this->logger); this->exitFlag = true;
+                            [this](const http_request &request) {
+                                return RequestHandler::General::stop_server(request, this->logger).then([this] { this->requestStop(); });
+                            }));
+
+    this->endpoints.push_back( // For endpoint /general/statistics
+                    generateEndPoint(
+                            U("/general/statistics"),
+                            methods::GET,
+                            [this](const http_request &request) { return RequestHandler::General::statistics(request, this->logger, this->sdks);
+                            }));
+
+    this->endpoints.push_back( // For endpoint /effects/start
+                    generateEndPoint(
+                            U("/effects/start"),
+                            methods::POST,
+                            [this](const http_request &request) { return RequestHandler::Effects::start(request, this->logger, this->sdks, this->effectEngine);
+                            }));
+
+    this->endpoints.push_back( // For endpoint /effects/stop
+                    generateEndPoint(
+                            U("/effects/stop"),
+                            methods::POST,
+                            [this](const http_request &request) { return RequestHandler::Effects::stop(request, this->logger, this->sdks, this->effectEngine);
+                            }));
+
+    this->endpoints.push_back( // For endpoint /leds/layout
+                    generateEndPoint(
+                            U("/leds/layout"),
+                            methods::GET,
+                            [this](const http_request &request) { return RequestHandler::Leds::layout(request, this->logger, this->sdks, this->framebuffer);
+                            }));
+
+    this->endpoints.push_back( // For endpoint /leds/set
+                    generateEndPoint(
+                            U("/leds/set"),
+                            methods::POST,
+                            [this](const http_request &request) { return RequestHandler::Leds::set(request, this->logger, this->framebuffer);
                             }));
 
     // Generate SDK endpoints automatically.
-    for (int i = 0 ; i < SUPPORTED_SDK_COUNT ; i++) {
-        string sdkName = this->sdks[i]->sdkName;
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++) {
+        string sdkName = this->sdks->at(i)->sdkName;
         string lowerSDKName = sdkName;
         transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
 
         this->endpoints.push_back( // For endpoint /sdk_name/connect
                 generateEndPoint(
-                        this->baseAddress + Misc::convertWstring("/" + lowerSDKName + "/connect"),
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/connect"),
                         methods::POST,
-                        [this, i](const http_request &request) { RequestHandler::SDK::connect(request, this->logger, this->sdks[i]);
+                        [this, i](const http_request &request) { return RequestHandler::SDK::connect(request, this->logger, this->sdks->at(i));
                         }));
 
         this->endpoints.push_back( // For endpoint /sdk_name/disconnect
                 generateEndPoint(
-                        this->baseAddress + Misc::convertWstring("/" + lowerSDKName + "/disconnect"),
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/disconnect"),
                         methods::DEL,
-                        [this, i](const http_request &request) { RequestHandler::SDK::disconnect(request, this->logger, this->sdks[i]);
+                        [this, i](const http_request &request) { return RequestHandler::SDK::disconnect(request, this->logger, this->sdks->at(i));
                         }));
-        this->endpoints.push_back( // For endpoint /sdk_name/disconnect
+        this->endpoints.push_back( // For endpoint /sdk_name/get_devices
                 generateEndPoint(
-                        this->baseAddress + Misc::convertWstring("/" + lowerSDKName + "/get_devices"),
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/get_devices"),
                         methods::GET,
-                        [this, i](const http_request &request) { RequestHandler::SDK::get_device(request, this->logger, this->sdks[i]);
+                        [this, i](const http_request &request) { return RequestHandler::SDK::get_device(request, this->logger, this->sdks->at(i));
                         }));
-        this->endpoints.push_back( // For endpoint /sdk_name/disconnect
+        this->endpoints.push_back( // For endpoint /sdk_name/set_rgb
                 generateEndPoint(
-                        this->baseAddress + Misc::convertWstring("/" + lowerSDKName + "/set_rgb"),
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/set_rgb"),
                         methods::POST,
-                        [this, i](const http_request &request) { RequestHandler::SDK::set_rgb(request, this->logger, this->sdks[i]);
+                        [this, i](const http_request &request) { return RequestHandler::SDK::set_rgb(request, this->logger, this->sdks->at(i));
                         }));
+        this->endpoints.push_back( // For endpoint /sdk_name/set_rgb_batch
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/set_rgb_batch"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::SDK::set_rgb_batch(request, this->logger, this->sdks->at(i));
+                        }));
+        this->endpoints.push_back( // For endpoint /sdk_name/set_leds
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/set_leds"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::SDK::set_leds(request, this->logger, this->sdks->at(i));
+                        }));
+        this->endpoints.push_back( // For endpoint /sdk_name/animation/upload
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/animation/upload"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::Animation::upload(request, this->logger, this->sdks->at(i));
+                        }));
+        this->endpoints.push_back( // For endpoint /sdk_name/animation/play
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/animation/play"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::Animation::play(request, this->logger, this->sdks, i, this->effectEngine);
+                        }));
+        this->endpoints.push_back( // For endpoint /sdk_name/animation/stop
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/animation/stop"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::Animation::stop(request, this->logger, this->sdks, i, this->effectEngine);
+                        }));
+        this->endpoints.push_back( // For endpoint /sdk_name/animation/delete
+                generateEndPoint(
+                        utility::conversions::to_string_t("/" + lowerSDKName + "/animation/delete"),
+                        methods::POST,
+                        [this, i](const http_request &request) { return RequestHandler::Animation::remove(request, this->logger, this->sdks, i, this->effectEngine);
+                        }));
+
+        auto* virtualSDK = dynamic_cast<VirtualSDK*>(this->sdks->at(i));
+        if (virtualSDK != nullptr) {
+            this->endpoints.push_back( // For endpoint /virtual/frames
+                    generateEndPoint(
+                            utility::conversions::to_string_t("/" + lowerSDKName + "/frames"),
+                            methods::GET,
+                            [this, virtualSDK](const http_request &request) { return RequestHandler::Virtual::frames(request, this->logger, virtualSDK);
+                            }));
+        }
     }
 
     this->endpoints.push_back( // For endpoint /all/connect
             generateEndPoint(
-                    this->baseAddress + Misc::convertWstring("/all/connect"),
+                    utility::conversions::to_string_t("/all/connect"),
                     methods::POST,
-                    [this](const http_request &request) { RequestHandler::ALL::connect(request, this->logger, this->sdks);
+                    [this](const http_request &request) { return RequestHandler::ALL::connect(request, this->logger, this->sdks);
                     }));
 
     this->endpoints.push_back( // For endpoint /all/disconnect
             generateEndPoint(
-                    this->baseAddress + Misc::convertWstring("/all/disconnect"),
+                    utility::conversions::to_string_t("/all/disconnect"),
                     methods::DEL,
-                    [this](const http_request &request) { RequestHandler::ALL::disconnect(request, this->logger, this->sdks);
+                    [this](const http_request &request) { return RequestHandler::ALL::disconnect(request, this->logger, this->sdks);
                     }));
-    this->endpoints.push_back( // For endpoint /all/disconnect
+    this->endpoints.push_back( // For endpoint /all/get_devices
             generateEndPoint(
-                    this->baseAddress + Misc::convertWstring("/all/get_devices"),
+                    utility::conversions::to_string_t("/all/get_devices"),
                     methods::GET,
-                    [this](const http_request &request) { RequestHandler::ALL::get_device(request, this->logger, this->sdks);
+                    [this](const http_request &request) { return RequestHandler::ALL::get_device(request, this->logger, this->sdks);
                     }));
-    this->endpoints.push_back( // For endpoint /all/disconnect
+    this->endpoints.push_back( // For endpoint /all/set_rgb
+            generateEndPoint(
+                    utility::conversions::to_string_t("/all/set_rgb"),
+                    methods::POST,
+                    [this](const http_request &request) { return RequestHandler::ALL::set_rgb(request, this->logger, this->sdks);
+                    }));
+    this->endpoints.push_back( // For endpoint /all/set_rgb_batch
             generateEndPoint(
-                    this->baseAddress + Misc::convertWstring("/all/set_rgb"),
+                    utility::conversions::to_string_t("/all/set_rgb_batch"),
                     methods::POST,
-                    [this](const http_request &request) { RequestHandler::ALL::set_rgb(request, this->logger, this->sdks);
+                    [this](const http_request &request) { return RequestHandler::ALL::set_rgb_batch(request, this->logger, this->sdks);
                     }));
 }
 
 /**
  * A member function for class RESTServer that generates EndPoint for each endpoints
- * @param argUri : wstring object that represents the endpoint URI
+ * @param argUri : utility::string_t object that represents the endpoint URI relative to the base address
  * @param argMethod : http::method object that represents the method for this endpoint
  * @param argHandler : the function that handles request for this endpoint
  * @return returns a pointer to EndPoint object.
  */
-EndPoint* RESTServer::generateEndPoint(const wstring& argUri, const method& argMethod,
-                                       const function<void(http_request)>& argHandler){
+EndPoint* RESTServer::generateEndPoint(const utility::string_t& argUri, const method& argMethod,
+                                       const function<pplx::task<void>(http_request)>& argHandler){
     EndPoint* newEndPoint;
     newEndPoint = new EndPoint;
     newEndPoint->uri = argUri;
     newEndPoint->method = argMethod;
     newEndPoint->handler = argHandler;
-    newEndPoint->listener = nullptr;
 
     return newEndPoint;
 }
 
 /**
  * A member function that starts server.
- * This actually is just a loop that keeps server alive.
- * This member function will check exitFlag and see if it should stop running. When it hit exitFlag, it will call
- * destructor and delete current object.
+ * This keeps server alive by parking the thread on a ShutdownSignal, without any timeout, until requestStop() is
+ * called or SIGINT / SIGTERM was received. When it should stop, it will call destructor and delete current object.
  */
 void RESTServer::startServer() {
-    while (!this->exitFlag);
+    this->shutdownSignal->wait();
+    if (RESTServer::receivedSignal != 0)
+        cout << "[+] Received signal " << (int) RESTServer::receivedSignal << endl;
     cout << "[+] Stopping server..." << endl;
     delete this;
 }
 
+/**
+ * A member function that requests server to stop.
+ * This wakes up the thread that is parked in startServer().
+ */
+void RESTServer::requestStop() {
+    this->exitFlag = true;
+    this->shutdownSignal->notify();
+}
+
+/**
+ * A static member function that handles SIGINT and SIGTERM.
+ * This only records the signal and writes to the ShutdownSignal, since both are safe to do inside a signal handler.
+ * @param signalNumber the signal that was received.
+ */
+void RESTServer::signalHandler(int signalNumber) {
+    RESTServer::receivedSignal = signalNumber;
+    ShutdownSignal* shutdownSignal = RESTServer::activeShutdownSignal;
+    if (shutdownSignal != nullptr) shutdownSignal->notify();
+}
+
 /**
  * A member function that generates AbstractLogger instance.
  * This will generate AbstractLogger instance according to the json values.
+ * When log_sample_rates or log_coalesce is set, the logger is wrapped in a PolicyLogger.
  */
 void RESTServer::generateLoggerInstance() {
     string loggerName = this->configValues.loggerName;
@@ -195,17 +415,131 @@ void RESTServer::generateLoggerInstance() {
 
     if (loggerName == "sqlite3") {
         cout << "[+] Using Sqlite3 as logger with file " << fileName << endl;
-        this->logger = new Sqlite3Logger(fileName);
+        this->logger = new Sqlite3Logger(fileName, this->configValues.logSynchronous);
+    } else if (loggerName == "binary") {
+        cout << "[+] Using binary segments as logger with files " << fileName << ".*" << endl;
+        this->logger = new BinaryLogger(fileName, this->configValues.logSegmentCount,
+                                        this->configValues.logSegmentRecords);
+    }
+
+    if (this->logger != nullptr && (!this->configValues.logSampleRates.empty() || this->configValues.logCoalesce)) {
+        cout << "[+] Sampling " << this->configValues.logSampleRates.size() << " endpoint patterns"
+             << (this->configValues.logCoalesce ? " and coalescing identical entries" : "") << endl;
+        this->logger = new PolicyLogger(this->logger, this->configValues.logSampleRates, this->configValues.logCoalesce);
     }
 }
 
 /**
  * A member function that generates all SDK instances.
- * This member function will generate all SDK instances so that it can be used in the future.
+ * Built in SDKs listed in sdk_backends come first in that order, then every plugin in plugins that could be loaded
+ * from plugin_directory. Endpoints are generated later for whatever ended up in sdks.
  */
 void RESTServer::generateSDKInstances() {
-    this->sdks = (AbstractSDK**) malloc (sizeof(void*) * SUPPORTED_SDK_COUNT); // Generate array pointers to sdks.
+    this->sdks = new vector<AbstractSDK*>;
+
+    for (auto const& x : this->configValues.sdkBackends) {
+#ifdef _WIN32
+        if (x == "corsair")
+            this->sdks->push_back(new CorsairSDK(this->configValues.corsairFlushesInFlight));
+        else if (x == "razer")
+            this->sdks->push_back(new RazerSDK());
+        else
+#endif
+        if (x == "virtual")
+            this->sdks->push_back(new VirtualSDK(this->configValues.virtualDevices, this->configValues.virtualFrameHistory,
+                                                 this->configValues.virtualSeed));
+        else if (x == "openrgb")
+            this->sdks->push_back(new OpenRGBSDK(this->configValues.openRGBHost, this->configValues.openRGBPort));
+#ifdef __linux__
+        else if (x == "sysfs")
+            this->sdks->push_back(new SysfsSDK(this->configValues.sysfsLedsPath));
+#endif
+        else
+            cout << "[-] Unknown SDK backend " << x << ". Skipping it." << endl;
+    }
 
-    this->sdks[0] = new CorsairSDK(); // index 0 = Corsair
-    this->sdks[1] = new RazerSDK(); // index 1 = Razer
-}
\ No newline at end of file
+    for (auto const& x : this->configValues.plugins)
+        this->loadPlugin(x);
+
+    for (int i = 0 ; i < (int) this->sdks->size() ; i++)
+        this->sdks->at(i)->executor = new SDKExecutor(SDK_EXECUTOR_QUEUE_SIZE); // one command thread for each SDK
+
+    this->framebuffer = new Framebuffer(this->sdks); // every LED of every SDK
+}
+
+/**
+ * A member function that loads a single plugin from plugin_directory and appends it to sdks.
+ * A plugin that could not be loaded, or whose name is already taken by another SDK or an endpoint group, is skipped.
+ * @param pluginName the file name of the plugin. The platform suffix is appended when there is no extension.
+ */
+void RESTServer::loadPlugin(const string& pluginName) {
+    string pluginPath = this->configValues.pluginDirectory + "/" + pluginName;
+    if (pluginName.find('.') == string::npos) pluginPath += RGBONREST_PLUGIN_SUFFIX;
+
+    PluginSDK* plugin;
+    try {
+        plugin = new PluginSDK(pluginPath);
+    } catch (const PluginSDK::pluginLoadFailed &ex) {
+        cout << "[-] Cannot load plugin " << pluginPath << ". Skipping it." << endl;
+        return;
+    }
+
+    string lowerPluginName = plugin->sdkName;
+    transform(lowerPluginName.begin(), lowerPluginName.end(), lowerPluginName.begin(), ::tolower);
+    bool isTaken = lowerPluginName.empty() || lowerPluginName == "all" || lowerPluginName == "general" ||
+            lowerPluginName == "effects" || lowerPluginName == "leds" || lowerPluginName == "logger";
+    for (auto const& x : *this->sdks) {
+        string lowerSDKName = x->sdkName;
+        transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+        isTaken = isTaken || lowerSDKName == lowerPluginName;
+    }
+
+    if (isTaken) { // endpoints of this plugin would collide with existing ones
+        cout << "[-] Plugin " << pluginPath << " uses name " << plugin->sdkName << " which is taken. Skipping it." << endl;
+        delete plugin;
+        return;
+    }
+
+    cout << "[+] Loaded plugin " << plugin->sdkName << " from " << pluginPath << endl;
+    this->sdks->push_back(plugin);
+}
+
+/**
+ * A member function that generates servers that stream colors without HTTP.
+ * If a stream server could not be started, the REST API keeps running without it.
+ */
+void RESTServer::generateStreamServers() {
+    if (this->configValues.udpEnabled) {
+        this->udpServer = new UDPServer(this->configValues.ip, this->configValues.udpPort, this->sdks);
+        try {
+            this->udpServer->start();
+            cout << "[+] Receiving UDP color frames at " << this->configValues.ip << ":" << this->configValues.udpPort << endl;
+        } catch (const UDPServer::socketFailedError &ex) {
+            cout << "[-] Cannot open UDP port " << this->configValues.udpPort << ". UDP frames disabled." << endl;
+            delete this->udpServer;
+            this->udpServer = nullptr;
+        }
+    }
+
+    if (this->configValues.streamEnabled) {
+        this->webSocketServer = new WebSocketServer(this->configValues.ip, this->configValues.streamPort, this->sdks);
+        try {
+            this->webSocketServer->start();
+            cout << "[+] Streaming colors at ws://" << this->configValues.ip << ":" << this->configValues.streamPort << "/stream" << endl;
+        } catch (const WebSocketServer::socketFailedError &ex) {
+            cout << "[-] Cannot open port " << this->configValues.streamPort << ". WebSocket streaming disabled." << endl;
+            delete this->webSocketServer;
+            this->webSocketServer = nullptr;
+        }
+    }
+}
+
+/**
+ * A member function that generates the effect engine and starts its render thread.
+ * The render thread sleeps until an effect is started using /effects/start.
+ */
+void RESTServer::generateEffectEngine() {
+    this->effectEngine = new EffectEngine(this->sdks, this->configValues.effectFps);
+    this->effectEngine->start();
+    cout << "[+] Rendering effects at " << this->configValues.effectFps << " FPS" << endl;
+}
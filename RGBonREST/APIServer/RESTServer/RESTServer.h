@@ -9,20 +9,37 @@
 #pragma once
 
 #include <cpprest/http_listener.h>
+#include "../StreamServer/UDPServer.h"
+#include "../StreamServer/WebSocketServer.h"
+#include "../EffectEngine/EffectEngine.h"
+#include "../Framebuffer/Framebuffer.h"
 #include <map>
 #include <thread>
 #include <atomic>
 #include <list>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <csignal>
 
 #include "./RequestHandler.h"
 #include "./Logger/Sqlite3Logger.h"
+#include "./Logger/BinaryLogger.h"
+#include "./Logger/PolicyLogger.h"
 #include "../Utils/Misc.h"
+#include "../Utils/ShutdownSignal.h"
+#ifdef _WIN32
 #include "../SDKEngine/CorsairSDK/CorsairSDK.h"
 #include "../SDKEngine/RazerSDK/RazerSDK.h"
+#endif
+#include "../SDKEngine/PluginSDK/PluginSDK.h"
+#include "../SDKEngine/VirtualSDK/VirtualSDK.h"
+#include "../SDKEngine/OpenRGBSDK/OpenRGBSDK.h"
+#include "../SDKEngine/SysfsSDK/SysfsSDK.h"
 
 using namespace web::http;
 using namespace web::http::experimental::listener;
-using std::wstring;
 using std::map;
 using std::pair;
 using std::tuple;
@@ -30,16 +47,20 @@ using std::thread;
 using std::atomic;
 using std::function;
 using std::list;
+using std::unordered_map;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
 
 
 /**
  * A struct that stores endpoint information.
  */
 typedef struct endPoint {
-    wstring uri;
-    method method;
-    function<void(http_request)> handler;
-    http_listener* listener;
+    utility::string_t uri;
+    web::http::method method;
+    function<pplx::task<void>(http_request)> handler;
 } EndPoint;
 
 /**
@@ -48,23 +69,44 @@ typedef struct endPoint {
 class RESTServer {
 private:
     ConfigValues configValues;
-    wstring baseAddress;
+    utility::string_t baseAddress;
     thread* serverThread;
     atomic<bool> exitFlag{false};
+    atomic<bool> acceptingRequests{true};
+    atomic<int> inFlightCount{0};
+    mutex shutdownMutex;
+    condition_variable shutdownCondition;
+    ShutdownSignal* shutdownSignal;
+    static ShutdownSignal* activeShutdownSignal; // the one that signalHandler notifies
+    static volatile sig_atomic_t receivedSignal; // 0 until SIGINT or SIGTERM arrived
 
+    http_listener* listener;
     list<endPoint*> endpoints;
+    unordered_map<utility::string_t, map<method, EndPoint*>> routes;
     AbstractLogger* logger;
-    AbstractSDK** sdks;
+    vector<AbstractSDK*>* sdks;
+    UDPServer* udpServer;
+    WebSocketServer* webSocketServer;
+    EffectEngine* effectEngine;
+    Framebuffer* framebuffer;
 
-    void activateListeners();
-    void initListeners();
-    static EndPoint* generateEndPoint(const wstring&, const method&, const function<void(http_request)>&);
+    void dispatchRequest(const http_request&);
+    void handleRequest(const EndPoint*, const http_request&);
+    void drainRequests();
+    static void signalHandler(int);
+    void activateListener();
+    void initEndPoints();
+    static EndPoint* generateEndPoint(const utility::string_t&, const method&, const function<pplx::task<void>(http_request)>&);
     void generateLoggerInstance();
     void generateSDKInstances();
+    void loadPlugin(const string&);
+    void generateStreamServers();
+    void generateEffectEngine();
 public:
     RESTServer();
     ~RESTServer();
     void startServer();
+    void requestStop();
 };
 
 
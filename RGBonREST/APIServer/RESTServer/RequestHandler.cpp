@@ -12,18 +12,18 @@
  * This member function will take care of everything that is happening at endpoint /general/connection
  * @param request the request that was sent by the listener itself.
  * @param logger the pointer address of AbstractLogger's instance to log with
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::General::connection(const http_request& request, AbstractLogger* logger) {
+pplx::task<void> RequestHandler::General::connection(const http_request& request, AbstractLogger* logger) {
     json responseData;
 
     responseData["result"] = 200;
     responseData["version"] = RGBONREST_VERSION;
     responseData["text"] = "Yay! Server is running.";
 
-    wstring responseString = Misc::convertWstring(responseData.dump(4)); // convert json into string so that we can make response.
-    if (logger != nullptr)
-        logger->log("/general/connection/", "None", "None");
-    request.reply(status_codes::OK, responseString);
+    utility::string_t responseString = utility::conversions::to_string_t(responseData.dump(4)); // convert json into string so that we can make response.
+    RequestHandler::General::logReply(logger, "/general/connection", status_codes::OK);
+    return request.reply(status_codes::OK, responseString);
 }
 
 /**
@@ -31,11 +31,66 @@ void RequestHandler::General::connection(const http_request& request, AbstractLo
  * This member function will log and then answer the request "Bye :)"
  * @param request the request that was sent by the listener itself.
  * @param logger the pointer address of AbstractLogger's instance to log with
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::General::stop_server(const http_request& request, AbstractLogger* logger) {
-    if (logger != nullptr)
-        logger->log("/general/stop_server/", "None", "None");
-    request.reply(status_codes::OK, "Bye :)");
+pplx::task<void> RequestHandler::General::stop_server(const http_request& request, AbstractLogger* logger) {
+    RequestHandler::General::logReply(logger, "/general/stop_server", status_codes::OK);
+    return request.reply(status_codes::OK, "Bye :)");
+}
+
+/**
+ * A member function for RequestHandler::General that responses with statistics of SDK executors.
+ * This member function will take care of everything that is happening at endpoint /general/statistics
+ * For each SDK, this shows how many commands are waiting, how many were executed, how many were superseded by newer
+ * commands for the same target and how many were refused because the queue was full.
+ * When logging is enabled, counters of the logger are shown under logger.
+ * @param request the request that was sent by the listener itself.
+ * @param logger the pointer address of AbstractLogger's instance to log with
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::General::statistics(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    json responseData;
+
+    for (int i = 0 ; i < (int) sdks->size() ; i++) {
+        SDKExecutor* executor = sdks->at(i)->executor;
+        json sdkData;
+        sdkData["queued"] = executor->getQueueLength();
+        sdkData["executed"] = executor->executedCount.load();
+        sdkData["superseded"] = executor->supersededCount.load();
+        sdkData["refused"] = executor->refusedCount.load();
+        for (auto const& x : sdks->at(i)->getStatistics()) // counters that only this SDK has
+            sdkData[x.first] = x.second;
+        responseData[sdks->at(i)->sdkName] = sdkData;
+    }
+    if (logger != nullptr) {
+        json loggerData = json::object();
+        for (auto const& x : logger->getStatistics())
+            loggerData[x.first] = x.second;
+        responseData["logger"] = loggerData;
+    }
+
+    utility::string_t responseString = utility::conversions::to_string_t(responseData.dump(4)); // convert json into string so that we can make response.
+    RequestHandler::General::logReply(logger, "/general/statistics", status_codes::OK);
+    return request.reply(status_codes::OK, responseString);
+}
+
+/**
+ * A static member function for RequestHandler::General that logs a request of /general, which has no parameters.
+ * This goes through logRequest like every other endpoint, so that loggers keep the status that was replied.
+ * @param logger the pointer address of AbstractLogger's instance to log with, or nullptr when logging is disabled.
+ * @param endpointName the endpoint that was requested.
+ * @param statusCode the HTTP status that was replied.
+ */
+void RequestHandler::General::logReply(AbstractLogger* logger, const string& endpointName, status_code statusCode) {
+    if (logger == nullptr) return;
+
+    LogEntry entry;
+    entry.endpoint = endpointName;
+    entry.parameters = "None";
+    entry.result = "None";
+    entry.statusCode = statusCode;
+    logger->logRequest(entry);
 }
 
 /**
@@ -46,34 +101,16 @@ void RequestHandler::General::stop_server(const http_request& request, AbstractL
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::SDK::connect(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
-    string responseMessage;
-    string sdkName = sdk->sdkName;
-
-    string lowerSDKName = sdkName;
+pplx::task<void> RequestHandler::SDK::connect(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    string lowerSDKName = sdk->sdkName;
     transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
 
-    try {
-        sdk->connect();
-        responseMessage = "Success";
-        request.reply(status_codes::OK, responseMessage);
-    } catch (const SDKExceptions::SDKAlreadyConnected& e) {
-        responseMessage = sdkName + " SDK is already connected.";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKVersionMismatch& e) {
-        responseMessage = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKServiceNotRunning& e) {
-        responseMessage = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKUnexpectedError& e) {
-        responseMessage = sdkName + " SDK had unexpected error while connecting.";
-        request.reply(status_codes::InternalError, responseMessage);
-    }
-
-    if (logger != nullptr)
-        logger->log("/" + lowerSDKName + "/connect", "None", responseMessage);
+    return RequestHandler::SDK::dispatch(sdk, [sdk] { return RequestHandler::SDK::applyConnect(sdk); })
+    .then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/connect", previous);
+    });
 }
 
 /**
@@ -84,33 +121,16 @@ void RequestHandler::SDK::connect(const http_request& request, AbstractLogger* l
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::SDK::disconnect(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
-    string responseMessage;
-    string sdkName = sdk->sdkName;
-
-    string lowerSDKName = sdkName;
+pplx::task<void> RequestHandler::SDK::disconnect(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    string lowerSDKName = sdk->sdkName;
     transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
 
-    try {
-        sdk->disconnect();
-        responseMessage = "Success";
-        request.reply(status_codes::OK, responseMessage);
-    } catch (const SDKExceptions::SDKNotConnected& e) {
-        responseMessage = sdkName + " SDK was not connected. Connect SDK before executing this request.";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKVersionMismatch& e) {
-        responseMessage = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKServiceNotRunning& e) {
-        responseMessage = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
-        request.reply(status_codes::InternalError, responseMessage);
-    } catch (const SDKExceptions::SDKUnexpectedError& e) {
-        responseMessage = sdkName + " SDK had unexpected error while connecting.";
-        request.reply(status_codes::InternalError, responseMessage);
-    }
-    if (logger != nullptr)
-        logger->log("/" + lowerSDKName + "/disconnect", "None", responseMessage);
+    return RequestHandler::SDK::dispatch(sdk, [sdk] { return RequestHandler::SDK::applyDisconnect(sdk); })
+    .then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/disconnect", previous);
+    });
 }
 
 /**
@@ -121,103 +141,382 @@ void RequestHandler::SDK::disconnect(const http_request& request, AbstractLogger
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::SDK::get_device(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
-    string responseMessage;
-    string sdkName = sdk->sdkName;
-
-    string lowerSDKName = sdkName;
+pplx::task<void> RequestHandler::SDK::get_device(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    string lowerSDKName = sdk->sdkName;
     transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
 
-    json responseData;
-
-    try {
-        map<DeviceType, list<Device*>*> result = sdk->getDevices();
-        responseMessage = "Success";
-
-        for (auto const& category : result) {
-            string deviceType = Misc::convertDeviceType(category.first);
-            list<Device*> devices = *category.second;
-            vector<string> deviceNameVector;
-
-            if (!devices.empty()) {
-                for (auto const& device: devices) {
-                    deviceNameVector.emplace_back(device->name);
-                }
-                responseData[deviceType] = deviceNameVector;
-            }
-        }
-        wstring responseString = Misc::convertWstring(responseData.dump(4)); // convert json into string so that we can make response.
-        request.reply(status_codes::OK, responseString);
-    } catch (const SDKExceptions::SDKNotConnected& e) {
-        responseMessage = sdkName + " SDK was not connected. Connect SDK before executing this request.";
-        wstring replyString = Misc::convertWstring(responseMessage);
-        request.reply(status_codes::InternalError, responseMessage);
-    }
-    if (logger != nullptr)
-        logger->log("/" + lowerSDKName + "/get_device", "None", responseMessage);
+    return RequestHandler::SDK::dispatch(sdk, [sdk] { return RequestHandler::SDK::applyGetDevices(sdk); })
+    .then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/get_devices", previous);
+    });
 }
 
 /**
  * A member function for RequestHandler::SDK that handles /sdk/set_rgb/ endpoints.
  * For example this member function will take care of /corsair/set_rgb/ endpoint.
  * As mentioned in the document, this member function will call AbstractSDK::setRGB();
+ * The body is never waited for. Parsing starts when the body has arrived, and the reply is sent when the SDK is done.
+ * SDKs that flush asynchronously reply before devices acknowledged the colors, unless the body has "wait_ack": true.
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::SDK::set_rgb(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+pplx::task<void> RequestHandler::SDK::set_rgb(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
     http_request copy = request; // copy request
 
-    string sdkName = sdk->sdkName;
-    string lowerSDKName = sdkName;
+    string lowerSDKName = sdk->sdkName;
     transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
-    string responseMessage;
-    string requestString;
 
+    return copy.extract_string().then([sdk](const utility::string_t& body) { // parse and dispatch to SDK
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        RGBCommand command = RequestHandler::parseCommand(jsonData);
+        bool isWaitingAck = jsonData.value("wait_ack", false);
 
-    pplx::task<utility::string_t> body_json = copy.extract_string();
-    string jsonString = utility::conversions::to_utf8string(body_json.get()); // turn json into string.
+        pplx::task<HandlerResponse> applied = RequestHandler::SDK::dispatch(sdk, [sdk, command] {
+            return RequestHandler::SDK::applySetRGB(sdk, command);
+        }, command.deviceType);
+        if (!isWaitingAck) return applied;
+
+        return applied.then([sdk](const HandlerResponse& response) { // reply once devices answered
+            return RequestHandler::SDK::whenAcked(sdk, response);
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/set_rgb", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::SDK that handles /sdk/set_rgb_batch/ endpoints.
+ * For example this member function will take care of /corsair/set_rgb_batch/ endpoint.
+ * This parses every command once and calls AbstractSDK::setRGBBatch(), so that the SDK can flush once for all of them.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::SDK::set_rgb_batch(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    http_request copy = request; // copy request
+
+    string lowerSDKName = sdk->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([](const utility::string_t& body) { // parse
+        return RequestHandler::parseBatch(utility::conversions::to_utf8string(body));
+    }).then([sdk](const vector<RGBCommand>& commands) { // dispatch to SDK
+        return RequestHandler::SDK::dispatch(sdk, [sdk, commands] {
+            return RequestHandler::SDK::applySetRGBBatch(sdk, commands);
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/set_rgb_batch", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::SDK that handles /sdk/set_leds/ endpoints.
+ * For example this member function will take care of /corsair/set_leds/ endpoint.
+ * This calls AbstractSDK::setLedColorsBatch(), so that only the given LEDs change and the SDK can flush once.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::SDK::set_leds(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    http_request copy = request; // copy request
+
+    string lowerSDKName = sdk->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([](const utility::string_t& body) { // parse
+        return RequestHandler::parseLeds(utility::conversions::to_utf8string(body));
+    }).then([sdk](const vector<DeviceLedCommand>& commands) { // dispatch to SDK
+        return RequestHandler::SDK::dispatch(sdk, [sdk, commands] {
+            return RequestHandler::SDK::applySetLeds(sdk, commands);
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/set_leds", previous);
+    });
+}
+
+/**
+ * A static member function for RequestHandler::SDK that connects an SDK and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns the HandlerResponse to reply with.
+ */
+HandlerResponse RequestHandler::SDK::applyConnect(AbstractSDK* sdk) {
+    HandlerResponse response;
+    string sdkName = sdk->sdkName;
 
     try {
-        auto jsonData = json::parse(jsonString);
-        string deviceType = jsonData["DeviceType"];
+        sdk->connect();
+        response.message = "Success";
+    } catch (const SDKExceptions::SDKAlreadyConnected& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK is already connected.";
+    } catch (const SDKExceptions::SDKVersionMismatch& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
+    } catch (const SDKExceptions::SDKServiceNotRunning& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
+    } catch (const SDKExceptions::SDKConnectionFailed& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK could not connect to " + sdkName + " software.";
+    } catch (const SDKExceptions::NoDevicesConnected& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK could not find any devices connected.";
+    } catch (const SDKExceptions::SDKUnexpectedError& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK had unexpected error while connecting.";
+    } catch (const std::exception& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK had unexpected error while connecting.";
+    }
+    return response;
+}
 
-        int type = Misc::convertDeviceType(deviceType);
-        int rValue = jsonData["r"];
-        int gValue = jsonData["g"];
-        int bValue = jsonData["b"];
+/**
+ * A static member function for RequestHandler::SDK that disconnects an SDK and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns the HandlerResponse to reply with.
+ */
+HandlerResponse RequestHandler::SDK::applyDisconnect(AbstractSDK* sdk) {
+    HandlerResponse response;
+    string sdkName = sdk->sdkName;
 
-        requestString = deviceType + " : (" + to_string(rValue) + " , " + to_string(gValue) + " , " + to_string(bValue) + ")";
+    try {
+        sdk->disconnect();
+        response.message = "Success";
+    } catch (const SDKExceptions::SDKNotConnected& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK was not connected. Connect SDK before executing this request.";
+    } catch (const SDKExceptions::SDKVersionMismatch& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
+    } catch (const SDKExceptions::SDKServiceNotRunning& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
+    } catch (const SDKExceptions::SDKUnexpectedError& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK had unexpected error while connecting.";
+    } catch (const std::exception& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdkName + " SDK had unexpected error while disconnecting.";
+    }
+    return response;
+}
 
-        try {
-            sdk->setRGB((DeviceType) type, rValue, gValue, bValue);
-            responseMessage = "Successfully set RGB";
-            request.reply(status_codes::OK, responseMessage);
-        } catch (const SDKExceptions::InvalidDeviceType &e) {
-            responseMessage = "Invalid device type was provided";
-            request.reply(status_codes::InternalError, responseMessage);
-        } catch (const SDKExceptions::InvalidRGBValue &e) {
-            responseMessage = "Invalid rgb value was provided";
-            request.reply(status_codes::InternalError, responseMessage);
-        } catch (const SDKExceptions::SDKNotConnected &e) {
-            responseMessage = sdkName + " SDK was not connected. Connect SDK before executing this request.";
-            request.reply(status_codes::InternalError, responseMessage);
-        } catch (const SDKExceptions::SomeRGBFailed &e) {
-            responseMessage = "Some RGBs were set, however some failed.";
-            request.reply(status_codes::OK, responseMessage);
-        } catch (const SDKExceptions::AllRGBFailed &e) {
-            responseMessage = "All RGBs failed.";
-            request.reply(status_codes::InternalError, responseMessage);
+/**
+ * A static member function for RequestHandler::SDK that gets devices of an SDK and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns the HandlerResponse to reply with. The message is the devices in json when successful.
+ */
+HandlerResponse RequestHandler::SDK::applyGetDevices(AbstractSDK* sdk) {
+    HandlerResponse response;
+
+    try {
+        response.message = RequestHandler::convertDevices(sdk->getDevices()).dump(4);
+        response.logMessage = "Success";
+    } catch (const SDKExceptions::SDKNotConnected& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK was not connected. Connect SDK before executing this request.";
+    } catch (const std::exception& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    }
+    return response;
+}
+
+/**
+ * A static member function for RequestHandler::SDK that sets RGB of an SDK and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param command the parsed set_rgb command.
+ * @return returns the HandlerResponse to reply with.
+ */
+HandlerResponse RequestHandler::SDK::applySetRGB(AbstractSDK* sdk, const RGBCommand& command) {
+    HandlerResponse response;
+    response.requestString = RequestHandler::convertCommand(command);
+    response.target = command.deviceType;
+    response.r = command.r;
+    response.g = command.g;
+    response.b = command.b;
+
+    try {
+        sdk->setRGB(command.deviceType, command.r, command.g, command.b);
+        response.message = "Successfully set RGB";
+        response.flushTicket = sdk->getFlushTicket();
+    } catch (const SDKExceptions::InvalidDeviceType &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Invalid device type was provided";
+    } catch (const SDKExceptions::InvalidRGBValue &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Invalid rgb value was provided";
+    } catch (const SDKExceptions::SDKNotConnected &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK was not connected. Connect SDK before executing this request.";
+    } catch (const SDKExceptions::SomeRGBFailed &e) {
+        response.message = "Some RGBs were set, however some failed.";
+    } catch (const SDKExceptions::AllRGBFailed &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "All RGBs failed.";
+    } catch (const SDKExceptions::SDKServiceNotRunning &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK could not find its software running.";
+    } catch (const SDKExceptions::SDKUnexpectedError &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    } catch (const std::exception &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    }
+    return response;
+}
+
+/**
+ * A static member function for RequestHandler::SDK that sets RGB of an SDK in a batch and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param commands the parsed set_rgb_batch commands.
+ * @return returns the HandlerResponse to reply with. The message is a compact array of result codes.
+ */
+HandlerResponse RequestHandler::SDK::applySetRGBBatch(AbstractSDK* sdk, const vector<RGBCommand>& commands) {
+    HandlerResponse response;
+    response.requestString = to_string(commands.size()) + " commands";
+
+    vector<CommandResult> results = sdk->setRGBBatch(commands);
+    json responseData = results; // compact array of result codes, one for each command.
+    response.message = responseData.dump();
+    if (!RequestHandler::isBatchSuccessful(results))
+        response.statusCode = status_codes::InternalError;
+    return response;
+}
+
+/**
+ * A static member function for RequestHandler::SDK that sets LEDs of devices of an SDK and builds the response.
+ * Devices are looked up here, on the executor, since the devices of an SDK change when it connects.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param commands the parsed set_leds commands.
+ * @return returns the HandlerResponse to reply with.
+ */
+HandlerResponse RequestHandler::SDK::applySetLeds(AbstractSDK* sdk, const vector<DeviceLedCommand>& commands) {
+    HandlerResponse response;
+    size_t ledCount = 0;
+    for (auto const& x : commands)
+        ledCount += x.leds.size();
+    response.requestString = to_string(ledCount) + " LEDs of " + to_string(commands.size()) + " devices";
+
+    if (!sdk->isConnected) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK was not connected. Connect SDK before executing this request.";
+        return response;
+    }
+
+    vector<DeviceLedColors> deviceLeds;
+    for (auto const& x : commands) {
+        const Device* device = RequestHandler::findDevice(sdk, x.deviceType, x.devicePosition);
+        if (device == nullptr) {
+            response.statusCode = status_codes::InternalError;
+            response.message = "Invalid device was provided";
+            return response;
         }
-    } catch (const std::exception &ex) { // if somewhat json was not able to parse request, throw exception;
-        request.reply(status_codes::UnprocessableEntity, "Wrong POST data format. Check reference.");
-        responseMessage = "Wrong POST data format. Check reference.";
+        deviceLeds.push_back(DeviceLedColors{device, x.leds});
     }
 
-    if (logger != nullptr) {
-        logger->log("/" + lowerSDKName + "/set_rgb", requestString, responseMessage);
+    try {
+        sdk->setLedColorsBatch(deviceLeds);
+        response.message = "Successfully set LEDs";
+    } catch (const SDKExceptions::InvalidRGBValue &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Invalid rgb value was provided";
+    } catch (const SDKExceptions::SDKNotConnected &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK was not connected. Connect SDK before executing this request.";
+    } catch (const SDKExceptions::SomeRGBFailed &e) {
+        response.message = "Some RGBs were set, however some failed.";
+    } catch (const SDKExceptions::AllRGBFailed &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "All RGBs failed.";
+    } catch (const SDKExceptions::SDKServiceNotRunning &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK could not find its software running.";
+    } catch (const SDKExceptions::SDKUnexpectedError &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    } catch (const std::exception &e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    }
+    return response;
+}
+
+/**
+ * A static member function for RequestHandler::SDK that returns a task that is done when devices acknowledged the
+ * colors of a response. Nothing blocks while waiting, the task is done by the SDK when devices answer or it gives up.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param response the response that the executor built, with the flushTicket of its colors.
+ * @return returns a task of response, or of a 500 Internal Server Error response if devices did not acknowledge the
+ * colors.
+ */
+pplx::task<HandlerResponse> RequestHandler::SDK::whenAcked(AbstractSDK* sdk, const HandlerResponse& response) {
+    if (response.statusCode != status_codes::OK)
+        return pplx::task_from_result(response);
+
+    return sdk->whenAcked(response.flushTicket).then([response](bool isAcked) {
+        if (isAcked) return response;
+
+        HandlerResponse failed = response;
+        failed.statusCode = status_codes::InternalError;
+        failed.message = "RGB values were sent, however devices did not acknowledge them.";
+        return failed;
+    });
+}
+
+/**
+ * A static member function for RequestHandler::SDK that runs a job on the executor of an SDK.
+ * Calls into the same SDK never overlap, and a slow SDK only makes requests for itself wait.
+ * When key is not negative, a newer job with the same key that arrives before this one runs replaces it, and this one
+ * is answered with "Superseded by newer RGB values." since the target ends up with the newer state anyway.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param job the job that talks to the SDK and builds the response.
+ * @param key the target that job sets, for example a DeviceType. -1 if job should never be superseded.
+ * @return returns a task of the HandlerResponse that job built. If the executor of the SDK was full, the task has a
+ * 503 Service Unavailable response instead.
+ */
+pplx::task<HandlerResponse> RequestHandler::SDK::dispatch(AbstractSDK* sdk, const function<HandlerResponse()>& job,
+                                                          int key) {
+    pplx::task_completion_event<HandlerResponse> completionEvent;
+    auto queuedAt = std::chrono::steady_clock::now();
+
+    auto run = [completionEvent, job, queuedAt] {
+        try {
+            HandlerResponse response = job();
+            response.latencyUs = (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - queuedAt).count();
+            completionEvent.set(response);
+        } catch (...) { // let the reply continuation see what went wrong
+            completionEvent.set_exception(std::current_exception());
+        }
+    };
+    auto supersede = [completionEvent] {
+        HandlerResponse response;
+        response.message = "Superseded by newer RGB values.";
+        completionEvent.set(response);
+    };
+
+    bool isQueued;
+    if (key < 0)
+        isQueued = sdk->executor->submit(run);
+    else
+        isQueued = sdk->executor->submitLatest(key, run, supersede);
+
+    if (!isQueued) {
+        HandlerResponse response;
+        response.statusCode = status_codes::ServiceUnavailable;
+        response.message = sdk->sdkName + " SDK is busy. Try again later.";
+        return pplx::task_from_result(response);
     }
+    return pplx::create_task(completionEvent);
 }
 
 /**
@@ -225,175 +524,835 @@ void RequestHandler::SDK::set_rgb(const http_request& request, AbstractLogger* l
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::ALL::connect(const http_request& request, AbstractLogger* logger, AbstractSDK** sdks) {
-    json responseData; // tmp json for saving results from requests
-    int successCount = 0; // count how many sdks successfully handled requests.
+pplx::task<void> RequestHandler::ALL::connect(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    return RequestHandler::ALL::dispatch(sdks, RequestHandler::SDK::applyConnect, false, -1)
+    .then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/all/connect", previous);
+    });
+}
 
-    for (int i = 0 ; i < SUPPORTED_SDK_COUNT ; i++) { // iterate over sdks and execute request
-        string sdkName = sdks[i]->sdkName;
-        try {
-            sdks[i]->connect();
-            responseData[sdkName] = "Success";
-            successCount++;
-        } catch (const SDKExceptions::SDKAlreadyConnected& e) {
-            responseData[sdkName] = sdkName + " SDK is already connected.";
-        } catch (const SDKExceptions::SDKVersionMismatch& e) {
-            responseData[sdkName] = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
-        } catch (const SDKExceptions::SDKServiceNotRunning& e) {
-            responseData[sdkName] = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
-        } catch (const SDKExceptions::SDKUnexpectedError& e) {
-            responseData[sdkName] = sdkName + " SDK had unexpected error while connecting.";
-        }
-    }
+/**
+ * A member function for RequestHandler::ALL that handles /all/disconnect endpoint
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::ALL::disconnect(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    return RequestHandler::ALL::dispatch(sdks, RequestHandler::SDK::applyDisconnect, false, -1)
+    .then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/all/disconnect", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::ALL that handles /all/get_devices endpoint
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::ALL::get_device(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    return RequestHandler::ALL::dispatch(sdks, RequestHandler::SDK::applyGetDevices, true, -1)
+    .then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/all/get_devices", previous);
+    });
+}
 
-    wstring replyString = Misc::convertWstring(responseData.dump(4)); // convert result into string
-    if (successCount == SUPPORTED_SDK_COUNT) // if all requests were successful, send reply
-        request.reply(status_codes::OK, replyString);
-    else  // if some failed, send InternalError
-        request.reply(status_codes::InternalError, replyString);
+/**
+ * A member function for RequestHandler::ALL that handles /all/set_rgb endpoint
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::ALL::set_rgb(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    http_request copy = request; // copy request
 
-    if (logger != nullptr)
-        logger->log("/all/connect", "None", "Too Long Data");
+    return copy.extract_string().then([](const utility::string_t& body) { // parse
+        return RequestHandler::parseCommand(json::parse(utility::conversions::to_utf8string(body)));
+    }).then([sdks](const RGBCommand& command) { // dispatch to SDKs
+        auto job = [command](AbstractSDK* sdk) { return RequestHandler::SDK::applySetRGB(sdk, command); };
+        return RequestHandler::ALL::dispatch(sdks, job, false, command.deviceType).then([command](HandlerResponse response) {
+            response.requestString = RequestHandler::convertCommand(command);
+            response.target = command.deviceType;
+            response.r = command.r;
+            response.g = command.g;
+            response.b = command.b;
+            return response;
+        });
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/all/set_rgb", previous);
+    });
 }
 
 /**
- * A member function for RequestHandler::ALL that handles /all/disconnect endpoint
+ * A member function for RequestHandler::ALL that handles /all/set_rgb_batch endpoint
+ * Every SDK gets the whole batch, and the result codes of each SDK are returned under its name.
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdks a pointer to list of AbstractSDK*.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::ALL::disconnect(const http_request& request, AbstractLogger* logger, AbstractSDK** sdks) {
-    json responseData; // tmp json for saving results from requests
-    int successCount = 0;
+pplx::task<void> RequestHandler::ALL::set_rgb_batch(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks) {
+    http_request copy = request; // copy request
 
-    for (int i = 0 ; i < SUPPORTED_SDK_COUNT ; i++) { // iterate over sdks and disconnect
-        string sdkName = sdks[i]->sdkName;
-        try {
-            sdks[i]->disconnect();
-            responseData[sdkName] = "Success";
-            successCount++;
-        } catch (const SDKExceptions::SDKNotConnected& e) {
-            responseData[sdkName] = sdkName + " SDK was not connected before";
-        } catch (const SDKExceptions::SDKVersionMismatch& e) {
-            responseData[sdkName] = sdkName + " SDK does not support current version. Please reinstall " + sdkName + " software";
-        } catch (const SDKExceptions::SDKServiceNotRunning& e) {
-            responseData[sdkName] = sdkName + " SDK could not connect to " + sdkName + " software. Please make sure " + sdkName +" software has SDK feature enabled";
-        } catch (const SDKExceptions::SDKUnexpectedError& e) {
-            responseData[sdkName] = sdkName + " SDK had unexpected error while connecting.";
-        }
+    return copy.extract_string().then([](const utility::string_t& body) { // parse
+        return RequestHandler::parseBatch(utility::conversions::to_utf8string(body));
+    }).then([sdks](const vector<RGBCommand>& commands) { // dispatch to SDKs
+        auto job = [commands](AbstractSDK* sdk) { return RequestHandler::SDK::applySetRGBBatch(sdk, commands); };
+        return RequestHandler::ALL::dispatch(sdks, job, true, -1).then([commands](HandlerResponse response) {
+            response.message = json::parse(response.message).dump(); // keep result codes compact
+            response.requestString = to_string(commands.size()) + " commands";
+            return response;
+        });
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/all/set_rgb_batch", previous);
+    });
+}
+
+/**
+ * A static member function for RequestHandler::ALL that runs a job on every SDK at the same time.
+ * Each SDK runs the job on its own executor, so the request takes as long as the slowest SDK instead of all of them
+ * added up.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param job the job to run for each SDK.
+ * @param isJsonMessage whether the message of each SDK is json that should be nested instead of quoted.
+ * @param key the target that job sets, passed to RequestHandler::SDK::dispatch. -1 if job should never be superseded.
+ * @return returns a task of the combined HandlerResponse, with the result of each SDK under its name. An SDK whose job
+ * threw is counted as failed with a 500 message of its own.
+ */
+pplx::task<HandlerResponse> RequestHandler::ALL::dispatch(vector<AbstractSDK*>* sdks,
+                                                          const function<HandlerResponse(AbstractSDK*)>& job,
+                                                          bool isJsonMessage, int key) {
+    vector<pplx::task<HandlerResponse>> tasks;
+    for (int i = 0 ; i < (int) sdks->size() ; i++) {
+        AbstractSDK* sdk = sdks->at(i);
+        tasks.push_back(RequestHandler::SDK::dispatch(sdk, [sdk, job] { return job(sdk); }, key)
+        .then([sdk](pplx::task<HandlerResponse> previous) { // one failing SDK must not fail the others
+            try {
+                return previous.get();
+            } catch (const std::exception& e) {
+                HandlerResponse response;
+                response.statusCode = status_codes::InternalError;
+                response.message = sdk->sdkName + " SDK had unexpected error.";
+                return response;
+            }
+        }));
     }
-    wstring replyString = Misc::convertWstring(responseData.dump(4));
 
-    if (successCount == SUPPORTED_SDK_COUNT) // if all requests were successful, send reply
-        request.reply(status_codes::OK, replyString);
-    else // if not, send InternalError
-        request.reply(status_codes::InternalError, replyString);
+    return pplx::when_all(tasks.begin(), tasks.end()).then([sdks, isJsonMessage](const vector<HandlerResponse>& responses) {
+        json responseData; // tmp json for saving results from requests
+        int successCount = 0; // count how many sdks successfully handled requests.
+        uint64_t latencyUs = 0; // the request is done when the slowest SDK is
 
-    if (logger != nullptr)
-        logger->log("/all/disconnect", "None", "Too Long Data");
+        for (int i = 0 ; i < (int) sdks->size() ; i++) {
+            json sdkResult = responses[i].message;
+            if (isJsonMessage) { // devices and result codes are nested, while error messages stay as strings.
+                json parsed = json::parse(responses[i].message, nullptr, false);
+                if (!parsed.is_discarded()) sdkResult = parsed;
+            }
+            responseData[sdks->at(i)->sdkName] = sdkResult;
+            successCount += (responses[i].statusCode == status_codes::OK);
+            latencyUs = responses[i].latencyUs > latencyUs ? responses[i].latencyUs : latencyUs;
+        }
+        HandlerResponse response = RequestHandler::ALL::generateResponse(responseData, successCount, (int) sdks->size());
+        response.latencyUs = latencyUs;
+        return response;
+    });
 }
 
 /**
- * A member function for RequestHandler::ALL that handles /all/get_devices endpoint
+ * A static member function for RequestHandler::ALL that builds the response from results of every SDK.
+ * @param responseData the results of every SDK, under each SDK's name.
+ * @param successCount how many SDKs successfully handled the request.
+ * @param sdkCount how many SDKs were asked to handle the request.
+ * @return returns 200 OK if every SDK was successful, 500 Internal Server Error if not.
+ */
+HandlerResponse RequestHandler::ALL::generateResponse(const json& responseData, int successCount, int sdkCount) {
+    HandlerResponse response;
+    response.message = responseData.dump(4);
+    response.logMessage = "Too Long Data";
+    if (successCount != sdkCount)
+        response.statusCode = status_codes::InternalError;
+    return response;
+}
+
+/**
+ * A member function for RequestHandler::Effects that handles /effects/start endpoint
+ * The body names the SDK ("all" when missing), the DeviceType, the effect and optionally its speed and colors.
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdks a pointer to list of AbstractSDK*.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::ALL::get_device(const http_request& request, AbstractLogger* logger, AbstractSDK** sdks) {
-    json responseData;
-    int successCount = 0;
+pplx::task<void> RequestHandler::Effects::start(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                                EffectEngine* effectEngine) {
+    http_request copy = request; // copy request
 
-    for (int i = 0 ; i < SUPPORTED_SDK_COUNT ; i++) { // iterate over sdks
-        string sdkName = sdks[i]->sdkName;
-        json tmpJson; // tmp json for storing results from sdks.
+    return copy.extract_string().then([sdks, effectEngine](const utility::string_t& body) { // parse and start
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        return RequestHandler::Effects::applyStart(sdks, effectEngine, jsonData);
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/effects/start", previous);
+    });
+}
 
-        try {
-            map<DeviceType, list<Device*>*> result = sdks[i]->getDevices();
-            for (auto const& category : result) {
-                string deviceType = Misc::convertDeviceType(category.first);
-                list<Device*> devices = *category.second;
-                vector<string> deviceNameVector;
-                if (!devices.empty()) {
-                    for (auto const& device: devices) {
-                        deviceNameVector.emplace_back(device->name);
-                    }
-                    tmpJson[deviceType] = deviceNameVector;
-                }
-            }
-            responseData[sdkName] = tmpJson;
-            successCount++;
-        } catch (const SDKExceptions::SDKNotConnected& e) {
-            responseData[sdkName] = sdkName + " SDK was not connected. Connect SDK before executing this request.";
+/**
+ * A member function for RequestHandler::Effects that handles /effects/stop endpoint
+ * The body names the SDK ("all" when missing) and the DeviceType to stop. An empty body stops every effect.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Effects::stop(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                               EffectEngine* effectEngine) {
+    http_request copy = request; // copy request
+
+    return copy.extract_string().then([sdks, effectEngine](const utility::string_t& body) { // parse and stop
+        string jsonString = utility::conversions::to_utf8string(body);
+        HandlerResponse response;
+
+        if (jsonString.empty()) { // stop everything
+            response.message = "Stopped " + to_string(effectEngine->stopAllEffects()) + " effects";
+            return response;
         }
+
+        json jsonData = json::parse(jsonString);
+        int sdkIndex = RequestHandler::convertSDKName(sdks, jsonData.value("sdk", string("all")));
+        string deviceType = jsonData.at("DeviceType");
+        response.requestString = jsonData.value("sdk", string("all")) + " " + deviceType;
+
+        if (sdkIndex == -2) {
+            response.statusCode = status_codes::InternalError;
+            response.message = "Invalid sdk was provided";
+            return response;
+        }
+        int stoppedCount = effectEngine->stopEffect(sdkIndex, (DeviceType) Misc::convertDeviceType(deviceType));
+        response.message = "Stopped " + to_string(stoppedCount) + " effects";
+        return response;
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/effects/stop", previous);
+    });
+}
+
+/**
+ * A static member function for RequestHandler::Effects that starts an effect from the body of /effects/start.
+ * "colors" is an array of {"r", "g", "b"} objects. A single color can also be given with "r", "g" and "b" like
+ * set_rgb. Without colors, effects use white, and color_cycle uses red, green and blue.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @param jsonData the parsed body of the request.
+ * @return returns the HandlerResponse to reply with.
+ * @throws std::exception when the body did not have DeviceType or effect, or a color did not have r, g or b.
+ */
+HandlerResponse RequestHandler::Effects::applyStart(vector<AbstractSDK*>* sdks, EffectEngine* effectEngine, const json& jsonData) {
+    HandlerResponse response;
+    string sdkName = jsonData.value("sdk", string("all"));
+    string deviceTypeName = jsonData.at("DeviceType");
+    string effectName = jsonData.at("effect");
+    response.requestString = sdkName + " " + deviceTypeName + " : " + effectName;
+
+    EffectParameters parameters;
+    int sdkIndex = RequestHandler::convertSDKName(sdks, sdkName);
+    DeviceType deviceType = (DeviceType) Misc::convertDeviceType(deviceTypeName);
+    parameters.speed = jsonData.value("speed", 1.0);
+
+    if (jsonData.contains("colors")) {
+        for (auto const& x : jsonData.at("colors"))
+            parameters.colors.push_back(EffectColor{x.at("r"), x.at("g"), x.at("b")});
+    } else if (jsonData.contains("r")) {
+        parameters.colors.push_back(EffectColor{jsonData.at("r"), jsonData.at("g"), jsonData.at("b")});
     }
-    wstring replyString = Misc::convertWstring(responseData.dump(4));
 
-    if (successCount == SUPPORTED_SDK_COUNT)
-        request.reply(status_codes::OK, replyString);
+    bool isValidRgb = true;
+    for (auto const& x : parameters.colors)
+        isValidRgb &= (x.r >= 0 && x.r <= 255 && x.g >= 0 && x.g <= 255 && x.b >= 0 && x.b <= 255);
+
+    response.statusCode = status_codes::InternalError;
+    if (sdkIndex == -2)
+        response.message = "Invalid sdk was provided";
+    else if (deviceType == UnknownDevice)
+        response.message = "Invalid device type was provided";
+    else if (!Effect::convertEffectType(effectName, parameters.type))
+        response.message = "Invalid effect was provided";
+    else if (!isValidRgb)
+        response.message = "Invalid rgb value was provided";
+    else if (parameters.speed <= 0)
+        response.message = "Invalid speed was provided";
     else
-        request.reply(status_codes::InternalError, replyString);
+        response.statusCode = status_codes::OK;
+    if (response.statusCode != status_codes::OK) return response;
 
-    if (logger != nullptr)
-        logger->log("/all/disconnect", "None", "Too Long Data");
+    if (parameters.colors.empty() && parameters.type == EffectColorCycle)
+        parameters.colors = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+    else if (parameters.colors.empty())
+        parameters.colors = {{255, 255, 255}};
+
+    for (int i = 0 ; i < (int) sdks->size() ; i++) {
+        if (sdkIndex != -1 && sdkIndex != i) continue;
+        effectEngine->startEffect(i, deviceType, parameters);
+    }
+    response.message = "Started " + effectName + " effect";
+    return response;
 }
 
 /**
- * A member function for RequestHandler::ALL that handles /all/set_rgb endpoint
+ * A member function for RequestHandler::Leds that handles /leds/layout endpoint
+ * This shows which framebuffer indices belong to which device.
  * @param request the http_request that was sent
  * @param logger the pointer to AbstractLogger instance.
  * @param sdks a pointer to list of AbstractSDK*.
+ * @param framebuffer the pointer to Framebuffer instance.
+ * @return returns a task that is done when the request was replied.
  */
-void RequestHandler::ALL::set_rgb(const http_request& request, AbstractLogger* logger, AbstractSDK** sdks) {
-    json responseData;
-    int successCount = 0;
-    string requestString;
-    string responseMessage;
+pplx::task<void> RequestHandler::Leds::layout(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                              Framebuffer* framebuffer) {
+    return framebuffer->prepare().then([sdks, framebuffer] {
+        HandlerResponse response;
+        json responseData;
+        json devicesData = json::array();
+
+        for (auto const& x : framebuffer->getLayout()) {
+            json deviceData;
+            deviceData["sdk"] = sdks->at(x.sdkIndex)->sdkName;
+            deviceData["name"] = x.name;
+            deviceData["DeviceType"] = Misc::convertDeviceType(x.deviceType);
+            deviceData["first"] = x.first;
+            deviceData["count"] = x.ledIds.size();
+            devicesData.push_back(deviceData);
+        }
+        responseData["count"] = framebuffer->getLedCount();
+        responseData["devices"] = devicesData;
 
+        response.message = responseData.dump(4);
+        response.logMessage = "Too Long Data";
+        return response;
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/leds/layout", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::Leds that handles /leds/set endpoint
+ * Colors are written into the framebuffer, and only LEDs whose color changed are sent to SDKs.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param framebuffer the pointer to Framebuffer instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Leds::set(const http_request& request, AbstractLogger* logger, Framebuffer* framebuffer) {
     http_request copy = request; // copy request
-    pplx::task<utility::string_t> body_json = copy.extract_string();
-    string jsonString = utility::conversions::to_utf8string(body_json.get()); // turn json into string.
 
-    try { // try parsing request
-        auto jsonData = json::parse(jsonString);
-        string deviceType = jsonData["DeviceType"];
+    return copy.extract_string().then([framebuffer](const utility::string_t& body) { // parse
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        return framebuffer->prepare().then([framebuffer, jsonData] { // write once the layout is up to date
+            return RequestHandler::Leds::applySet(framebuffer, jsonData);
+        });
+    }).then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/leds/set", previous);
+    });
+}
 
-        int type = Misc::convertDeviceType(deviceType);
-        int rValue = jsonData["r"];
-        int gValue = jsonData["g"];
-        int bValue = jsonData["b"]; // parse data
+/**
+ * A static member function for RequestHandler::Leds that writes the body of /leds/set into the framebuffer and flushes.
+ * "leds" is an array of {"index", "r", "g", "b"} objects for LEDs anywhere in the framebuffer. "first" and "colors"
+ * set consecutive LEDs starting from first, with an array of {"r", "g", "b"} objects. Both can be in the same body.
+ * @param framebuffer the pointer to Framebuffer instance.
+ * @param jsonData the parsed body of the request.
+ * @return returns the HandlerResponse to reply with. The message shows how many LEDs changed.
+ * @throws std::exception when the body was not in the format above.
+ */
+HandlerResponse RequestHandler::Leds::applySet(Framebuffer* framebuffer, const json& jsonData) {
+    HandlerResponse response;
+    vector<FramebufferWrite> writes;
 
-        requestString = deviceType + " : (" + to_string(rValue) + " , " + to_string(gValue) + " , " + to_string(bValue) + ")";
-        for (int i = 0 ; i < SUPPORTED_SDK_COUNT ; i++) {
-            string sdkName = sdks[i]->sdkName;
-            try {
-                sdks[i]->setRGB((DeviceType)type, rValue, gValue, bValue);
-                responseData[sdkName] = "Successfully set RGB";
-                successCount++;
-            } catch (const SDKExceptions::InvalidDeviceType &e) {
-                responseData[sdkName] = "Invalid device type was provided";
-            } catch (const SDKExceptions::InvalidRGBValue &e) {
-                responseData[sdkName] = "Invalid rgb value was provided";
-            } catch (const SDKExceptions::SDKNotConnected &e) {
-                responseData[sdkName] = sdkName + " SDK was not connected. Connect SDK before executing this request.";
-            } catch (const SDKExceptions::SomeRGBFailed &e) {
-                responseData[sdkName] = "Some RGBs were set, however some failed.";
-            } catch (const SDKExceptions::AllRGBFailed &e) {
-                responseData[sdkName] = "All RGBs failed.";
+    if (jsonData.contains("leds")) {
+        for (auto const& x : jsonData.at("leds"))
+            writes.push_back(FramebufferWrite{x.at("index"), x.at("r"), x.at("g"), x.at("b")});
+    }
+    if (jsonData.contains("first")) {
+        size_t index = jsonData.at("first");
+        for (auto const& x : jsonData.at("colors"))
+            writes.push_back(FramebufferWrite{index++, x.at("r"), x.at("g"), x.at("b")});
+    }
+    response.requestString = to_string(writes.size()) + " LEDs";
+
+    try {
+        size_t changed = framebuffer->write(writes);
+        framebuffer->flush();
+
+        json responseData;
+        responseData["changed"] = changed;
+        responseData["unchanged"] = writes.size() - changed;
+        response.message = responseData.dump();
+    } catch (const Framebuffer::InvalidLedIndex& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Invalid LED index was provided";
+    } catch (const SDKExceptions::InvalidRGBValue& e) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Invalid rgb value was provided";
+    }
+    return response;
+}
+
+/**
+ * A member function for RequestHandler::Animation that handles /sdk/animation/upload endpoints.
+ * For example this member function will take care of /razer/animation/upload endpoint.
+ * The SDK prepares every frame once, so that playing the animation later is cheap.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Animation::upload(const http_request& request, AbstractLogger* logger, AbstractSDK* sdk) {
+    http_request copy = request; // copy request
+
+    string lowerSDKName = sdk->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([](const utility::string_t& body) { // parse
+        return RequestHandler::parseAnimation(utility::conversions::to_utf8string(body));
+    }).then([sdk](const AnimationCommand& command) { // dispatch to SDK
+        string requestString = to_string(command.frames.size()) + " frames";
+        return RequestHandler::SDK::dispatch(sdk, [sdk, command, requestString] {
+            return RequestHandler::Animation::applyAnimation(sdk, requestString, [sdk, command] {
+                const Device* device = RequestHandler::findDevice(sdk, command.deviceType, command.devicePosition);
+                if (device == nullptr) throw SDKExceptions::InvalidDeviceType();
+
+                json responseData;
+                responseData["animation"] = sdk->uploadAnimation(device, command.frames);
+                responseData["frames"] = command.frames.size();
+                return responseData.dump();
+            });
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/animation/upload", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::Animation that handles /sdk/animation/play endpoints.
+ * The first frame is shown right away on the executor of the SDK, which also checks that the animation exists.
+ * Then EffectEngine shows the next frames at "fps", looping until the animation is stopped or deleted.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Animation::play(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                                 int sdkIndex, EffectEngine* effectEngine) {
+    http_request copy = request; // copy request
+    AbstractSDK* sdk = sdks->at(sdkIndex);
+
+    string lowerSDKName = sdk->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([sdk, sdkIndex, effectEngine](const utility::string_t& body) { // parse and dispatch
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        int animationId = jsonData.at("animation");
+        double fps = jsonData.value("fps", 30.0);
+        string requestString = "animation " + to_string(animationId);
+
+        if (fps <= 0) {
+            HandlerResponse response;
+            response.requestString = requestString;
+            response.statusCode = status_codes::InternalError;
+            response.message = "Invalid fps was provided";
+            return pplx::task_from_result(response);
+        }
+
+        return RequestHandler::SDK::dispatch(sdk, [sdk, sdkIndex, effectEngine, animationId, fps, requestString] {
+            return RequestHandler::Animation::applyAnimation(sdk, requestString, [=] {
+                sdk->showAnimationFrame(animationId, 0);
+                effectEngine->startAnimation(sdkIndex, animationId, fps);
+                return "Playing animation " + to_string(animationId);
+            });
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/animation/play", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::Animation that handles /sdk/animation/stop endpoints.
+ * Devices keep showing the frame they showed last. The animation can be played again later.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Animation::stop(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                                 int sdkIndex, EffectEngine* effectEngine) {
+    http_request copy = request; // copy request
+
+    string lowerSDKName = sdks->at(sdkIndex)->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([sdkIndex, effectEngine](const utility::string_t& body) { // parse and stop
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        int animationId = jsonData.at("animation");
+
+        HandlerResponse response;
+        response.requestString = "animation " + to_string(animationId);
+        if (effectEngine->stopAnimation(sdkIndex, animationId)) {
+            response.message = "Stopped animation " + to_string(animationId);
+        } else {
+            response.statusCode = status_codes::InternalError;
+            response.message = "Animation " + to_string(animationId) + " was not playing";
+        }
+        return response;
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/animation/stop", previous);
+    });
+}
+
+/**
+ * A member function for RequestHandler::Animation that handles /sdk/animation/delete endpoints.
+ * The animation is stopped if it was playing, then the SDK deletes every frame it prepared.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param sdkIndex the index of the SDK in sdks.
+ * @param effectEngine the pointer to EffectEngine instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Animation::remove(const http_request& request, AbstractLogger* logger, vector<AbstractSDK*>* sdks,
+                                                   int sdkIndex, EffectEngine* effectEngine) {
+    http_request copy = request; // copy request
+    AbstractSDK* sdk = sdks->at(sdkIndex);
+
+    string lowerSDKName = sdk->sdkName;
+    transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+
+    return copy.extract_string().then([sdk, sdkIndex, effectEngine](const utility::string_t& body) { // parse and dispatch
+        json jsonData = json::parse(utility::conversions::to_utf8string(body));
+        int animationId = jsonData.at("animation");
+        string requestString = "animation " + to_string(animationId);
+
+        effectEngine->stopAnimation(sdkIndex, animationId); // frames that were already queued fail quietly
+        return RequestHandler::SDK::dispatch(sdk, [sdk, animationId, requestString] {
+            return RequestHandler::Animation::applyAnimation(sdk, requestString, [sdk, animationId] {
+                sdk->deleteAnimation(animationId);
+                return "Deleted animation " + to_string(animationId);
+            });
+        });
+    }).then([request, logger, lowerSDKName](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/" + lowerSDKName + "/animation/delete", previous);
+    });
+}
+
+/**
+ * A static member function for RequestHandler::Animation that runs an animation job and builds the response.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param requestString the request to log.
+ * @param job the job that talks to the SDK and returns the message to reply with.
+ * @return returns the HandlerResponse to reply with.
+ */
+HandlerResponse RequestHandler::Animation::applyAnimation(AbstractSDK* sdk, const string& requestString,
+                                                          const function<string()>& job) {
+    HandlerResponse response;
+    response.requestString = requestString;
+    response.statusCode = status_codes::InternalError;
+
+    try {
+        response.message = job();
+        response.statusCode = status_codes::OK;
+    } catch (const SDKExceptions::AnimationNotSupported &e) {
+        response.message = sdk->sdkName + " SDK does not support animations.";
+    } catch (const SDKExceptions::InvalidAnimation &e) {
+        response.message = "Invalid animation was provided";
+    } catch (const SDKExceptions::InvalidDeviceType &e) {
+        response.message = "Invalid device was provided";
+    } catch (const SDKExceptions::InvalidRGBValue &e) {
+        response.message = "Invalid rgb value was provided";
+    } catch (const SDKExceptions::SDKNotConnected &e) {
+        response.message = sdk->sdkName + " SDK was not connected. Connect SDK before executing this request.";
+    } catch (const SDKExceptions::SDKServiceNotRunning &e) {
+        response.message = sdk->sdkName + " SDK could not find its software running.";
+    } catch (const SDKExceptions::NoDevicesConnected &e) {
+        response.message = sdk->sdkName + " SDK could not find any devices connected.";
+    } catch (const SDKExceptions::SDKUnexpectedError &e) {
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    } catch (const std::exception &e) {
+        response.message = sdk->sdkName + " SDK had unexpected error.";
+    }
+    return response;
+}
+
+/**
+ * A member function for RequestHandler::Virtual that handles /virtual/frames endpoint
+ * This shows what the virtual SDK applied: the current color of every LED, and the latest frames it kept.
+ * @param request the http_request that was sent
+ * @param logger the pointer to AbstractLogger instance.
+ * @param sdk the pointer to VirtualSDK instance.
+ * @return returns a task that is done when the request was replied.
+ */
+pplx::task<void> RequestHandler::Virtual::frames(const http_request& request, AbstractLogger* logger, VirtualSDK* sdk) {
+    return RequestHandler::SDK::dispatch(sdk, [sdk] { return RequestHandler::Virtual::applyFrames(sdk); })
+    .then([request, logger](pplx::task<HandlerResponse> previous) { // reply
+        RequestHandler::reply(request, logger, "/virtual/frames", previous);
+    });
+}
+
+/**
+ * A static member function for RequestHandler::Virtual that builds the response of /virtual/frames.
+ * This runs on the executor of the SDK, since devices change when it connects.
+ * @param sdk the pointer to VirtualSDK instance.
+ * @return returns the HandlerResponse to reply with. The message has "devices" with the colors of every LED, and
+ * "frames" with the latest frames, oldest first.
+ */
+HandlerResponse RequestHandler::Virtual::applyFrames(VirtualSDK* sdk) {
+    HandlerResponse response;
+    json responseData;
+    json devicesData = json::array();
+    json framesData = json::array();
+
+    if (sdk->isConnected) {
+        for (auto const& category : sdk->devices) {
+            for (auto const& device : *category.second) {
+                json deviceData;
+                deviceData["device"] = device->deviceIndex;
+                deviceData["name"] = device->name;
+                deviceData["DeviceType"] = Misc::convertDeviceType(device->deviceType);
+                deviceData["leds"] = json::array();
+                for (auto const& x : sdk->getLedColors(device))
+                    deviceData["leds"].push_back({x.r, x.g, x.b});
+                devicesData.push_back(deviceData);
             }
         }
-    } catch (const std::exception &ex) { // if somewhat json was not able to parse request, throw exception;
-        request.reply(status_codes::UnprocessableEntity, "Wrong POST data format. Check reference.");
-        responseMessage = "Wrong POST data format. Check reference.";
     }
 
-    wstring replyString = Misc::convertWstring(responseData.dump(4));
+    auto now = std::chrono::steady_clock::now();
+    for (auto const& x : sdk->getFrames()) {
+        json frameData;
+        frameData["sequence"] = x.sequence;
+        frameData["device"] = x.deviceIndex;
+        frameData["age_us"] = std::chrono::duration_cast<std::chrono::microseconds>(now - x.appliedAt).count();
+        frameData["leds"] = json::array();
+        for (auto const& y : x.leds)
+            frameData["leds"].push_back({{"id", y.ledId}, {"r", y.r}, {"g", y.g}, {"b", y.b}});
+        framesData.push_back(frameData);
+    }
 
-    if (successCount == SUPPORTED_SDK_COUNT)
-        request.reply(status_codes::OK, replyString);
-    else
-        request.reply(status_codes::InternalError, replyString);
+    responseData["devices"] = devicesData;
+    responseData["frames"] = framesData;
+    response.message = responseData.dump();
+    response.logMessage = "Too Long Data";
+    return response;
+}
+
+/**
+ * A static member function for RequestHandler that finds an SDK by its name.
+ * @param sdks a pointer to list of AbstractSDK*.
+ * @param sdkName the name of the SDK in any case, or "all".
+ * @return returns the index of the SDK in sdks, -1 for "all", or -2 if there was no SDK with that name.
+ */
+int RequestHandler::convertSDKName(vector<AbstractSDK*>* sdks, const string& sdkName) {
+    string lowerName = sdkName;
+    transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    if (lowerName == "all") return -1;
+
+    for (int i = 0 ; i < (int) sdks->size() ; i++) {
+        string lowerSDKName = sdks->at(i)->sdkName;
+        transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+        if (lowerSDKName == lowerName) return i;
+    }
+    return -2;
+}
+
+/**
+ * A static member function for RequestHandler that replies to a request and logs it.
+ * This is the last continuation of every handler. If the body could not be parsed, this replies 422 Unprocessable
+ * Entity. Any other exception that reached here is a bug of a handler, and is replied as 500 Internal Server Error.
+ * @param request the http_request to reply to.
+ * @param logger the pointer to AbstractLogger instance.
+ * @param endpointName the name of the endpoint to log with.
+ * @param previous the task that built the HandlerResponse.
+ */
+void RequestHandler::reply(const http_request& request, AbstractLogger* logger, const string& endpointName,
+                           const pplx::task<HandlerResponse>& previous) {
+    HandlerResponse response;
+    try {
+        response = previous.get();
+    } catch (const json::exception &ex) { // if somewhat json was not able to parse request
+        response.statusCode = status_codes::UnprocessableEntity;
+        response.message = "Wrong POST data format. Check reference.";
+    } catch (const std::invalid_argument &ex) { // if the body was json, but not in the format of the endpoint
+        response.statusCode = status_codes::UnprocessableEntity;
+        response.message = "Wrong POST data format. Check reference.";
+    } catch (const std::exception &ex) {
+        response.statusCode = status_codes::InternalError;
+        response.message = "Unexpected error while handling the request.";
+    }
 
-    if (logger != nullptr)
-        logger->log("/all/disconnect", "None", "Too Long Data");
-}
\ No newline at end of file
+    request.reply(response.statusCode, utility::conversions::to_string_t(response.message));
+    if (logger != nullptr) {
+        LogEntry entry;
+        entry.endpoint = endpointName;
+        entry.parameters = response.requestString;
+        entry.result = response.logMessage.empty() ? response.message : response.logMessage;
+        entry.statusCode = response.statusCode;
+        entry.target = response.target;
+        entry.r = response.r;
+        entry.g = response.g;
+        entry.b = response.b;
+        entry.latencyUs = response.latencyUs;
+        logger->logRequest(entry);
+    }
+}
+
+/**
+ * A static member function for RequestHandler that parses a set_rgb object.
+ * @param jsonData the parsed body of a set_rgb request, or a single object of a set_rgb_batch request.
+ * @return returns the parsed RGBCommand.
+ * @throws std::exception when the object was not a set_rgb object.
+ */
+RGBCommand RequestHandler::parseCommand(const json& jsonData) {
+    string deviceType = jsonData.at("DeviceType");
+
+    RGBCommand command;
+    command.deviceType = (DeviceType) Misc::convertDeviceType(deviceType);
+    command.r = jsonData.at("r");
+    command.g = jsonData.at("g");
+    command.b = jsonData.at("b");
+    return command;
+}
+
+/**
+ * A static member function for RequestHandler that parses the body of set_rgb_batch requests.
+ * The body is a json array of objects that look like the body of set_rgb requests.
+ * @param jsonString the body of the request.
+ * @return returns a vector of RGBCommand, one for each object in the array.
+ * @throws std::exception when the body was not a json array of set_rgb objects.
+ */
+vector<RGBCommand> RequestHandler::parseBatch(const string& jsonString) {
+    auto jsonData = json::parse(jsonString);
+    if (!jsonData.is_array())
+        throw std::invalid_argument("set_rgb_batch expects an array");
+
+    vector<RGBCommand> commands;
+    commands.reserve(jsonData.size());
+    for (auto const& x : jsonData)
+        commands.push_back(RequestHandler::parseCommand(x));
+    return commands;
+}
+
+/**
+ * A static member function for RequestHandler that parses the body of animation upload requests.
+ * The body is a json object of {"DeviceType", "device", "frames"}, where frames is an array of frames and each frame
+ * is an array of {"id", "r", "g", "b"} objects like the leds of set_leds.
+ * @param jsonString the body of the request.
+ * @return returns the parsed AnimationCommand.
+ * @throws std::exception when the body was not in the format above.
+ */
+AnimationCommand RequestHandler::parseAnimation(const string& jsonString) {
+    auto jsonData = json::parse(jsonString);
+    string deviceType = jsonData.at("DeviceType");
+
+    AnimationCommand command;
+    command.deviceType = (DeviceType) Misc::convertDeviceType(deviceType);
+    command.devicePosition = jsonData.at("device");
+    for (auto const& x : jsonData.at("frames")) {
+        vector<LedColor> frame;
+        for (auto const& y : x)
+            frame.push_back(LedColor{y.at("id"), y.at("r"), y.at("g"), y.at("b")});
+        command.frames.push_back(frame);
+    }
+    return command;
+}
+
+/**
+ * A static member function for RequestHandler that finds a device by its position in its DeviceType.
+ * Devices of an SDK change when it connects, so call this on the executor of the SDK.
+ * @param sdk the pointer to AbstractSDK instance.
+ * @param deviceType the DeviceType of the device.
+ * @param devicePosition the position of the device, in the same order as get_devices shows them.
+ * @return returns the device, or nullptr if there was no such device.
+ */
+const Device* RequestHandler::findDevice(AbstractSDK* sdk, DeviceType deviceType, size_t devicePosition) {
+    auto found = sdk->devices.find(deviceType);
+    if (found == sdk->devices.end() || devicePosition >= found->second->size())
+        return nullptr;
+    return *std::next(found->second->begin(), (long) devicePosition);
+}
+
+/**
+ * A static member function for RequestHandler that parses the body of set_leds requests.
+ * The body is a json array of {"DeviceType", "device", "leds"} objects, where leds is an array of
+ * {"id", "r", "g", "b"} objects.
+ * @param jsonString the body of the request.
+ * @return returns a vector of DeviceLedCommand, one for each object in the array.
+ * @throws std::exception when the body was not in the format above.
+ */
+vector<DeviceLedCommand> RequestHandler::parseLeds(const string& jsonString) {
+    auto jsonData = json::parse(jsonString);
+    if (!jsonData.is_array())
+        throw std::invalid_argument("set_leds expects an array");
+
+    vector<DeviceLedCommand> commands;
+    for (auto const& x : jsonData) {
+        string deviceType = x.at("DeviceType");
+        DeviceLedCommand command;
+        command.deviceType = (DeviceType) Misc::convertDeviceType(deviceType);
+        command.devicePosition = x.at("device");
+        for (auto const& y : x.at("leds"))
+            command.leds.push_back(LedColor{y.at("id"), y.at("r"), y.at("g"), y.at("b")});
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+/**
+ * A static member function for RequestHandler that converts a command into a string for logging.
+ * @param command the command to convert.
+ * @return returns a string that looks like "Mouse : (255 , 255 , 0)".
+ */
+string RequestHandler::convertCommand(const RGBCommand& command) {
+    return Misc::convertDeviceType(command.deviceType) + " : (" + to_string(command.r) + " , " +
+           to_string(command.g) + " , " + to_string(command.b) + ")";
+}
+
+/**
+ * A static member function for RequestHandler that converts devices of an SDK into json.
+ * Device types without any devices are left out.
+ * @param result the devices that AbstractSDK::getDevices() returned.
+ * @return returns a json object of device names under each device type.
+ */
+json RequestHandler::convertDevices(const map<DeviceType, list<Device*>*>& result) {
+    json devicesData;
+    for (auto const& category : result) {
+        string deviceType = Misc::convertDeviceType(category.first);
+        list<Device*> devices = *category.second;
+        vector<string> deviceNameVector;
+
+        if (!devices.empty()) {
+            for (auto const& device: devices) {
+                deviceNameVector.emplace_back(device->name);
+            }
+            devicesData[deviceType] = deviceNameVector;
+        }
+    }
+    return devicesData;
+}
+
+/**
+ * A static member function for RequestHandler that checks if a batch was successful.
+ * Just like set_rgb, a command that set some RGBs counts as successful.
+ * @param results the results of a batch.
+ * @return returns true if every command was CommandSuccess or CommandSomeRGBFailed.
+ */
+bool RequestHandler::isBatchSuccessful(const vector<CommandResult>& results) {
+    for (auto const& result : results)
+        if (result != CommandSuccess && result != CommandSomeRGBFailed) return false;
+    return true;
+}
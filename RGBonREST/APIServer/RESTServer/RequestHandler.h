@@ -14,22 +14,71 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include <functional>
+#include <chrono>
+#include <stdexcept>
 
 #include "../Utils/Misc.h"
 #include "../Utils/Defines.h"
 #include "./Logger/AbstractLogger.h"
 #include "../SDKEngine/AbstractSDK.h"
 #include "../SDKEngine/SDKDefines.h"
+#include "../SDKEngine/VirtualSDK/VirtualSDK.h"
+#include "../EffectEngine/EffectEngine.h"
+#include "../Framebuffer/Framebuffer.h"
 
 using namespace web::http;
 using namespace web::http::experimental::listener;
-using std::wstring;
 using json = nlohmann::json;
 using std::transform;
 using std::vector;
 using std::to_string;
+using std::map;
+using std::list;
+using std::function;
 
 
+/**
+ * A struct that stores what a handler replies with.
+ * Handlers build this off the listener thread, and RequestHandler::reply sends it and logs it.
+ * logMessage is logged instead of message when it is not empty, so that long json responses are not logged.
+ * flushTicket is the flush that carried the colors of the request, for requests that wait for devices to ack them.
+ * target and r, g, b are the DeviceType and color of set_rgb requests, -1 for other requests, and latencyUs is how long
+ * SDKs took from when the request was queued until they were done. These are only for loggers.
+ */
+typedef struct handlerResponse {
+    status_code statusCode = status_codes::OK;
+    string message;
+    string logMessage;
+    string requestString = "None";
+    uint64_t flushTicket = 0;
+    int target = -1;
+    int r = -1;
+    int g = -1;
+    int b = -1;
+    uint64_t latencyUs = 0;
+} HandlerResponse;
+
+/**
+ * A struct that stores LEDs to set on a single device, which is one item of a set_leds request.
+ * devicePosition is the position of the device in its DeviceType, in the same order as get_devices shows them.
+ */
+typedef struct deviceLedCommand {
+    DeviceType deviceType;
+    size_t devicePosition;
+    vector<LedColor> leds;
+} DeviceLedCommand;
+
+/**
+ * A struct that stores an animation to upload to a single device.
+ * Each frame has the LEDs that change from the frame before it.
+ */
+typedef struct animationCommand {
+    DeviceType deviceType;
+    size_t devicePosition;
+    vector<vector<LedColor>> frames;
+} AnimationCommand;
+
 /**
  * A class for handling requests.
  * This class has all static member functions that can be called from RESTServer.
@@ -41,8 +90,10 @@ public:
      */
     class General {
     public:
-        static void connection(const http_request&, AbstractLogger*);
-        static void stop_server(const http_request&, AbstractLogger*);
+        static pplx::task<void> connection(const http_request&, AbstractLogger*);
+        static pplx::task<void> stop_server(const http_request&, AbstractLogger*);
+        static pplx::task<void> statistics(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+        static void logReply(AbstractLogger*, const string&, status_code);
     };
 
     /**
@@ -51,10 +102,21 @@ public:
      */
     class SDK {
     public:
-        static void connect(const http_request&, AbstractLogger*, AbstractSDK*);
-        static void disconnect(const http_request&, AbstractLogger*, AbstractSDK*);
-        static void get_device(const http_request&, AbstractLogger*, AbstractSDK*);
-        static void set_rgb(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> connect(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> disconnect(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> get_device(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> set_rgb(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> set_rgb_batch(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> set_leds(const http_request&, AbstractLogger*, AbstractSDK*);
+
+        static HandlerResponse applyConnect(AbstractSDK*);
+        static HandlerResponse applyDisconnect(AbstractSDK*);
+        static HandlerResponse applyGetDevices(AbstractSDK*);
+        static HandlerResponse applySetRGB(AbstractSDK*, const RGBCommand&);
+        static HandlerResponse applySetRGBBatch(AbstractSDK*, const vector<RGBCommand>&);
+        static HandlerResponse applySetLeds(AbstractSDK*, const vector<DeviceLedCommand>&);
+        static pplx::task<HandlerResponse> whenAcked(AbstractSDK*, const HandlerResponse&);
+        static pplx::task<HandlerResponse> dispatch(AbstractSDK*, const function<HandlerResponse()>&, int = -1);
     };
     /**
      * A class for handling sub endpoints of /all/
@@ -62,11 +124,75 @@ public:
      */
     class ALL {
     public:
-        static void connect(const http_request&, AbstractLogger*, AbstractSDK**);
-        static void disconnect(const http_request&, AbstractLogger*, AbstractSDK**);
-        static void get_device(const http_request&, AbstractLogger*, AbstractSDK**);
-        static void set_rgb(const http_request&, AbstractLogger*, AbstractSDK**);
+        static pplx::task<void> connect(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+        static pplx::task<void> disconnect(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+        static pplx::task<void> get_device(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+        static pplx::task<void> set_rgb(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+        static pplx::task<void> set_rgb_batch(const http_request&, AbstractLogger*, vector<AbstractSDK*>*);
+
+        static HandlerResponse generateResponse(const json&, int, int);
+        static pplx::task<HandlerResponse> dispatch(vector<AbstractSDK*>*, const function<HandlerResponse(AbstractSDK*)>&, bool, int);
+    };
+
+    /**
+     * A class for handling sub endpoints of /effects/
+     * For example /effects/start
+     */
+    class Effects {
+    public:
+        static pplx::task<void> start(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, EffectEngine*);
+        static pplx::task<void> stop(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, EffectEngine*);
+
+        static HandlerResponse applyStart(vector<AbstractSDK*>*, EffectEngine*, const json&);
+    };
+
+    /**
+     * A class for handling sub endpoints of /leds/
+     * For example /leds/set
+     */
+    class Leds {
+    public:
+        static pplx::task<void> layout(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, Framebuffer*);
+        static pplx::task<void> set(const http_request&, AbstractLogger*, Framebuffer*);
+
+        static HandlerResponse applySet(Framebuffer*, const json&);
+    };
+
+    /**
+     * A class for handling sub endpoints of /sdk/animation/
+     * For example /razer/animation/upload
+     */
+    class Animation {
+    public:
+        static pplx::task<void> upload(const http_request&, AbstractLogger*, AbstractSDK*);
+        static pplx::task<void> play(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, int, EffectEngine*);
+        static pplx::task<void> stop(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, int, EffectEngine*);
+        static pplx::task<void> remove(const http_request&, AbstractLogger*, vector<AbstractSDK*>*, int, EffectEngine*);
+
+        static HandlerResponse applyAnimation(AbstractSDK*, const string&, const function<string()>&);
     };
+
+    /**
+     * A class for handling sub endpoints of /virtual/
+     * For example /virtual/frames
+     */
+    class Virtual {
+    public:
+        static pplx::task<void> frames(const http_request&, AbstractLogger*, VirtualSDK*);
+
+        static HandlerResponse applyFrames(VirtualSDK*);
+    };
+
+    static void reply(const http_request&, AbstractLogger*, const string&, const pplx::task<HandlerResponse>&);
+    static RGBCommand parseCommand(const json&);
+    static vector<RGBCommand> parseBatch(const string&);
+    static vector<DeviceLedCommand> parseLeds(const string&);
+    static AnimationCommand parseAnimation(const string&);
+    static const Device* findDevice(AbstractSDK*, DeviceType, size_t);
+    static string convertCommand(const RGBCommand&);
+    static int convertSDKName(vector<AbstractSDK*>*, const string&);
+    static json convertDevices(const map<DeviceType, list<Device*>*>&);
+    static bool isBatchSuccessful(const vector<CommandResult>&);
 };
 
 
@@ -0,0 +1,150 @@
+//
+// @file : AbstractSDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements default member functions for class AbstractSDK
+//
+
+#include "AbstractSDK.h"
+
+
+/**
+ * A member function for class AbstractSDK that sets RGB values for several device types at once.
+ * This default implementation just calls setRGB for each command. SDKs that can buffer writes and apply them at
+ * once should override this.
+ * @param commands the commands to apply, in order.
+ * @return returns a CommandResult for each command, in the same order as commands.
+ */
+vector<CommandResult> AbstractSDK::setRGBBatch(const vector<RGBCommand>& commands) {
+    vector<CommandResult> results;
+    for (auto const& command : commands) {
+        try {
+            this->setRGB(command.deviceType, command.r, command.g, command.b);
+            results.push_back(CommandSuccess);
+        } catch (...) {
+            results.push_back(translateException(std::current_exception()));
+        }
+    }
+    return results;
+}
+
+/**
+ * A member function for class AbstractSDK that returns the ids of every LED of a device.
+ * This default implementation treats a whole device as a single LED with id 0. SDKs that can set LEDs one by one
+ * should override this together with setLedColors.
+ * @param device the device to get LEDs of.
+ * @return returns the ids of LEDs, in a stable order.
+ */
+vector<int> AbstractSDK::getLedIds(const Device* device) {
+    return vector<int>{0};
+}
+
+/**
+ * A member function for class AbstractSDK that sets colors of some LEDs of a device.
+ * This default implementation can only set a whole DeviceType, so it sets every device of the same DeviceType to the
+ * last color in leds.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with ids from getLedIds.
+ * @throws the same exceptions as setRGB.
+ */
+void AbstractSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    if (leds.empty()) return;
+    const LedColor& last = leds.back();
+    this->setRGB(device->deviceType, last.r, last.g, last.b);
+}
+
+/**
+ * A member function for class AbstractSDK that sets colors of LEDs of several devices at once.
+ * This default implementation just calls setLedColors for each device. SDKs that can buffer writes and apply them at
+ * once should override this.
+ * @param deviceLeds the devices and their LEDs to set.
+ * @throws the same exceptions as setLedColors.
+ */
+void AbstractSDK::setLedColorsBatch(const vector<DeviceLedColors>& deviceLeds) {
+    for (auto const& x : deviceLeds)
+        this->setLedColors(x.device, x.leds);
+}
+
+/**
+ * A member function for class AbstractSDK that returns the ticket of the last flush that was sent to devices.
+ * This default implementation returns 0, which means that every set function had already reached devices when it
+ * returned. SDKs that flush asynchronously should override this together with whenAcked.
+ * @return returns the ticket of the last flush, or 0 if there is nothing to wait for.
+ */
+uint64_t AbstractSDK::getFlushTicket() {
+    return 0;
+}
+
+/**
+ * A member function for class AbstractSDK that returns a task that is done when devices acknowledged a flush.
+ * Nothing waits for the flush, so this can be called from any thread. This default implementation returns a task that
+ * is already done, since flushes are synchronous unless an SDK overrides this.
+ * @param ticket the ticket from getFlushTicket.
+ * @return returns a task of true if devices acknowledged the flush, false if it failed or was not acknowledged in time.
+ */
+pplx::task<bool> AbstractSDK::whenAcked(uint64_t ticket) {
+    return pplx::task_from_result(true);
+}
+
+/**
+ * A member function for class AbstractSDK that returns counters that are specific to an SDK.
+ * These are shown by /general/statistics/ next to the counters of the executor of the SDK.
+ * @return returns name -> value of every counter. This default implementation has no counters.
+ */
+map<string, uint64_t> AbstractSDK::getStatistics() {
+    return map<string, uint64_t>();
+}
+
+/**
+ * A member function for class AbstractSDK that prepares an animation, so that its frames can be shown later without
+ * building them again. SDKs that can keep prepared frames should override this together with showAnimationFrame and
+ * deleteAnimation.
+ * @param device the device to play the animation on.
+ * @param frames the LEDs to set in each frame, with ids from getLedIds.
+ * @return returns the id of the animation.
+ * @throws SDKExceptions::AnimationNotSupported: always, since this default implementation cannot prepare frames.
+ */
+int AbstractSDK::uploadAnimation(const Device* device, const vector<vector<LedColor>>& frames) {
+    throw SDKExceptions::AnimationNotSupported();
+}
+
+/**
+ * A member function for class AbstractSDK that shows a frame of an animation from uploadAnimation.
+ * @param animationId the id of the animation.
+ * @param frame the index of the frame. Indices past the last frame wrap around, so animations loop.
+ * @throws SDKExceptions::AnimationNotSupported: always, since this default implementation cannot prepare frames.
+ */
+void AbstractSDK::showAnimationFrame(int animationId, size_t frame) {
+    throw SDKExceptions::AnimationNotSupported();
+}
+
+/**
+ * A member function for class AbstractSDK that deletes an animation from uploadAnimation.
+ * @param animationId the id of the animation.
+ * @throws SDKExceptions::AnimationNotSupported: always, since this default implementation cannot prepare frames.
+ */
+void AbstractSDK::deleteAnimation(int animationId) {
+    throw SDKExceptions::AnimationNotSupported();
+}
+
+/**
+ * A static member function for class AbstractSDK that translates an exception thrown by setRGB into CommandResult.
+ * @param exceptionPointer the exception to translate.
+ * @return returns the CommandResult that matches the exception.
+ */
+CommandResult AbstractSDK::translateException(const std::exception_ptr& exceptionPointer) {
+    try {
+        std::rethrow_exception(exceptionPointer);
+    } catch (const SDKExceptions::SomeRGBFailed &e) {
+        return CommandSomeRGBFailed;
+    } catch (const SDKExceptions::AllRGBFailed &e) {
+        return CommandAllRGBFailed;
+    } catch (const SDKExceptions::InvalidDeviceType &e) {
+        return CommandInvalidDeviceType;
+    } catch (const SDKExceptions::InvalidRGBValue &e) {
+        return CommandInvalidRGBValue;
+    } catch (const SDKExceptions::SDKNotConnected &e) {
+        return CommandSDKNotConnected;
+    } catch (...) {
+        return CommandUnexpectedError;
+    }
+}
@@ -14,8 +14,11 @@
 #include <exception>
 #include <map>
 #include <list>
+#include <vector>
+#include <pplx/pplxtasks.h>
 
 #include "SDKDefines.h"
+#include "SDKExecutor.h"
 
 using std::exception;
 using std::string;
@@ -23,6 +26,7 @@ using std::cout;
 using std::endl;
 using std::map;
 using std::list;
+using std::vector;
 
 
 /**
@@ -33,11 +37,25 @@ public:
     string sdkName;
     bool isConnected;
     map<DeviceType, list<Device*>*> devices;
+    SDKExecutor* executor = nullptr; // every call into this SDK from the servers runs on this executor.
 
+    virtual ~AbstractSDK() = default; // SDKs are deleted through AbstractSDK*, so their own destructors must run.
     virtual void connect() = 0;
     virtual void disconnect() = 0;
     virtual void setRGB(DeviceType, int, int, int) = 0;
     virtual map<DeviceType, list<Device*>*> getDevices() = 0;
+    virtual vector<CommandResult> setRGBBatch(const vector<RGBCommand>&);
+    virtual vector<int> getLedIds(const Device*);
+    virtual void setLedColors(const Device*, const vector<LedColor>&);
+    virtual void setLedColorsBatch(const vector<DeviceLedColors>&);
+    virtual uint64_t getFlushTicket();
+    virtual pplx::task<bool> whenAcked(uint64_t);
+    virtual map<string, uint64_t> getStatistics();
+    virtual int uploadAnimation(const Device*, const vector<vector<LedColor>>&);
+    virtual void showAnimationFrame(int, size_t);
+    virtual void deleteAnimation(int);
+
+    static CommandResult translateException(const std::exception_ptr&);
 };
 
 
@@ -9,17 +9,39 @@
 /**
  * A constructor member function for class CorsairSDK.
  * This sets default values to member variable for this instance.
+ * @param argMaxFlushesInFlight how many flushes may wait for iCUE at once. 0 waits for every flush like before.
  */
-CorsairSDK::CorsairSDK() {
+CorsairSDK::CorsairSDK(unsigned int argMaxFlushesInFlight) {
     this->sdkName = "Corsair";
     this->isConnected = false;
+    this->maxFlushesInFlight = argMaxFlushesInFlight;
+    if (this->maxFlushesInFlight > 0)
+        this->ackTimeoutThread = new thread(&CorsairSDK::ackTimeoutLoop, this);
 }
 
 /**
  * A destructor member function for class CorsairSDK.
- * This deletes all Device objects that were generated by setAllDeviceInfo.
+ * This waits for flushes that iCUE did not answer yet, since their callbacks point to this instance. Requests that
+ * still wait for a flush are answered as not acknowledged.
+ * Then this deletes all Device objects that were generated by setAllDeviceInfo.
  */
 CorsairSDK::~CorsairSDK() {
+    unique_lock<mutex> lock(this->flushMutex);
+    this->flushCondition.wait_for(lock, std::chrono::milliseconds(CORSAIR_FLUSH_ACK_TIMEOUT_MS),
+                                  [this] { return this->pendingFlushes.empty(); });
+    this->isStopping = true;
+    map<uint64_t, CorsairAckWaiter> waiters;
+    waiters.swap(this->ackWaiters);
+    lock.unlock();
+    this->flushCondition.notify_all();
+
+    if (this->ackTimeoutThread != nullptr) {
+        this->ackTimeoutThread->join();
+        delete this->ackTimeoutThread;
+    }
+    for (auto const& x : waiters)
+        x.second.event.set(false);
+
     for (auto const& x : this->devices) { // For every device types
         list<Device*>* deviceList = x.second; // Grab device list
         for (auto const& y : *deviceList) {
@@ -43,9 +65,10 @@ void CorsairSDK::connect() {
         CorsairPerformProtocolHandshake(); // Perform handshake with SDK
         switch (CorsairGetLastError()) {
             case CorsairError::CE_Success: // If CorsairPerformProtocolHandshake was successful, then request control.
-                this->isConnected = CorsairRequestControl(CAM_ExclusiveLightingControl);
-                if (this->isConnected) { // If connection was successful, set all devices
+                if (CorsairRequestControl(CAM_ExclusiveLightingControl)) { // If connection was successful, set all devices
                     this->setAllDeviceInfo();
+                    this->cacheLedTopology();
+                    this->isConnected = true; // only after devices and LEDs are known
                     return;
                 } else // If connection was not successful, throw exception
                     throw SDKExceptions::SDKConnectionFailed();
@@ -186,6 +209,191 @@ void CorsairSDK::setAllDeviceInfo() {
     this->devices.insert(pair<DeviceType, list<Device*>*>(DeviceType::RAM, MemoryModuleList));
 }
 
+/**
+ * A member function that asks the SDK which LEDs every device really has and caches them.
+ * Each device gets a buffer with one CorsairLedColor per LED, so setting RGB only rewrites colors in that buffer
+ * instead of building a table of every LED id that a device type might have.
+ */
+void CorsairSDK::cacheLedTopology() {
+    this->ledBuffers.clear();
+    for (auto const& category : this->devices) {
+        for (auto const& x : *category.second) {
+            vector<CorsairLedColor>& ledValues = this->ledBuffers[x->deviceIndex];
+            CorsairLedPositions* positions = CorsairGetLedPositionsByDeviceIndex(x->deviceIndex);
+            if (positions == nullptr) continue; // device without LEDs
+
+            ledValues.reserve(positions->numberOfLed);
+            for (int i = 0 ; i < positions->numberOfLed ; i++) {
+                CorsairLedColor value;
+                value.ledId = positions->pLedPosition[i].ledId;
+                value.r = 0;
+                value.g = 0;
+                value.b = 0;
+                ledValues.push_back(value);
+            }
+        }
+    }
+}
+
+/**
+ * A member function for class CorsairSDK that sends the SDK buffer to devices.
+ * With maxFlushesInFlight above 0, this hands the buffer to CorsairSetLedsColorsFlushBufferAsync and returns without
+ * waiting for devices, so the next colors can be buffered while iCUE is still sending these.
+ * At most maxFlushesInFlight flushes wait for iCUE at once. When all of them are waiting, this waits for one to finish.
+ * Whether devices acknowledged a flush is counted in getStatistics, and requests can wait for it with whenAcked.
+ * @return returns 1 if the flush was sent (or was acknowledged, for synchronous flushes), 0 if it failed.
+ */
+int CorsairSDK::flushBuffer() {
+    if (this->maxFlushesInFlight == 0) // synchronous flush
+        return CorsairSetLedsColorsFlushBuffer();
+
+    unique_lock<mutex> lock(this->flushMutex);
+    bool hasSlot = this->flushCondition.wait_for(lock, std::chrono::milliseconds(CORSAIR_FLUSH_ACK_TIMEOUT_MS),
+                                                 [this] { return this->pendingFlushes.size() < this->maxFlushesInFlight; });
+    if (!hasSlot) { // iCUE stopped answering, so do not pile up more flushes.
+        this->failedFlushCount++;
+        return 0;
+    }
+
+    uint64_t ticket = ++this->lastFlushTicket;
+    this->pendingFlushes.insert(ticket);
+    lock.unlock(); // iCUE may call onFlushDone before CorsairSetLedsColorsFlushBufferAsync returns.
+
+    auto* context = new CorsairFlushContext{this, ticket};
+    if (CorsairSetLedsColorsFlushBufferAsync(CorsairSDK::onFlushDone, context))
+        return 1;
+
+    delete context; // iCUE refused the flush, so the callback never comes.
+    this->finishFlush(ticket, false);
+    return 0;
+}
+
+/**
+ * A member function for class CorsairSDK that records that a flush was answered.
+ * Requests that wait for the flush are answered here, on the thread that answered it.
+ * @param ticket the ticket of the flush.
+ * @param result true if devices acknowledged the flush, false if it failed.
+ */
+void CorsairSDK::finishFlush(uint64_t ticket, bool result) {
+    bool hasWaiter = false;
+    CorsairAckWaiter waiter;
+    {
+        lock_guard<mutex> lock(this->flushMutex);
+        this->pendingFlushes.erase(ticket);
+        if (!result) {
+            this->failedFlushes.insert(ticket);
+            if (this->failedFlushes.size() > CORSAIR_FLUSH_FAIL_HISTORY)
+                this->failedFlushes.erase(this->failedFlushes.begin());
+        }
+        auto found = this->ackWaiters.find(ticket);
+        if (found != this->ackWaiters.end()) {
+            waiter = found->second;
+            this->ackWaiters.erase(found);
+            hasWaiter = true;
+        }
+    }
+
+    if (result) this->acknowledgedFlushCount++;
+    else this->failedFlushCount++;
+    this->flushCondition.notify_all();
+    if (hasWaiter) waiter.event.set(result); // continuations are scheduled, not run here
+}
+
+/**
+ * A member function for class CorsairSDK that runs in the ack timeout thread.
+ * This answers requests that waited CORSAIR_FLUSH_ACK_TIMEOUT_MS for a flush as not acknowledged. The flush itself
+ * stays pending, since iCUE may still call onFlushDone for it.
+ */
+void CorsairSDK::ackTimeoutLoop() {
+    unique_lock<mutex> lock(this->flushMutex);
+    while (!this->isStopping) {
+        auto now = std::chrono::steady_clock::now();
+        auto wakeUp = now + std::chrono::milliseconds(CORSAIR_FLUSH_ACK_TIMEOUT_MS);
+        vector<CorsairAckWaiter> expired;
+        for (auto it = this->ackWaiters.begin() ; it != this->ackWaiters.end() ;) {
+            if (it->second.deadline <= now) {
+                expired.push_back(it->second);
+                it = this->ackWaiters.erase(it);
+            } else {
+                wakeUp = it->second.deadline < wakeUp ? it->second.deadline : wakeUp;
+                it++;
+            }
+        }
+
+        if (!expired.empty()) {
+            lock.unlock();
+            for (auto const& x : expired)
+                x.event.set(false);
+            lock.lock();
+            continue; // waiters may have been added meanwhile
+        }
+        this->flushCondition.wait_until(lock, wakeUp);
+    }
+}
+
+/**
+ * A static member function for class CorsairSDK that is called by iCUE when an asynchronous flush was answered.
+ * This runs on a thread of iCUE, so it only records the result.
+ * @param context the CorsairFlushContext that was handed to CorsairSetLedsColorsFlushBufferAsync.
+ * @param result true if devices acknowledged the flush.
+ * @param error the error of the flush. Not used since result already tells whether it failed.
+ */
+void CorsairSDK::onFlushDone(void* context, bool result, CorsairError error) {
+    auto* flushContext = (CorsairFlushContext*) context;
+    flushContext->sdk->finishFlush(flushContext->ticket, result);
+    delete flushContext;
+}
+
+/**
+ * A member function for class CorsairSDK that returns the ticket of the last flush that was sent to devices.
+ * Call this right after a set function, on the executor, to get the flush that carried its colors.
+ * @return returns the ticket of the last flush, or 0 if flushes are synchronous.
+ */
+uint64_t CorsairSDK::getFlushTicket() {
+    lock_guard<mutex> lock(this->flushMutex);
+    return this->lastFlushTicket;
+}
+
+/**
+ * A member function for class CorsairSDK that returns a task that is done when iCUE answered a flush.
+ * Nothing blocks: the task is done by finishFlush, or by the ack timeout thread after CORSAIR_FLUSH_ACK_TIMEOUT_MS.
+ * @param ticket the ticket from getFlushTicket.
+ * @return returns a task of true if devices acknowledged the flush, false if it failed or was not answered in time.
+ */
+pplx::task<bool> CorsairSDK::whenAcked(uint64_t ticket) {
+    if (ticket == 0) return pplx::task_from_result(true); // nothing was flushed asynchronously
+
+    lock_guard<mutex> lock(this->flushMutex);
+    if (this->pendingFlushes.count(ticket) == 0) // already answered
+        return pplx::task_from_result(this->failedFlushes.count(ticket) == 0);
+    if (this->isStopping)
+        return pplx::task_from_result(false);
+
+    auto found = this->ackWaiters.find(ticket);
+    if (found == this->ackWaiters.end()) {
+        CorsairAckWaiter waiter;
+        waiter.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CORSAIR_FLUSH_ACK_TIMEOUT_MS);
+        found = this->ackWaiters.emplace(ticket, waiter).first;
+        this->flushCondition.notify_all(); // the ack timeout thread may need to wake up earlier
+    }
+    return pplx::create_task(found->second.event);
+}
+
+/**
+ * A member function for class CorsairSDK that returns counters of asynchronous flushes.
+ * @return returns flushes_in_flight, flushes_acknowledged and flushes_failed.
+ */
+map<string, uint64_t> CorsairSDK::getStatistics() {
+    map<string, uint64_t> statistics;
+    {
+        lock_guard<mutex> lock(this->flushMutex);
+        statistics["flushes_in_flight"] = this->pendingFlushes.size();
+    }
+    statistics["flushes_acknowledged"] = this->acknowledgedFlushCount.load();
+    statistics["flushes_failed"] = this->failedFlushCount.load();
+    return statistics;
+}
+
 /**
  * A member function that translates device type from CorsairDeviceType to DeviceType that is declared in Defines.h
  * @param toTranslate the CorsairDeviceType type needs to be translated into DeviceType.
@@ -234,478 +442,263 @@ DeviceType CorsairSDK::translateDeviceType(const CorsairDeviceType& toTranslate)
  */
 void CorsairSDK::setRGB(DeviceType argDeviceType, int r, int g, int b) {
     if (this->isConnected) {
-        if ((((r >= 0) && (r <= 255)) && ((g >= 0) && (g <= 255))) && ((b >= 0) && (b <= 255))) {
-            switch (argDeviceType) {
-                case DeviceType::Mouse:
-                    this->setMouseRgb(r, g, b);
-                    break;
-                case DeviceType::Headset:
-                    this->setHeadsetRgb(r, g, b);
-                    break;
-                case DeviceType::Keyboard:
-                    this->setKeyboardRgb(r, g, b);
-                    break;
-                case DeviceType::Mousemat:
-                    this->setMouseMatRgb(r, g, b);
-                    break;
-                case DeviceType::HeadsetStand:
-                    this->setHeadsetStandRgb(r, g, b);
-                    break;
-                case DeviceType::GPU:
-                    this->setGPURgb(r, g, b);
-                    break;
-                case DeviceType::ALL:
-                    this->setAllRgb(r, g, b);
-                    break;
-                case DeviceType::Mainboard:
-                    this->setMotherboardRgb(r, g, b);
-                    break;
-                case DeviceType::Cooler:
-                    this->setCoolerRgb(r, g, b);
-                    break;
-                case DeviceType::RAM:
-                    this->setMemoryModuleRgb(r, g, b);
-                    break;
-                case DeviceType::ETC:
-                case DeviceType::UnknownDevice:
-                case DeviceType::Microphone:
-                    this->setETCRgb(r, g, b);
-                    break;
+        if (isValidRgb(r, g, b)) {
+            vector<DeviceType> deviceTypes;
+            if (!resolveDeviceTypes(argDeviceType, deviceTypes))
+                throw SDKExceptions::InvalidDeviceType();
+
+            CommandResult result;
+            if (argDeviceType == DeviceType::ALL)
+                result = this->setAllRgb(r, g, b);
+            else
+                result = this->setDeviceTypeRgb(deviceTypes.front(), r, g, b);
+
+            switch (result) {
+                case CommandSuccess:
+                    return;
+                case CommandSomeRGBFailed:
+                    throw SDKExceptions::SomeRGBFailed();
                 default:
-                    throw SDKExceptions::InvalidDeviceType();
+                    throw SDKExceptions::AllRGBFailed();
             }
         } else throw SDKExceptions::InvalidRGBValue();
     } else throw SDKExceptions::SDKNotConnected();
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into mice.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * A member function for class CorsairSDK that sets RGB values for several device types with a single flush.
+ * Every command is written into the SDK buffer first, then the buffer is flushed once.
+ * If several commands target the same device type, the last one wins.
+ * @param commands the commands to apply, in order.
+ * @return returns a CommandResult for each command, in the same order as commands.
  */
-int CorsairSDK::setMouseRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[20];
-    for (auto& value: ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-    for (int i = 0; i < 4; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(148 + i);
-    for (int i = 0; i < 2; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(189 + i);
-    for (int i = 0; i < 14; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(1694 + i);
-
-    int resultSum = 0;
-
-    list<Device*> mouseList = *this->devices.at(DeviceType::Mouse);
-    for (auto const& x : mouseList) {
-        int deviceIndex = x->deviceIndex;
-
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
+vector<CommandResult> CorsairSDK::setRGBBatch(const vector<RGBCommand>& commands) {
+    vector<CommandResult> results(commands.size(), CommandSuccess);
+    if (!this->isConnected) {
+        std::fill(results.begin(), results.end(), CommandSDKNotConnected);
+        return results;
     }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == mouseList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < mouseList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
-}
 
-/**
- * A member function for class CorsairSDK that sets RGB values into keyboards.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
- */
-int CorsairSDK::setKeyboardRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[199];
-    for (auto & ledValue : ledValues) {
-        ledValue.r = r;
-        ledValue.g = g;
-        ledValue.b = b;
+    vector<int> successCounts(commands.size(), 0);
+    vector<int> attemptCounts(commands.size(), 0);
+    for (size_t i = 0 ; i < commands.size() ; i++) { // buffer everything first
+        const RGBCommand& command = commands[i];
+        vector<DeviceType> deviceTypes;
+
+        if (!isValidRgb(command.r, command.g, command.b))
+            results[i] = CommandInvalidRGBValue;
+        else if (!resolveDeviceTypes(command.deviceType, deviceTypes))
+            results[i] = CommandInvalidDeviceType;
+        else {
+            for (auto const& deviceType : deviceTypes)
+                successCounts[i] += this->bufferRgb(deviceType, command.r, command.g, command.b, attemptCounts[i]);
+        }
     }
 
-    int ledCount = 0;
-
-    for(int i = 1 ; i < 148 ; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(i);
-    ledValues[ledCount++].ledId = static_cast<CorsairLedId>(154);
-    for(int i = 170 ; i < 18 ; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(i);
-
-    int resultSum = 0;
-    list<Device*> keyboardList = *this->devices.at(DeviceType::Keyboard);
-
-    for (auto const& x : keyboardList) {
-        int deviceIndex = x->deviceIndex;
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
+    int flushResult = this->flushBuffer(); // then flush once for all of them
+    for (size_t i = 0 ; i < commands.size() ; i++) {
+        if (results[i] == CommandSuccess)
+            results[i] = evaluateResult(successCounts[i] + flushResult, attemptCounts[i] + 1);
     }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == keyboardList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < keyboardList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+    return results;
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into headset.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * A member function for class CorsairSDK that returns the ids of every LED of a device.
+ * @param device the device to get LEDs of.
+ * @return returns CorsairLedId of every LED of the device, in the order that the SDK reported them at connect.
+ * @throws SDKExceptions::SDKNotConnected: When SDK was not connected before.
  */
-int CorsairSDK::setHeadsetRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[2];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
+vector<int> CorsairSDK::getLedIds(const Device* device) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
 
-    ledValues[0].ledId = CLH_LeftLogo;
-    ledValues[1].ledId = CLH_RightLogo;
+    vector<int> ledIds;
+    auto found = this->ledBuffers.find(device->deviceIndex);
+    if (found == this->ledBuffers.end()) return ledIds;
 
-    int resultSum = 0;
-    list<Device*> headsetList = *this->devices.at(DeviceType::Headset);
-
-    for (auto const& x : headsetList) {
-        int deviceIndex = x->deviceIndex;
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, 2, ledValues);
-    }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == headsetList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < headsetList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+    for (auto const& x : found->second)
+        ledIds.push_back(x.ledId);
+    return ledIds;
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into mouse mats.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * A member function for class CorsairSDK that sets colors of some LEDs of a device.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with CorsairLedId as ids.
+ * @throws the same exceptions as setLedColorsBatch.
  */
-int CorsairSDK::setMouseMatRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[15];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 15; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(155 + i);
-
-    int resultSum = 0;
-    list<Device*> mouseMatList = *this->devices.at(DeviceType::Mousemat);
-
-    for (auto const& x : mouseMatList) {
-        int deviceIndex = x->deviceIndex;
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
-    }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == mouseMatList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < mouseMatList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+void CorsairSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    this->setLedColorsBatch(vector<DeviceLedColors>{DeviceLedColors{device, leds}});
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into headset stands.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
+ * A member function for class CorsairSDK that sets colors of LEDs of several devices with a single flush.
+ * Only the given LEDs are written, so the rest of each device keeps its color.
+ * LEDs of each device are written with one CorsairSetLedsColorsBufferByDeviceIndex, then
+ * CorsairSetLedsColorsFlushBuffer is called once.
+ * @param deviceLeds the devices and their LEDs to set.
+ * @throws SDKExceptions::SDKNotConnected: When SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: When a color was not from 0 to 255. Nothing is written in this case.
  * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
  * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
  */
-int CorsairSDK::setHeadsetStandRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[9];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 9; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(191 + i);
+void CorsairSDK::setLedColorsBatch(const vector<DeviceLedColors>& deviceLeds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    for (auto const& x : deviceLeds)
+        for (auto const& y : x.leds)
+            if (!isValidRgb(y.r, y.g, y.b)) throw SDKExceptions::InvalidRGBValue();
 
     int resultSum = 0;
-    list<Device*> headsetStandList = *this->devices.at(DeviceType::HeadsetStand);
-
-    for (auto const& x : headsetStandList) {
-        int deviceIndex = x->deviceIndex;
-
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
+    int attemptCount = 0;
+    vector<CorsairLedColor> ledValues;
+    for (auto const& x : deviceLeds) {
+        if (x.leds.empty()) continue;
+
+        ledValues.clear();
+        for (auto const& y : x.leds) {
+            CorsairLedColor value;
+            value.ledId = static_cast<CorsairLedId>(y.ledId);
+            value.r = y.r;
+            value.g = y.g;
+            value.b = y.b;
+            ledValues.push_back(value);
+        }
+        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(x.device->deviceIndex, (int) ledValues.size(), ledValues.data());
+        attemptCount++;
+    }
+    if (attemptCount == 0) return; // nothing to flush
+
+    resultSum += this->flushBuffer();
+    switch (evaluateResult(resultSum, attemptCount + 1)) {
+        case CommandSuccess:
+            return;
+        case CommandSomeRGBFailed:
+            throw SDKExceptions::SomeRGBFailed();
+        default:
+            throw SDKExceptions::AllRGBFailed();
     }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == headsetStandList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < headsetStandList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into coolers.
- * @param argDeviceType the device type.
+ * A static member function for class CorsairSDK that checks if RGB values are in range.
  * @param r the r value
  * @param g the g value
  * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * @return returns true if all values are from 0 to 255.
  */
-int CorsairSDK::setCoolerRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[1050];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 300; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(200 + i);
-
-    for (int i = 0; i < 750; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(612 + i);
-
-    int resultSum = 0;
-    list<Device*> coolerList = *this->devices.at(DeviceType::Cooler);
-
-    for (auto const& x : coolerList) {
-        int deviceIndex = x->deviceIndex;
-
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
-    }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == coolerList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < coolerList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+bool CorsairSDK::isValidRgb(int r, int g, int b) {
+    return (((r >= 0) && (r <= 255)) && ((g >= 0) && (g <= 255))) && ((b >= 0) && (b <= 255));
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into memory modules.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * A static member function for class CorsairSDK that resolves a requested DeviceType into the device lists it covers.
+ * ETC, UnknownDevice and Microphone are all stored in the ETC list. ALL covers every list.
+ * @param argDeviceType the requested device type.
+ * @param deviceTypes the resolved device types are stored here.
+ * @return returns false if argDeviceType is not a valid device type.
  */
-int CorsairSDK::setMemoryModuleRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[12];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-    for (int i = 0; i < 12; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(600 + i);
-
-    int resultSum = 0;
-    list<Device*> memoryModuleList = *this->devices.at(DeviceType::RAM);
-
-    for (auto const& x : memoryModuleList) {
-        int deviceIndex = x->deviceIndex;
-
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
+bool CorsairSDK::resolveDeviceTypes(DeviceType argDeviceType, vector<DeviceType>& deviceTypes) {
+    switch (argDeviceType) {
+        case DeviceType::Mouse:
+        case DeviceType::Headset:
+        case DeviceType::Keyboard:
+        case DeviceType::Mousemat:
+        case DeviceType::HeadsetStand:
+        case DeviceType::GPU:
+        case DeviceType::Mainboard:
+        case DeviceType::Cooler:
+        case DeviceType::RAM:
+            deviceTypes.push_back(argDeviceType);
+            return true;
+        case DeviceType::ETC:
+        case DeviceType::UnknownDevice:
+        case DeviceType::Microphone:
+            deviceTypes.push_back(DeviceType::ETC);
+            return true;
+        case DeviceType::ALL:
+            deviceTypes.insert(deviceTypes.end(), {DeviceType::Mouse, DeviceType::Keyboard, DeviceType::Headset,
+                                                   DeviceType::HeadsetStand, DeviceType::RAM, DeviceType::GPU,
+                                                   DeviceType::ETC, DeviceType::Mousemat, DeviceType::Mainboard,
+                                                   DeviceType::Cooler});
+            return true;
+        default:
+            return false;
     }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == memoryModuleList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < memoryModuleList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into motherboards.
- * @param argDeviceType the device type.
+ * A member function for class CorsairSDK that writes RGB values of a device type into the SDK buffer.
+ * Every device gets exactly the LEDs that cacheLedTopology found for it.
+ * This does not flush, so nothing is shown on devices until flushBuffer is called.
+ * @param argDeviceType the device type, which must be one of the device types that resolveDeviceTypes returns.
  * @param r the r value
  * @param g the g value
  * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * @param attemptCount the number of devices that were written is added to this.
+ * @return returns the number of devices that were successfully written into the buffer.
  */
-int CorsairSDK::setMotherboardRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[100];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 100; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(1362 + i);
-
+int CorsairSDK::bufferRgb(DeviceType argDeviceType, int r, int g, int b, int& attemptCount) {
     int resultSum = 0;
-    list<Device*> mainboardList = *this->devices.at(DeviceType::Mainboard);
-
-    for (auto const& x : mainboardList) {
+    for (auto const& x : *this->devices.at(argDeviceType)) {
         int deviceIndex = x->deviceIndex;
+        vector<CorsairLedColor>& ledValues = this->ledBuffers[deviceIndex];
+        if (ledValues.empty()) continue; // device without LEDs
 
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
+        for (auto& y : ledValues) { // ids are already there, so only rewrite colors
+            y.r = r;
+            y.g = g;
+            y.b = b;
+        }
+        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, (int) ledValues.size(), ledValues.data());
+        attemptCount++;
     }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == mainboardList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < mainboardList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+    return resultSum;
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into gpus.
- * @param argDeviceType the device type.
- * @param r the r value
- * @param g the g value
- * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * A static member function for class CorsairSDK that evaluates how many SDK calls succeeded.
+ * @param successCount the number of SDK calls that returned true.
+ * @param attemptCount the number of SDK calls.
+ * @return returns CommandSuccess, CommandSomeRGBFailed or CommandAllRGBFailed.
  */
-int CorsairSDK::setGPURgb(int r, int g, int b) {
-    CorsairLedColor ledValues[50];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 50; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(1462 + i);
-
-    int resultSum = 0;
-    list<Device*> gpuList = *this->devices.at(DeviceType::GPU);
-
-    for (auto const& x : gpuList) {
-        int deviceIndex = x->deviceIndex;
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
-    }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == gpuList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < gpuList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+CommandResult CorsairSDK::evaluateResult(int successCount, int attemptCount) {
+    if (successCount == attemptCount) return CommandSuccess; // When all results were true, it means success
+    else if ((successCount < attemptCount) && (successCount > 0)) return CommandSomeRGBFailed; // When Some RGBs failed.
+    else return CommandAllRGBFailed; // When all RGBs failed.
 }
 
 /**
- * A member function for class CorsairSDK that sets RGB values into etc devices.
- * @param argDeviceType the device type.
+ * A member function for class CorsairSDK that sets RGB values into every device of a device type.
+ * @param argDeviceType the device type, which must be one of the device types that resolveDeviceTypes returns.
  * @param r the r value
  * @param g the g value
  * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * @return returns CommandSuccess, CommandSomeRGBFailed or CommandAllRGBFailed over every device of the device type.
  */
-int CorsairSDK::setETCRgb(int r, int g, int b) {
-    CorsairLedColor ledValues[250];
-    for(auto& value : ledValues) {
-        value.r = r;
-        value.g = g;
-        value.b = b;
-    }
-
-    int ledCount = 0;
-
-    for (int i = 0; i < 100; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(500 + i);
-    for (int i = 0; i < 150; i++)
-        ledValues[ledCount++].ledId = static_cast<CorsairLedId>(1544 + i);
-
-    int resultSum = 0;
-    list<Device*> etcList = *this->devices.at(DeviceType::ETC);
-
-    for (auto const& x : etcList) {
-        int deviceIndex = x->deviceIndex;
-        resultSum += CorsairSetLedsColorsBufferByDeviceIndex(deviceIndex, ledCount, ledValues);
-    }
-    resultSum += CorsairSetLedsColorsFlushBuffer();
-
-    if (resultSum == etcList.size() + 1) return 1; // When all results were true, it means success
-    else if ((resultSum < etcList.size() + 1) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
+CommandResult CorsairSDK::setDeviceTypeRgb(DeviceType argDeviceType, int r, int g, int b) {
+    int attemptCount = 0;
+    int resultSum = this->bufferRgb(argDeviceType, r, g, b, attemptCount);
+    resultSum += this->flushBuffer();
+    return evaluateResult(resultSum, attemptCount + 1);
 }
 
 /**
  * A member function for class CorsairSDK that sets RGB values into all devices.
- * @param argDeviceType the device type.
+ * Every device of every device type is written into the SDK buffer first, then the buffer is flushed once.
+ * So all devices change at the same time and iCUE is only asked for one flush.
  * @param r the r value
  * @param g the g value
  * @param b the b value
- * @throws SDKExceptions::SomeRGBFailed: When some RGBs failed to set their LED values, at the same time some did.
- * @throws SDKExceptions::AllRGBFailed When all RGBs failed to set their LED values.
- * If this member function did not throw any exceptions, it means that it had successfully set LED colors.
+ * @return returns CommandSuccess, CommandSomeRGBFailed or CommandAllRGBFailed over every device and the flush.
  */
-void CorsairSDK::setAllRgb(int r, int g, int b) {
+CommandResult CorsairSDK::setAllRgb(int r, int g, int b) {
+    vector<DeviceType> deviceTypes;
+    resolveDeviceTypes(DeviceType::ALL, deviceTypes);
+
+    int attemptCount = 0;
     int resultSum = 0;
-    resultSum += this->setMouseRgb(r, g, b);
-    resultSum += this->setKeyboardRgb(r, g, b);
-    resultSum += this->setHeadsetRgb(r, g, b);
-    resultSum += this->setHeadsetStandRgb(r, g, b);
-    resultSum += this->setMemoryModuleRgb(r, g, b);
-    resultSum += this->setGPURgb(r, g, b);
-    resultSum += this->setETCRgb(r, g, b);
-    resultSum += this->setMouseMatRgb(r, g, b);
-    resultSum += this->setMotherboardRgb(r, g, b);
-
-    if (resultSum == 9) return; // When all results were true, it means success
-    else if ((resultSum < 9) && (resultSum > 0))  // When Some RGBs failed.
-        throw SDKExceptions::SomeRGBFailed();
-    else // When all RGBs failed.
-        throw SDKExceptions::AllRGBFailed();
-}
\ No newline at end of file
+    for (auto const& deviceType : deviceTypes) // buffer every device first
+        resultSum += this->bufferRgb(deviceType, r, g, b, attemptCount);
+    resultSum += this->flushBuffer(); // then flush once for all of them
+    return evaluateResult(resultSum, attemptCount + 1);
+}
@@ -9,36 +9,93 @@
 #pragma once
 
 #include <list>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 
 #include "../AbstractSDK.h"
 #include "./includes/CUESDK.h"
+#include "../../Utils/Defines.h"
 
 using std::list;
 using std::pair;
+using std::vector;
+using std::set;
+using std::atomic;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
+using std::thread;
+
+class CorsairSDK;
+
+/**
+ * A struct that is handed to CorsairSetLedsColorsFlushBufferAsync, so that the callback knows which flush finished.
+ */
+typedef struct corsairFlushContext {
+    CorsairSDK* sdk;
+    uint64_t ticket;
+} CorsairFlushContext;
+
+/**
+ * A struct that stores a request that waits for a flush to be acknowledged.
+ * event is set by finishFlush when iCUE answers, or by the ack timeout thread once deadline passed.
+ */
+typedef struct corsairAckWaiter {
+    pplx::task_completion_event<bool> event;
+    std::chrono::steady_clock::time_point deadline;
+} CorsairAckWaiter;
 
 
 class CorsairSDK : public AbstractSDK {
 private:
-    int setMouseRgb(int, int, int);
-    int setKeyboardRgb(int, int, int);
-    int setHeadsetRgb(int, int, int);
-    int setMouseMatRgb(int, int, int);
-    int setHeadsetStandRgb(int, int, int);
-    int setCoolerRgb(int, int, int);
-    int setMotherboardRgb(int, int, int);
-    int setMemoryModuleRgb(int, int, int);
-    int setGPURgb(int, int, int);
-    int setETCRgb(int, int, int);
-    void setAllRgb(int, int, int);
+    map<int, vector<CorsairLedColor>> ledBuffers; // deviceIndex -> every LED of the device. Only colors are rewritten.
+
+    unsigned int maxFlushesInFlight; // 0 flushes synchronously.
+    mutex flushMutex;
+    condition_variable flushCondition;
+    uint64_t lastFlushTicket = 0;
+    set<uint64_t> pendingFlushes; // tickets that iCUE did not answer yet.
+    set<uint64_t> failedFlushes; // the latest CORSAIR_FLUSH_FAIL_HISTORY tickets that failed.
+    map<uint64_t, CorsairAckWaiter> ackWaiters; // ticket -> requests that wait for it, answered or timed out once.
+    thread* ackTimeoutThread = nullptr;
+    bool isStopping = false;
+    atomic<uint64_t> acknowledgedFlushCount{0};
+    atomic<uint64_t> failedFlushCount{0};
+
+    int bufferRgb(DeviceType, int, int, int, int&);
+    CommandResult setDeviceTypeRgb(DeviceType, int, int, int);
+    CommandResult setAllRgb(int, int, int);
     void setAllDeviceInfo();
+    void cacheLedTopology();
+    int flushBuffer();
+    void finishFlush(uint64_t, bool);
+    void ackTimeoutLoop();
+    static void onFlushDone(void*, bool, CorsairError);
+    static bool isValidRgb(int, int, int);
+    static bool resolveDeviceTypes(DeviceType, vector<DeviceType>&);
+    static CommandResult evaluateResult(int, int);
     static DeviceType translateDeviceType(const CorsairDeviceType&);
 public:
-    CorsairSDK();
+    explicit CorsairSDK(unsigned int);
     ~CorsairSDK();
     void connect() override;
     void disconnect() override;
     void setRGB(DeviceType, int, int, int) override;
     map<DeviceType, list<Device*>*> getDevices() override;
+    vector<CommandResult> setRGBBatch(const vector<RGBCommand>&) override;
+    vector<int> getLedIds(const Device*) override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+    void setLedColorsBatch(const vector<DeviceLedColors>&) override;
+    uint64_t getFlushTicket() override;
+    pplx::task<bool> whenAcked(uint64_t) override;
+    map<string, uint64_t> getStatistics() override;
 };
 
 
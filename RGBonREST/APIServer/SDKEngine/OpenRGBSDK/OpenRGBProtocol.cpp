@@ -0,0 +1,195 @@
+//
+// @file : OpenRGBProtocol.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class OpenRGBProtocol
+//
+
+#include "OpenRGBProtocol.h"
+
+
+/**
+ * A static member function for class OpenRGBProtocol that appends a little endian uint16_t.
+ * @param buffer the buffer to append to.
+ * @param value the value to append.
+ */
+void OpenRGBProtocol::appendUint16(string& buffer, uint16_t value) {
+    buffer += (char) (value & 0xFF);
+    buffer += (char) ((value >> 8) & 0xFF);
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that appends a little endian uint32_t.
+ * @param buffer the buffer to append to.
+ * @param value the value to append.
+ */
+void OpenRGBProtocol::appendUint32(string& buffer, uint32_t value) {
+    for (int i = 0 ; i < 4 ; i++)
+        buffer += (char) ((value >> (i * 8)) & 0xFF);
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that appends a whole packet, header and payload.
+ * Several packets can be appended to the same buffer, so that they are sent with a single send.
+ * @param buffer the buffer to append to.
+ * @param deviceIndex the index of the controller that the packet is for, 0 for packets that are not.
+ * @param packetId an OpenRGBPacketId value.
+ * @param payload the payload of the packet.
+ */
+void OpenRGBProtocol::appendPacket(string& buffer, uint32_t deviceIndex, uint32_t packetId, const string& payload) {
+    buffer += "ORGB";
+    appendUint32(buffer, deviceIndex);
+    appendUint32(buffer, packetId);
+    appendUint32(buffer, (uint32_t) payload.size());
+    buffer += payload;
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that reads a packet header.
+ * @param header OPENRGB_HEADER_SIZE bytes that were received.
+ * @param deviceIndex the device index of the packet is stored here.
+ * @param packetId the OpenRGBPacketId of the packet is stored here.
+ * @param payloadSize the size of the payload that follows is stored here.
+ * @return returns false if the header did not start with "ORGB".
+ */
+bool OpenRGBProtocol::parseHeader(const char* header, uint32_t& deviceIndex, uint32_t& packetId, uint32_t& payloadSize) {
+    string headerString(header, OPENRGB_HEADER_SIZE);
+    if (headerString.compare(0, 4, "ORGB") != 0) return false;
+
+    size_t offset = 4;
+    return readUint32(headerString, offset, deviceIndex) && readUint32(headerString, offset, packetId) &&
+           readUint32(headerString, offset, payloadSize);
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that builds the payload of an UpdateLEDs packet.
+ * OpenRGB always takes a color for every LED of the controller.
+ * @param colors a packed color for every LED of the controller, from packColor.
+ * @return returns the payload.
+ */
+string OpenRGBProtocol::buildUpdateLeds(const vector<uint32_t>& colors) {
+    string payload;
+    payload.reserve(6 + colors.size() * 4);
+    appendUint32(payload, (uint32_t) (6 + colors.size() * 4)); // size of this payload, including itself
+    appendUint16(payload, (uint16_t) colors.size());
+    for (auto const& x : colors)
+        appendUint32(payload, x);
+    return payload;
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that reads the reply of RequestControllerData.
+ * Only the name, the type and the number of LEDs are kept. Everything else is skipped, which depends on the protocol
+ * version: vendor was added in 1, and brightness of modes in 3.
+ * @param payload the payload of the reply.
+ * @param protocolVersion the protocol version that both sides agreed on.
+ * @param controller the controller is stored here.
+ * @return returns false if the payload was shorter than what it described.
+ */
+bool OpenRGBProtocol::parseControllerData(const string& payload, uint32_t protocolVersion, OpenRGBController& controller) {
+    size_t offset = 0;
+    uint32_t dataSize, type, activeMode;
+    uint16_t modeCount, zoneCount, ledCount, colorCount, matrixSize;
+    string ignored;
+
+    if (!readUint32(payload, offset, dataSize) || !readUint32(payload, offset, type)) return false;
+    if (!readString(payload, offset, controller.name)) return false;
+    controller.type = (int) type;
+    if (protocolVersion >= 1 && !readString(payload, offset, ignored)) return false; // vendor
+    for (int i = 0 ; i < 4 ; i++) // description, version, serial, location
+        if (!readString(payload, offset, ignored)) return false;
+
+    if (!readUint16(payload, offset, modeCount) || !readUint32(payload, offset, activeMode)) return false;
+    for (uint16_t i = 0 ; i < modeCount ; i++) {
+        if (!readString(payload, offset, ignored)) return false; // name
+        size_t fixedSize = (protocolVersion >= 3) ? 4 * 12 : 4 * 9; // value to color_mode
+        if (!skip(payload, offset, fixedSize) || !readUint16(payload, offset, colorCount)) return false;
+        if (!skip(payload, offset, (size_t) colorCount * 4)) return false;
+    }
+
+    if (!readUint16(payload, offset, zoneCount)) return false;
+    for (uint16_t i = 0 ; i < zoneCount ; i++) {
+        if (!readString(payload, offset, ignored)) return false; // name
+        if (!skip(payload, offset, 4 * 4) || !readUint16(payload, offset, matrixSize)) return false; // type to leds_count
+        if (!skip(payload, offset, matrixSize)) return false;
+    }
+
+    if (!readUint16(payload, offset, ledCount)) return false;
+    for (uint16_t i = 0 ; i < ledCount ; i++) {
+        if (!readString(payload, offset, ignored) || !skip(payload, offset, 4)) return false; // name and value
+    }
+    controller.ledCount = ledCount;
+
+    if (!readUint16(payload, offset, colorCount)) return false; // colors are set by RGBonREST anyway
+    return skip(payload, offset, (size_t) colorCount * 4);
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that packs a color the way OpenRGB stores RGBColor.
+ * @param r the r value
+ * @param g the g value
+ * @param b the b value
+ * @return returns r in the lowest byte, then g, then b.
+ */
+uint32_t OpenRGBProtocol::packColor(int r, int g, int b) {
+    return ((uint32_t) r & 0xFF) | (((uint32_t) g & 0xFF) << 8) | (((uint32_t) b & 0xFF) << 16);
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that reads a little endian uint16_t.
+ * @param buffer the buffer to read from.
+ * @param offset where to read, moved past the value.
+ * @param value the value is stored here.
+ * @return returns false if buffer was too short.
+ */
+bool OpenRGBProtocol::readUint16(const string& buffer, size_t& offset, uint16_t& value) {
+    if (buffer.size() < offset + 2) return false;
+    value = (uint16_t) ((uint8_t) buffer[offset] | ((uint8_t) buffer[offset + 1] << 8));
+    offset += 2;
+    return true;
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that reads a little endian uint32_t.
+ * @param buffer the buffer to read from.
+ * @param offset where to read, moved past the value.
+ * @param value the value is stored here.
+ * @return returns false if buffer was too short.
+ */
+bool OpenRGBProtocol::readUint32(const string& buffer, size_t& offset, uint32_t& value) {
+    if (buffer.size() < offset + 4) return false;
+    value = 0;
+    for (int i = 3 ; i >= 0 ; i--)
+        value = (value << 8) | (uint8_t) buffer[offset + i];
+    offset += 4;
+    return true;
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that reads a string, which is a uint16_t length and then that
+ * many bytes including the null terminator.
+ * @param buffer the buffer to read from.
+ * @param offset where to read, moved past the string.
+ * @param value the string without the null terminator is stored here.
+ * @return returns false if buffer was too short.
+ */
+bool OpenRGBProtocol::readString(const string& buffer, size_t& offset, string& value) {
+    uint16_t length;
+    if (!readUint16(buffer, offset, length) || buffer.size() < offset + length) return false;
+    value = buffer.substr(offset, length);
+    if (!value.empty() && value.back() == '\0') value.pop_back();
+    offset += length;
+    return true;
+}
+
+/**
+ * A static member function for class OpenRGBProtocol that skips bytes.
+ * @param buffer the buffer to read from.
+ * @param offset where to read, moved past the skipped bytes.
+ * @param length how many bytes to skip.
+ * @return returns false if buffer was too short.
+ */
+bool OpenRGBProtocol::skip(const string& buffer, size_t& offset, size_t length) {
+    if (buffer.size() < offset + length) return false;
+    offset += length;
+    return true;
+}
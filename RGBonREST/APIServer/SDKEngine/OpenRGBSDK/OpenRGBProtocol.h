@@ -0,0 +1,67 @@
+//
+// @file : OpenRGBProtocol.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class OpenRGBProtocol
+//
+
+#ifndef RGBONREST_OPENRGBPROTOCOL_H
+#define RGBONREST_OPENRGBPROTOCOL_H
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using std::string;
+using std::vector;
+
+#define OPENRGB_HEADER_SIZE 16 // "ORGB", device index, packet id and payload size
+#define OPENRGB_CLIENT_PROTOCOL_VERSION 3 // highest version whose controller data this client can read
+
+
+/**
+ * An enum that represents ids of OpenRGB SDK packets that RGBonREST sends or reads.
+ */
+enum OpenRGBPacketId {
+    OpenRGBRequestControllerCount = 0,
+    OpenRGBRequestControllerData = 1,
+    OpenRGBRequestProtocolVersion = 40,
+    OpenRGBSetClientName = 50,
+    OpenRGBDeviceListUpdated = 100,
+    OpenRGBUpdateLeds = 1050,
+    OpenRGBSetCustomMode = 1100
+};
+
+/**
+ * A struct that stores the parts of an OpenRGB controller that RGBonREST uses.
+ * type is an OpenRGB device_type value. LEDs are addressed by their index, from 0 to ledCount - 1.
+ */
+typedef struct openRGBController {
+    string name;
+    int type;
+    uint32_t ledCount;
+} OpenRGBController;
+
+
+/**
+ * A class that is a set of static member functions for building and reading OpenRGB SDK packets.
+ * Every number in the protocol is little endian, no matter which platform the server runs on.
+ */
+class OpenRGBProtocol {
+private:
+    static bool readUint16(const string&, size_t&, uint16_t&);
+    static bool readString(const string&, size_t&, string&);
+    static bool skip(const string&, size_t&, size_t);
+public:
+    static void appendUint16(string&, uint16_t);
+    static void appendUint32(string&, uint32_t);
+    static bool readUint32(const string&, size_t&, uint32_t&);
+    static void appendPacket(string&, uint32_t, uint32_t, const string&);
+    static bool parseHeader(const char*, uint32_t&, uint32_t&, uint32_t&);
+    static string buildUpdateLeds(const vector<uint32_t>&);
+    static bool parseControllerData(const string&, uint32_t, OpenRGBController&);
+    static uint32_t packColor(int, int, int);
+};
+
+
+#endif //RGBONREST_OPENRGBPROTOCOL_H
@@ -0,0 +1,493 @@
+//
+// @file : OpenRGBSDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class OpenRGBSDK
+//
+
+#include "OpenRGBSDK.h"
+
+
+/**
+ * A constructor member function for class OpenRGBSDK.
+ * Nothing is connected until connect is called.
+ * @param argHost the IPv4 address of the OpenRGB server.
+ * @param argPort the port of the OpenRGB SDK server, which is 6742 unless changed in OpenRGB.
+ */
+OpenRGBSDK::OpenRGBSDK(const string& argHost, unsigned int argPort) {
+    this->sdkName = "OpenRGB";
+    this->isConnected = false;
+    this->host = argHost;
+    this->port = argPort;
+    this->socketHandle = INVALID_SOCKET;
+    this->protocolVersion = 0;
+
+    this->devices[DeviceType::Mouse] = new list<Device*>; // lists are refilled on every connect
+    this->devices[DeviceType::Headset] = new list<Device*>;
+    this->devices[DeviceType::Keyboard] = new list<Device*>;
+    this->devices[DeviceType::Mousemat] = new list<Device*>;
+    this->devices[DeviceType::HeadsetStand] = new list<Device*>;
+    this->devices[DeviceType::GPU] = new list<Device*>;
+    this->devices[DeviceType::Mainboard] = new list<Device*>;
+    this->devices[DeviceType::Microphone] = new list<Device*>;
+    this->devices[DeviceType::Cooler] = new list<Device*>;
+    this->devices[DeviceType::ETC] = new list<Device*>;
+    this->devices[DeviceType::RAM] = new list<Device*>;
+}
+
+/**
+ * A destructor member function for class OpenRGBSDK.
+ * This closes the connection if it was still open, then deletes all Device objects and device lists.
+ */
+OpenRGBSDK::~OpenRGBSDK() {
+    if (this->socketHandle != INVALID_SOCKET) this->closeConnection();
+
+    for (auto const& x : this->controllers)
+        delete x;
+    for (auto const& x : this->devices)
+        delete x.second;
+}
+
+/**
+ * A member function for class OpenRGBSDK that connects into the OpenRGB server.
+ * This agrees on a protocol version, enumerates every controller and puts them into custom mode.
+ * Every LED starts black in the buffers, until something is set.
+ * @throws SDKExceptions::SDKAlreadyConnected: when SDK was already connected.
+ * @throws SDKExceptions::SDKServiceNotRunning: when nothing was listening on host and port.
+ * @throws SDKExceptions::SDKConnectionFailed: when host was not a valid IPv4 address.
+ * @throws SDKExceptions::SDKUnexpectedError: when the server did not answer, or answered something unreadable.
+ */
+void OpenRGBSDK::connect() {
+    if (this->isConnected) throw SDKExceptions::SDKAlreadyConnected();
+
+    this->openConnection();
+    try {
+        this->setAllDeviceInfo();
+    } catch (...) { // do not keep a half open connection
+        this->closeConnection();
+        throw;
+    }
+    this->isConnected = true; // only after devices and LEDs are known
+}
+
+/**
+ * A member function for class OpenRGBSDK that disconnects from the OpenRGB server.
+ * Devices keep whatever color they had.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+void OpenRGBSDK::disconnect() {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+
+    this->isConnected = false;
+    this->closeConnection();
+}
+
+/**
+ * A member function for class OpenRGBSDK that sets every LED of every controller of a DeviceType.
+ * @param deviceType the DeviceType to set RGB values. ALL sets every controller.
+ * @param r the R value.
+ * @param g the G value.
+ * @param b the B value.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a value was not from 0 to 255.
+ * @throws SDKExceptions::InvalidDeviceType: when deviceType was not a DeviceType.
+ * @throws SDKExceptions::AllRGBFailed: when the connection was lost or the controllers of the server changed. SDK is
+ * disconnected in this case.
+ */
+void OpenRGBSDK::setRGB(DeviceType deviceType, int r, int g, int b) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (!isValidRgb(r, g, b)) throw SDKExceptions::InvalidRGBValue();
+
+    set<int> controllerIndices;
+    if (!this->resolveControllers(deviceType, controllerIndices)) throw SDKExceptions::InvalidDeviceType();
+
+    uint32_t color = OpenRGBProtocol::packColor(r, g, b);
+    for (auto const& x : controllerIndices)
+        std::fill(this->ledBuffers[x].begin(), this->ledBuffers[x].end(), color);
+    this->sendControllers(controllerIndices);
+}
+
+/**
+ * A member function for class OpenRGBSDK that returns member variable 'devices'.
+ * @return returns a map of list that represents pointer address to connected devices.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+map<DeviceType, list<Device*>*> OpenRGBSDK::getDevices() {
+    if (this->isConnected)
+        return this->devices;
+    else
+        throw SDKExceptions::SDKNotConnected();
+}
+
+/**
+ * A member function for class OpenRGBSDK that sets RGB values for several device types with a single send.
+ * Every command is written into the buffers first, then every controller that was touched is sent once.
+ * If several commands target the same controller, the last one wins.
+ * @param commands the commands to apply, in order.
+ * @return returns a CommandResult for each command, in the same order as commands.
+ */
+vector<CommandResult> OpenRGBSDK::setRGBBatch(const vector<RGBCommand>& commands) {
+    vector<CommandResult> results(commands.size(), CommandSuccess);
+    if (!this->isConnected) {
+        std::fill(results.begin(), results.end(), CommandSDKNotConnected);
+        return results;
+    }
+
+    set<int> touchedIndices;
+    for (size_t i = 0 ; i < commands.size() ; i++) { // buffer everything first
+        const RGBCommand& command = commands[i];
+        set<int> controllerIndices;
+
+        if (!isValidRgb(command.r, command.g, command.b))
+            results[i] = CommandInvalidRGBValue;
+        else if (!this->resolveControllers(command.deviceType, controllerIndices))
+            results[i] = CommandInvalidDeviceType;
+        else {
+            uint32_t color = OpenRGBProtocol::packColor(command.r, command.g, command.b);
+            for (auto const& x : controllerIndices)
+                std::fill(this->ledBuffers[x].begin(), this->ledBuffers[x].end(), color);
+            touchedIndices.insert(controllerIndices.begin(), controllerIndices.end());
+        }
+    }
+
+    try { // then send once for all of them
+        this->sendControllers(touchedIndices);
+    } catch (const SDKExceptions::AllRGBFailed& e) {
+        for (auto& x : results)
+            if (x == CommandSuccess) x = CommandAllRGBFailed;
+    }
+    return results;
+}
+
+/**
+ * A member function for class OpenRGBSDK that returns the ids of every LED of a device.
+ * @param device the device to get LEDs of.
+ * @return returns the index of every LED of the controller, from 0 to its LED count - 1.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+vector<int> OpenRGBSDK::getLedIds(const Device* device) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+
+    if (device->deviceIndex >= (int) this->ledBuffers.size()) return vector<int>(); // gone since the last connect
+
+    vector<int> ledIds(this->ledBuffers[device->deviceIndex].size());
+    for (size_t i = 0 ; i < ledIds.size() ; i++)
+        ledIds[i] = (int) i;
+    return ledIds;
+}
+
+/**
+ * A member function for class OpenRGBSDK that sets colors of some LEDs of a device.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with ids from getLedIds.
+ * @throws the same exceptions as setLedColorsBatch.
+ */
+void OpenRGBSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    this->setLedColorsBatch(vector<DeviceLedColors>{DeviceLedColors{device, leds}});
+}
+
+/**
+ * A member function for class OpenRGBSDK that sets colors of LEDs of several devices with a single send.
+ * Only the given LEDs change in the buffers, but OpenRGB always takes every LED of a controller, so the rest of each
+ * controller is sent again with the color it already had. LEDs with ids that the controller does not have are ignored.
+ * @param deviceLeds the devices and their LEDs to set.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a color was not from 0 to 255. Nothing is written in this case.
+ * @throws SDKExceptions::AllRGBFailed: when the connection was lost or the controllers of the server changed. SDK is
+ * disconnected in this case.
+ */
+void OpenRGBSDK::setLedColorsBatch(const vector<DeviceLedColors>& deviceLeds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    for (auto const& x : deviceLeds)
+        for (auto const& y : x.leds)
+            if (!isValidRgb(y.r, y.g, y.b)) throw SDKExceptions::InvalidRGBValue();
+
+    set<int> touchedIndices;
+    for (auto const& x : deviceLeds) {
+        if (x.device->deviceIndex >= (int) this->ledBuffers.size()) continue; // gone since the last connect
+        vector<uint32_t>& ledBuffer = this->ledBuffers[x.device->deviceIndex];
+        for (auto const& y : x.leds) {
+            if (y.ledId < 0 || y.ledId >= (int) ledBuffer.size()) continue;
+            ledBuffer[y.ledId] = OpenRGBProtocol::packColor(y.r, y.g, y.b);
+            touchedIndices.insert(x.device->deviceIndex);
+        }
+    }
+    this->sendControllers(touchedIndices);
+}
+
+/**
+ * A member function for class OpenRGBSDK that returns counters of the connection.
+ * packets_sent divided by sends tells how many UpdateLEDs packets went out with a single send.
+ * @return returns packets_sent, sends and bytes_sent.
+ */
+map<string, uint64_t> OpenRGBSDK::getStatistics() {
+    map<string, uint64_t> statistics;
+    statistics["packets_sent"] = this->sentPacketCount.load();
+    statistics["sends"] = this->sentCallCount.load();
+    statistics["bytes_sent"] = this->sentByteCount.load();
+    return statistics;
+}
+
+/**
+ * A member function that opens the TCP connection and agrees on a protocol version.
+ * Servers that are older than protocol version 1 never answer RequestProtocolVersion, so no answer means version 0.
+ * @throws SDKExceptions::SDKUnexpectedError: when sockets could not be used.
+ * @throws SDKExceptions::SDKConnectionFailed: when host was not a valid IPv4 address.
+ * @throws SDKExceptions::SDKServiceNotRunning: when nothing was listening on host and port.
+ */
+void OpenRGBSDK::openConnection() {
+    if (!SocketUtils::initialize()) throw SDKExceptions::SDKUnexpectedError();
+
+    sockaddr_in address{};
+    if (!SocketUtils::fillAddress(this->host, this->port, address)) {
+        SocketUtils::cleanup();
+        throw SDKExceptions::SDKConnectionFailed();
+    }
+
+    this->socketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (this->socketHandle == INVALID_SOCKET) {
+        SocketUtils::cleanup();
+        throw SDKExceptions::SDKUnexpectedError();
+    }
+    if (::connect(this->socketHandle, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR) {
+        this->closeConnection();
+        throw SDKExceptions::SDKServiceNotRunning();
+    }
+
+    int noDelay = 1; // UpdateLEDs packets are small and should leave right away
+    setsockopt(this->socketHandle, IPPROTO_TCP, TCP_NODELAY, (const char*) &noDelay, sizeof(noDelay));
+    SocketUtils::setReceiveTimeout(this->socketHandle, OPENRGB_RECEIVE_TIMEOUT_MS);
+
+    string buffer, payload;
+    OpenRGBProtocol::appendUint32(payload, OPENRGB_CLIENT_PROTOCOL_VERSION);
+    OpenRGBProtocol::appendPacket(buffer, 0, OpenRGBRequestProtocolVersion, payload);
+    OpenRGBProtocol::appendPacket(buffer, 0, OpenRGBSetClientName, string("RGBonREST", sizeof("RGBonREST")));
+    if (!this->sendBuffer(buffer)) {
+        this->closeConnection();
+        throw SDKExceptions::SDKUnexpectedError();
+    }
+
+    uint32_t serverVersion = 0;
+    size_t offset = 0;
+    if (!this->receivePacket(OpenRGBRequestProtocolVersion, payload) ||
+        !OpenRGBProtocol::readUint32(payload, offset, serverVersion))
+        serverVersion = 0;
+    this->protocolVersion = std::min(serverVersion, (uint32_t) OPENRGB_CLIENT_PROTOCOL_VERSION);
+}
+
+/**
+ * A member function that closes the TCP connection.
+ */
+void OpenRGBSDK::closeConnection() {
+    SocketUtils::shutdownSocket(this->socketHandle);
+    SocketUtils::closeSocket(this->socketHandle);
+    SocketUtils::cleanup();
+    this->socketHandle = INVALID_SOCKET;
+}
+
+/**
+ * A member function that enumerates every controller of the server into member variable devices.
+ * Every RequestControllerData is sent at once and the answers are read afterwards, then every controller is put into
+ * custom mode, so that UpdateLEDs is shown instead of whatever effect the controller was running.
+ * Device objects are reused by their controller index, so pointers that were handed out before stay valid.
+ * @throws SDKExceptions::SDKUnexpectedError: when the server did not answer, or answered something unreadable.
+ */
+void OpenRGBSDK::setAllDeviceInfo() {
+    string buffer, payload;
+    OpenRGBProtocol::appendPacket(buffer, 0, OpenRGBRequestControllerCount, "");
+    uint32_t controllerCount = 0;
+    size_t offset = 0;
+    if (!this->sendBuffer(buffer) || !this->receivePacket(OpenRGBRequestControllerCount, payload) ||
+        !OpenRGBProtocol::readUint32(payload, offset, controllerCount))
+        throw SDKExceptions::SDKUnexpectedError();
+
+    buffer.clear();
+    string versionPayload;
+    if (this->protocolVersion >= 1) OpenRGBProtocol::appendUint32(versionPayload, this->protocolVersion);
+    for (uint32_t i = 0 ; i < controllerCount ; i++)
+        OpenRGBProtocol::appendPacket(buffer, i, OpenRGBRequestControllerData, versionPayload);
+    if (!this->sendBuffer(buffer)) throw SDKExceptions::SDKUnexpectedError();
+
+    for (auto const& x : this->devices)
+        x.second->clear();
+    this->ledBuffers.assign(controllerCount, vector<uint32_t>());
+
+    buffer.clear();
+    for (uint32_t i = 0 ; i < controllerCount ; i++) {
+        OpenRGBController controller;
+        if (!this->receivePacket(OpenRGBRequestControllerData, payload) ||
+            !OpenRGBProtocol::parseControllerData(payload, this->protocolVersion, controller))
+            throw SDKExceptions::SDKUnexpectedError();
+
+        if (i >= this->controllers.size()) this->controllers.push_back(new Device);
+        Device* tmpDevice = this->controllers[i];
+        tmpDevice->sdkName = this->sdkName;
+        tmpDevice->name = controller.name;
+        tmpDevice->deviceType = translateDeviceType(controller.type);
+        tmpDevice->deviceIndex = (int) i;
+        this->devices[tmpDevice->deviceType]->push_back(tmpDevice);
+
+        this->ledBuffers[i].assign(controller.ledCount, 0); // black
+        OpenRGBProtocol::appendPacket(buffer, i, OpenRGBSetCustomMode, "");
+    }
+    if (!buffer.empty() && !this->sendBuffer(buffer)) throw SDKExceptions::SDKUnexpectedError();
+}
+
+/**
+ * A member function that sends an UpdateLEDs packet for every given controller, packed into a single send.
+ * Packets that the server sent on its own are read first, so that they never pile up in the socket.
+ * @param controllerIndices the controllers to send.
+ * @throws SDKExceptions::AllRGBFailed: when the connection was lost, or the server reported that its controllers
+ * changed. SDK is disconnected in this case, since controller indices might point at other controllers now.
+ */
+void OpenRGBSDK::sendControllers(const set<int>& controllerIndices) {
+    if (controllerIndices.empty()) return; // nothing to send
+
+    string buffer;
+    for (auto const& x : controllerIndices)
+        OpenRGBProtocol::appendPacket(buffer, (uint32_t) x, OpenRGBUpdateLeds, OpenRGBProtocol::buildUpdateLeds(this->ledBuffers[x]));
+
+    if (!this->drainPackets() || !this->sendBuffer(buffer)) { // connect has to be called again to enumerate controllers
+        this->isConnected = false;
+        this->closeConnection();
+        throw SDKExceptions::AllRGBFailed();
+    }
+    this->sentPacketCount += controllerIndices.size();
+}
+
+/**
+ * A member function that reads every packet that the server sent on its own, without waiting for more.
+ * OpenRGB never answers UpdateLEDs, but it sends DeviceListUpdated whenever controllers were added or removed. Left
+ * unread, those fill the socket until the server stops taking packets from RGBonREST.
+ * @return returns false if the connection was lost, or DeviceListUpdated arrived.
+ */
+bool OpenRGBSDK::drainPackets() {
+    string payload;
+    while (SocketUtils::isReadable(this->socketHandle)) {
+        char header[OPENRGB_HEADER_SIZE];
+        uint32_t receivedIndex, receivedId, payloadSize;
+        if (!this->receiveExactly(header, OPENRGB_HEADER_SIZE) ||
+            !OpenRGBProtocol::parseHeader(header, receivedIndex, receivedId, payloadSize) ||
+            payloadSize > OPENRGB_MAX_PACKET_SIZE)
+            return false; // closed by the server, or out of step with it
+
+        payload.assign(payloadSize, '\0');
+        if (payloadSize > 0 && !this->receiveExactly(&payload[0], payloadSize)) return false;
+        if (receivedId == OpenRGBDeviceListUpdated) return false;
+    }
+    return true;
+}
+
+/**
+ * A member function that sends every byte of a buffer.
+ * @param buffer the bytes to send.
+ * @return returns true if every byte was sent, false if the connection failed.
+ */
+bool OpenRGBSDK::sendBuffer(const string& buffer) {
+    size_t sent = 0;
+    while (sent < buffer.size()) {
+        int length = send(this->socketHandle, buffer.data() + sent, (int) (buffer.size() - sent), MSG_NOSIGNAL);
+        if (length <= 0) return false;
+        sent += length;
+    }
+    this->sentCallCount++;
+    this->sentByteCount += buffer.size();
+    return true;
+}
+
+/**
+ * A member function that receives packets until one with the given packet id arrives.
+ * Packets that the server sends on its own, like DeviceListUpdated, are skipped.
+ * @param packetId the OpenRGBPacketId to wait for.
+ * @param payload the payload of that packet is stored here.
+ * @return returns false if the connection failed, timed out, or the server sent something unreadable.
+ */
+bool OpenRGBSDK::receivePacket(uint32_t packetId, string& payload) {
+    while (true) {
+        char header[OPENRGB_HEADER_SIZE];
+        uint32_t receivedIndex, receivedId, payloadSize;
+        if (!this->receiveExactly(header, OPENRGB_HEADER_SIZE) ||
+            !OpenRGBProtocol::parseHeader(header, receivedIndex, receivedId, payloadSize) ||
+            payloadSize > OPENRGB_MAX_PACKET_SIZE)
+            return false;
+
+        payload.assign(payloadSize, '\0');
+        if (payloadSize > 0 && !this->receiveExactly(&payload[0], payloadSize)) return false;
+        if (receivedId == packetId) return true;
+    }
+}
+
+/**
+ * A member function that receives exactly the given number of bytes.
+ * @param buffer the buffer to store bytes into.
+ * @param length the number of bytes to receive.
+ * @return returns true if every byte was received, false if the socket was closed, failed or timed out.
+ */
+bool OpenRGBSDK::receiveExactly(char* buffer, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        int result = recv(this->socketHandle, buffer + received, (int) (length - received), 0);
+        if (result <= 0) return false;
+        received += result;
+    }
+    return true;
+}
+
+/**
+ * A member function that resolves a requested DeviceType into indices of controllers.
+ * @param deviceType the requested device type. ALL covers every controller.
+ * @param controllerIndices the indices of controllers are stored here.
+ * @return returns false if deviceType was not a DeviceType.
+ */
+bool OpenRGBSDK::resolveControllers(DeviceType deviceType, set<int>& controllerIndices) {
+    if (deviceType < DeviceType::ALL || deviceType > DeviceType::RAM) return false;
+
+    for (auto const& x : this->controllers) {
+        if (x->deviceIndex >= (int) this->ledBuffers.size()) continue; // left over from a bigger enumeration
+        if (deviceType == DeviceType::ALL || x->deviceType == deviceType)
+            controllerIndices.insert(x->deviceIndex);
+    }
+    return true;
+}
+
+/**
+ * A static member function for class OpenRGBSDK that checks if RGB values are from 0 to 255.
+ * @param r the r value
+ * @param g the g value
+ * @param b the b value
+ * @return returns true if every value was valid, false if not.
+ */
+bool OpenRGBSDK::isValidRgb(int r, int g, int b) {
+    return (((r >= 0) && (r <= 255)) && ((g >= 0) && (g <= 255))) && ((b >= 0) && (b <= 255));
+}
+
+/**
+ * A static member function that translates an OpenRGB device_type into DeviceType that is declared in SDKDefines.h
+ * @param type the device_type of an OpenRGB controller.
+ * @return the translated DeviceType value. Types that RGBonREST does not have become ETC.
+ */
+DeviceType OpenRGBSDK::translateDeviceType(int type) {
+    switch (type) {
+        case 0: // DEVICE_TYPE_MOTHERBOARD
+            return DeviceType::Mainboard;
+        case 1: // DEVICE_TYPE_DRAM
+            return DeviceType::RAM;
+        case 2: // DEVICE_TYPE_GPU
+            return DeviceType::GPU;
+        case 3: // DEVICE_TYPE_COOLER
+            return DeviceType::Cooler;
+        case 5: // DEVICE_TYPE_KEYBOARD
+            return DeviceType::Keyboard;
+        case 6: // DEVICE_TYPE_MOUSE
+            return DeviceType::Mouse;
+        case 7: // DEVICE_TYPE_MOUSEMAT
+            return DeviceType::Mousemat;
+        case 8: // DEVICE_TYPE_HEADSET
+            return DeviceType::Headset;
+        case 9: // DEVICE_TYPE_HEADSET_STAND
+            return DeviceType::HeadsetStand;
+        case 16: // DEVICE_TYPE_MICROPHONE
+            return DeviceType::Microphone;
+        default: // LED strips, lights, speakers, cases and everything else
+            return DeviceType::ETC;
+    }
+}
@@ -0,0 +1,76 @@
+//
+// @file : OpenRGBSDK.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class OpenRGBSDK
+//
+
+#ifndef RGBONREST_OPENRGBSDK_H
+#define RGBONREST_OPENRGBSDK_H
+#pragma once
+
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <atomic>
+
+#include "../AbstractSDK.h"
+#include "../../Utils/Defines.h"
+#include "../../Utils/SocketUtils.h"
+#include "./OpenRGBProtocol.h"
+
+using std::list;
+using std::vector;
+using std::set;
+using std::map;
+using std::atomic;
+
+
+/**
+ * A class that is an SDK which talks to an OpenRGB server over the OpenRGB SDK TCP protocol.
+ * The connection is opened once at connect and kept until disconnect. Controllers are enumerated at connect and put
+ * into custom mode. Every controller has a buffer with the color of every LED, and each set function only rewrites
+ * that buffer and then sends an UpdateLEDs packet for every controller it touched, all in a single send. OpenRGB does
+ * not answer UpdateLEDs, so sets never wait for the server. Packets that the server sends on its own are read before
+ * every send, and DeviceListUpdated disconnects the SDK so that connect enumerates controllers again.
+ */
+class OpenRGBSDK : public AbstractSDK {
+private:
+    string host;
+    unsigned int port;
+    SocketHandle socketHandle;
+    uint32_t protocolVersion;
+    vector<Device*> controllers; // controller index -> Device, kept until destruction so pointers stay valid
+    vector<vector<uint32_t>> ledBuffers; // controller index -> packed color of every LED
+
+    atomic<uint64_t> sentPacketCount{0};
+    atomic<uint64_t> sentCallCount{0};
+    atomic<uint64_t> sentByteCount{0};
+
+    void openConnection();
+    void closeConnection();
+    void setAllDeviceInfo();
+    void sendControllers(const set<int>&);
+    bool drainPackets();
+    bool sendBuffer(const string&);
+    bool receivePacket(uint32_t, string&);
+    bool receiveExactly(char*, size_t);
+    bool resolveControllers(DeviceType, set<int>&);
+    static bool isValidRgb(int, int, int);
+    static DeviceType translateDeviceType(int);
+public:
+    OpenRGBSDK(const string&, unsigned int);
+    ~OpenRGBSDK();
+    void connect() override;
+    void disconnect() override;
+    void setRGB(DeviceType, int, int, int) override;
+    map<DeviceType, list<Device*>*> getDevices() override;
+    vector<CommandResult> setRGBBatch(const vector<RGBCommand>&) override;
+    vector<int> getLedIds(const Device*) override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+    void setLedColorsBatch(const vector<DeviceLedColors>&) override;
+    map<string, uint64_t> getStatistics() override;
+};
+
+
+#endif //RGBONREST_OPENRGBSDK_H
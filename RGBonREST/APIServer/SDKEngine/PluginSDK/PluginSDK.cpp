@@ -0,0 +1,248 @@
+//
+// @file : PluginSDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class PluginSDK
+//
+
+#include "PluginSDK.h"
+
+
+/**
+ * A constructor member function for class PluginSDK.
+ * This loads the shared library, looks up RGBONREST_PLUGIN_ENTRY_NAME and performs the version handshake.
+ * The name of the SDK comes from the plugin, so that its endpoints are generated under that name.
+ * @param libraryPath the path to the shared library of the plugin.
+ * @throws PluginSDK::pluginLoadFailed: when the library could not be loaded or the handshake failed.
+ */
+PluginSDK::PluginSDK(const string& libraryPath) {
+    this->isConnected = false;
+    this->api = nullptr;
+    this->instance = nullptr;
+
+#ifdef _WIN32
+    this->libraryHandle = LoadLibraryA(libraryPath.c_str());
+    if (this->libraryHandle == nullptr) throw PluginSDK::pluginLoadFailed();
+    auto entry = (RGBonRESTPluginEntry) GetProcAddress(this->libraryHandle, RGBONREST_PLUGIN_ENTRY_NAME);
+#else
+    this->libraryHandle = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (this->libraryHandle == nullptr) throw PluginSDK::pluginLoadFailed();
+    auto entry = (RGBonRESTPluginEntry) dlsym(this->libraryHandle, RGBONREST_PLUGIN_ENTRY_NAME);
+#endif
+
+    if (entry != nullptr) this->api = entry(RGBONREST_PLUGIN_ABI_VERSION);
+
+    bool isValid = this->api != nullptr && this->api->abiVersion == RGBONREST_PLUGIN_ABI_VERSION &&
+            this->api->name != nullptr && this->api->create != nullptr && this->api->destroy != nullptr &&
+            this->api->connect != nullptr && this->api->disconnect != nullptr &&
+            this->api->getDeviceCount != nullptr && this->api->getDevice != nullptr && this->api->setRgb != nullptr;
+    if (isValid) this->instance = this->api->create();
+
+    if (this->instance == nullptr) { // missing entry, other ABI version, missing functions or create failed
+        closeLibrary(this->libraryHandle);
+        throw PluginSDK::pluginLoadFailed();
+    }
+    this->sdkName = string(this->api->name);
+
+    this->devices[DeviceType::Mouse] = new list<Device*>; // lists are refilled on every connect
+    this->devices[DeviceType::Headset] = new list<Device*>;
+    this->devices[DeviceType::Keyboard] = new list<Device*>;
+    this->devices[DeviceType::Mousemat] = new list<Device*>;
+    this->devices[DeviceType::HeadsetStand] = new list<Device*>;
+    this->devices[DeviceType::GPU] = new list<Device*>;
+    this->devices[DeviceType::Mainboard] = new list<Device*>;
+    this->devices[DeviceType::Microphone] = new list<Device*>;
+    this->devices[DeviceType::Cooler] = new list<Device*>;
+    this->devices[DeviceType::ETC] = new list<Device*>;
+    this->devices[DeviceType::RAM] = new list<Device*>;
+}
+
+/**
+ * A destructor member function for class PluginSDK.
+ * This disconnects the plugin if it was still connected, destroys its instance and unloads the library.
+ */
+PluginSDK::~PluginSDK() {
+    if (this->isConnected) this->api->disconnect(this->instance);
+    this->api->destroy(this->instance);
+    closeLibrary(this->libraryHandle);
+
+    for (auto const& x : this->pluginDevices)
+        delete x;
+    for (auto const& x : this->devices)
+        delete x.second;
+}
+
+/**
+ * A member function for class PluginSDK that connects the plugin.
+ * @throws SDKExceptions::SDKAlreadyConnected: when SDK was already connected.
+ * @throws the exception that matches the result code of the plugin when it failed to connect.
+ */
+void PluginSDK::connect() {
+    if (this->isConnected) throw SDKExceptions::SDKAlreadyConnected();
+
+    throwResult(this->api->connect(this->instance));
+    try {
+        this->setAllDeviceInfo();
+    } catch (...) { // a plugin without usable devices stays disconnected
+        this->api->disconnect(this->instance);
+        throw;
+    }
+    this->isConnected = true; // only after devices are known
+}
+
+/**
+ * A member function for class PluginSDK that disconnects the plugin.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws the exception that matches the result code of the plugin when it failed to disconnect.
+ */
+void PluginSDK::disconnect() {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+
+    throwResult(this->api->disconnect(this->instance));
+    this->isConnected = false;
+}
+
+/**
+ * A member function for class PluginSDK that sets RGB values of a DeviceType.
+ * @param deviceType the DeviceType to set RGB values.
+ * @param r the R value.
+ * @param g the G value.
+ * @param b the B value.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws the exception that matches the result code of the plugin when it failed to set RGB values.
+ */
+void PluginSDK::setRGB(DeviceType deviceType, int r, int g, int b) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    throwResult(this->api->setRgb(this->instance, (int32_t) deviceType, r, g, b));
+}
+
+/**
+ * A member function for class PluginSDK that returns member variable 'devices'.
+ * @return returns a map of list that represents pointer address to connected devices.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+map<DeviceType, list<Device*>*> PluginSDK::getDevices() {
+    if (this->isConnected)
+        return this->devices;
+    else
+        throw SDKExceptions::SDKNotConnected();
+}
+
+/**
+ * A member function for class PluginSDK that returns the ids of every LED of a device.
+ * Plugins that do not implement getLedIds are treated as one LED per device, same as AbstractSDK.
+ * @param device the device to get LEDs of.
+ * @return returns the ids of LEDs, in the order the plugin returned them.
+ */
+vector<int> PluginSDK::getLedIds(const Device* device) {
+    if (this->api->getLedIds == nullptr || this->api->setLeds == nullptr)
+        return AbstractSDK::getLedIds(device);
+
+    vector<int32_t> ledIds(64);
+    int32_t count = this->api->getLedIds(this->instance, device->deviceIndex, ledIds.data(), (int32_t) ledIds.size());
+    if (count > (int32_t) ledIds.size()) { // did not fit, ask again with enough room
+        ledIds.resize(count);
+        count = this->api->getLedIds(this->instance, device->deviceIndex, ledIds.data(), (int32_t) ledIds.size());
+    }
+    if (count < 0 || count > (int32_t) ledIds.size()) return vector<int>();
+
+    return vector<int>(ledIds.begin(), ledIds.begin() + count);
+}
+
+/**
+ * A member function for class PluginSDK that sets colors of some LEDs of a device.
+ * Plugins that do not implement setLeds set the whole DeviceType instead, same as AbstractSDK.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with ids from getLedIds.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws the exception that matches the result code of the plugin when it failed to set LEDs.
+ */
+void PluginSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (this->api->getLedIds == nullptr || this->api->setLeds == nullptr) {
+        AbstractSDK::setLedColors(device, leds);
+        return;
+    }
+
+    vector<RGBonRESTPluginLed> pluginLeds;
+    pluginLeds.reserve(leds.size());
+    for (auto const& x : leds)
+        pluginLeds.push_back({x.ledId, x.r, x.g, x.b});
+    throwResult(this->api->setLeds(this->instance, device->deviceIndex, pluginLeds.data(), (int32_t) pluginLeds.size()));
+}
+
+/**
+ * A member function that sets all device information of the plugin into member variable devices.
+ * Device objects are reused by their plugin index, so pointers that were handed out before stay valid.
+ * @throws SDKExceptions::NoDevicesConnected: when the plugin reported no devices.
+ * @throws the exception that matches the result code of the plugin when it failed to describe a device.
+ */
+void PluginSDK::setAllDeviceInfo() {
+    int32_t deviceCount = this->api->getDeviceCount(this->instance);
+    if (deviceCount <= 0) throw SDKExceptions::NoDevicesConnected();
+
+    for (auto const& x : this->devices)
+        x.second->clear();
+
+    for (int32_t i = 0 ; i < deviceCount ; i++) {
+        RGBonRESTPluginDevice pluginDevice = {};
+        throwResult(this->api->getDevice(this->instance, i, &pluginDevice));
+        pluginDevice.name[RGBONREST_PLUGIN_DEVICE_NAME_SIZE - 1] = '\0'; // never trust the plugin to terminate it
+
+        if (i >= (int32_t) this->pluginDevices.size()) this->pluginDevices.push_back(new Device);
+        Device* tmpDevice = this->pluginDevices[i];
+        tmpDevice->sdkName = this->sdkName;
+        tmpDevice->name = string(pluginDevice.name);
+        tmpDevice->deviceIndex = i;
+
+        auto found = this->devices.find((DeviceType) pluginDevice.deviceType);
+        tmpDevice->deviceType = found == this->devices.end() ? DeviceType::ETC : found->first;
+        this->devices[tmpDevice->deviceType]->push_back(tmpDevice);
+    }
+}
+
+/**
+ * A static member function for class PluginSDK that throws the exception that matches a result code of a plugin.
+ * @param result the result code that a function of the plugin returned.
+ * @throws the matching SDKExceptions, nothing when result was RGBONREST_PLUGIN_OK.
+ */
+void PluginSDK::throwResult(int32_t result) {
+    switch (result) {
+        case RGBONREST_PLUGIN_OK:
+            return;
+        case RGBONREST_PLUGIN_SOME_RGB_FAILED:
+            throw SDKExceptions::SomeRGBFailed();
+        case RGBONREST_PLUGIN_ALL_RGB_FAILED:
+            throw SDKExceptions::AllRGBFailed();
+        case RGBONREST_PLUGIN_INVALID_DEVICE_TYPE:
+            throw SDKExceptions::InvalidDeviceType();
+        case RGBONREST_PLUGIN_INVALID_RGB_VALUE:
+            throw SDKExceptions::InvalidRGBValue();
+        case RGBONREST_PLUGIN_NOT_CONNECTED:
+            throw SDKExceptions::SDKNotConnected();
+        case RGBONREST_PLUGIN_ALREADY_CONNECTED:
+            throw SDKExceptions::SDKAlreadyConnected();
+        case RGBONREST_PLUGIN_NO_DEVICES:
+            throw SDKExceptions::NoDevicesConnected();
+        case RGBONREST_PLUGIN_SERVICE_NOT_RUNNING:
+            throw SDKExceptions::SDKServiceNotRunning();
+        case RGBONREST_PLUGIN_CONNECTION_FAILED:
+            throw SDKExceptions::SDKConnectionFailed();
+        case RGBONREST_PLUGIN_VERSION_MISMATCH:
+            throw SDKExceptions::SDKVersionMismatch();
+        case RGBONREST_PLUGIN_UNEXPECTED_ERROR:
+        default:
+            throw SDKExceptions::SDKUnexpectedError();
+    }
+}
+
+/**
+ * A static member function for class PluginSDK that unloads a shared library.
+ * @param handle the handle of the library to unload.
+ */
+void PluginSDK::closeLibrary(PluginHandle handle) {
+#ifdef _WIN32
+    FreeLibrary(handle);
+#else
+    dlclose(handle);
+#endif
+}
@@ -0,0 +1,70 @@
+//
+// @file : PluginSDK.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class PluginSDK
+//
+
+#ifndef RGBONREST_PLUGINSDK_H
+#define RGBONREST_PLUGINSDK_H
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef HMODULE PluginHandle;
+#define RGBONREST_PLUGIN_SUFFIX ".dll"
+#else
+#include <dlfcn.h>
+
+typedef void* PluginHandle;
+#define RGBONREST_PLUGIN_SUFFIX ".so"
+#endif
+
+#include <list>
+#include <vector>
+#include <string>
+
+#include "../AbstractSDK.h"
+#include "./RGBonRESTPlugin.h"
+
+using std::list;
+using std::vector;
+using std::string;
+
+
+/**
+ * A class that is an SDK which lives in a shared library that was loaded at start up.
+ * Every AbstractSDK member function is forwarded to the RGBonRESTPluginApi that the library handed over,
+ * and every result code that the library returns is thrown as the matching SDKExceptions.
+ */
+class PluginSDK : public AbstractSDK {
+private:
+    PluginHandle libraryHandle;
+    const RGBonRESTPluginApi* api;
+    void* instance;
+    vector<Device*> pluginDevices; // plugin device index -> Device, kept until destruction so pointers stay valid
+
+    void setAllDeviceInfo();
+    static void throwResult(int32_t);
+    static void closeLibrary(PluginHandle);
+public:
+    explicit PluginSDK(const string&);
+    ~PluginSDK();
+
+    void connect() override;
+    void disconnect() override;
+    void setRGB(DeviceType, int, int, int) override;
+    map<DeviceType, list<Device*>*> getDevices() override;
+    vector<int> getLedIds(const Device*) override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+
+    /**
+     * A class that is for exception when a plugin could not be loaded.
+     * The library was not found, did not export RGBONREST_PLUGIN_ENTRY_NAME, or does not speak the same ABI version.
+     */
+    class pluginLoadFailed : public exception {
+    };
+};
+
+
+#endif //RGBONREST_PLUGINSDK_H
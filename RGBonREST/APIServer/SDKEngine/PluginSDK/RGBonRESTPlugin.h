@@ -0,0 +1,99 @@
+//
+// @file : RGBonRESTPlugin.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the C ABI that SDK plugins implement
+//
+
+#ifndef RGBONREST_RGBONRESTPLUGIN_H
+#define RGBONREST_RGBONRESTPLUGIN_H
+#pragma once
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#define RGBONREST_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define RGBONREST_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define RGBONREST_PLUGIN_ABI_VERSION 1 // Bump whenever RGBonRESTPluginApi or any struct below changes its layout
+#define RGBONREST_PLUGIN_ENTRY_NAME "rgbonrest_plugin_entry"
+#define RGBONREST_PLUGIN_DEVICE_NAME_SIZE 128
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Result codes that every function of a plugin returns.
+ * Each non zero value matches one of the exceptions in SDKExceptions.
+ */
+enum RGBonRESTPluginResult {
+    RGBONREST_PLUGIN_OK = 0,
+    RGBONREST_PLUGIN_SOME_RGB_FAILED = 1,
+    RGBONREST_PLUGIN_ALL_RGB_FAILED = 2,
+    RGBONREST_PLUGIN_INVALID_DEVICE_TYPE = 3,
+    RGBONREST_PLUGIN_INVALID_RGB_VALUE = 4,
+    RGBONREST_PLUGIN_NOT_CONNECTED = 5,
+    RGBONREST_PLUGIN_UNEXPECTED_ERROR = 6,
+    RGBONREST_PLUGIN_ALREADY_CONNECTED = 7,
+    RGBONREST_PLUGIN_NO_DEVICES = 8,
+    RGBONREST_PLUGIN_SERVICE_NOT_RUNNING = 9,
+    RGBONREST_PLUGIN_CONNECTION_FAILED = 10,
+    RGBONREST_PLUGIN_VERSION_MISMATCH = 11
+};
+
+/**
+ * A struct that a plugin fills for each of its devices.
+ * deviceType is a DeviceType value, name is a null terminated UTF-8 string.
+ */
+typedef struct rgbonrestPluginDevice {
+    char name[RGBONREST_PLUGIN_DEVICE_NAME_SIZE];
+    int32_t deviceType;
+} RGBonRESTPluginDevice;
+
+/**
+ * A struct that stores the color of a single LED, as handed to setLeds.
+ * ledId is one of the ids that getLedIds returned for the device.
+ */
+typedef struct rgbonrestPluginLed {
+    int32_t ledId;
+    int32_t r;
+    int32_t g;
+    int32_t b;
+} RGBonRESTPluginLed;
+
+/**
+ * A struct of function pointers that a plugin hands to RGBonREST.
+ * Every function takes the instance that create returned, and is only ever called from a single thread at a time.
+ * Devices are addressed by their index from 0 to getDeviceCount() - 1, which must stay the same until disconnect.
+ * getLedIds and setLeds are optional and may be NULL, then the whole device is treated as a single LED.
+ */
+typedef struct rgbonrestPluginApi {
+    uint32_t abiVersion; // must be RGBONREST_PLUGIN_ABI_VERSION
+    const char* name; // name of the SDK, which also becomes the name of its endpoints
+
+    void* (*create)(void);
+    void (*destroy)(void* instance);
+    int32_t (*connect)(void* instance);
+    int32_t (*disconnect)(void* instance);
+    int32_t (*getDeviceCount)(void* instance);
+    int32_t (*getDevice)(void* instance, int32_t deviceIndex, RGBonRESTPluginDevice* device);
+    int32_t (*setRgb)(void* instance, int32_t deviceType, int32_t r, int32_t g, int32_t b);
+
+    int32_t (*getLedIds)(void* instance, int32_t deviceIndex, int32_t* ledIds, int32_t capacity); // returns LED count, -1 on error
+    int32_t (*setLeds)(void* instance, int32_t deviceIndex, const RGBonRESTPluginLed* leds, int32_t count);
+} RGBonRESTPluginApi;
+
+/**
+ * The only symbol that a plugin exports, named RGBONREST_PLUGIN_ENTRY_NAME.
+ * RGBonREST passes the ABI version it was built with. A plugin that cannot speak that version returns NULL.
+ */
+typedef const RGBonRESTPluginApi* (*RGBonRESTPluginEntry)(uint32_t hostAbiVersion);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif //RGBONREST_RGBONRESTPLUGIN_H
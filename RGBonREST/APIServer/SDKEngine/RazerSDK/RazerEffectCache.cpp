@@ -0,0 +1,111 @@
+//
+// @file : RazerEffectCache.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class RazerEffectCache
+//
+
+#include "RazerEffectCache.h"
+
+
+/**
+ * A constructor member function for class RazerEffectCache.
+ * @param argCapacity the maximum number of effects to keep. At least 1 is always kept.
+ */
+RazerEffectCache::RazerEffectCache(size_t argCapacity) {
+    this->capacity = (argCapacity == 0) ? 1 : argCapacity;
+}
+
+/**
+ * A member function for class RazerEffectCache that looks up an effect.
+ * A found effect becomes the most recently used one.
+ * @param key the key of the effect.
+ * @param effectId the RZEFFECTID of the effect, set only when it was found.
+ * @return returns true if the effect was found, false if it has to be created.
+ */
+bool RazerEffectCache::find(const string& key, RZEFFECTID& effectId) {
+    auto found = this->entryIndex.find(key);
+    if (found == this->entryIndex.end()) {
+        this->missCount++;
+        return false;
+    }
+
+    this->entries.splice(this->entries.begin(), this->entries, found->second); // move to front, iterators stay valid.
+    effectId = found->second->second;
+    this->hitCount++;
+    return true;
+}
+
+/**
+ * A member function for class RazerEffectCache that remembers an effect that was just created.
+ * @param key the key of the effect. This must not be in the cache yet.
+ * @param effectId the RZEFFECTID that Chroma SDK created.
+ * @return returns effects that were evicted to make room. The caller has to DeleteEffect every one of them.
+ */
+vector<RZEFFECTID> RazerEffectCache::insert(const string& key, const RZEFFECTID& effectId) {
+    vector<RZEFFECTID> evicted;
+    while (this->entries.size() >= this->capacity) { // least recently used is at the back.
+        evicted.push_back(this->entries.back().second);
+        this->entryIndex.erase(this->entries.back().first);
+        this->entries.pop_back();
+        this->evictionCount++;
+    }
+
+    this->entries.emplace_front(key, effectId);
+    this->entryIndex[key] = this->entries.begin();
+    this->cachedCount = this->entries.size();
+    return evicted;
+}
+
+/**
+ * A member function for class RazerEffectCache that returns an effect, creating it only if it was not found.
+ * Effects that were evicted to make room for a created one are deleted right away, so that Chroma SDK never keeps
+ * more than capacity of them alive.
+ * @param key the key of the effect, from makeKey.
+ * @param createEffect a function that creates the effect and stores its RZEFFECTID, when it was not found.
+ * @param deleteEffect a function that deletes an evicted effect, usually DeleteEffect of Chroma SDK.
+ * @param effectId the RZEFFECTID of the effect, set only when this returned RZRESULT_SUCCESS.
+ * @return returns RZRESULT_SUCCESS if the effect was found or created, otherwise the RZRESULT of createEffect.
+ */
+RZRESULT RazerEffectCache::acquire(const string& key, const function<RZRESULT(RZEFFECTID*)>& createEffect,
+                                   const function<RZRESULT(RZEFFECTID)>& deleteEffect, RZEFFECTID& effectId) {
+    if (this->find(key, effectId)) return RZRESULT_SUCCESS; // create only once
+
+    RZRESULT result = createEffect(&effectId);
+    if (result != RZRESULT_SUCCESS) return result;
+
+    for (auto const& x : this->insert(key, effectId))
+        deleteEffect(x);
+    return RZRESULT_SUCCESS;
+}
+
+/**
+ * A member function for class RazerEffectCache that forgets every effect.
+ * This is for when Chroma SDK is about to UnInit, since effects are gone after that.
+ * @return returns every effect that was in the cache. The caller has to DeleteEffect every one of them.
+ */
+vector<RZEFFECTID> RazerEffectCache::clear() {
+    vector<RZEFFECTID> removed;
+    for (auto const& x : this->entries)
+        removed.push_back(x.second);
+
+    this->entries.clear();
+    this->entryIndex.clear();
+    this->cachedCount = 0;
+    return removed;
+}
+
+/**
+ * A static member function for class RazerEffectCache that builds the key of an effect.
+ * @param effectClass the Create...Effect function that creates the effect, as a RazerEffectClass.
+ * @param effectType the EFFECT_TYPE of the effect, for example CHROMA_STATIC.
+ * @param param the parameters that make this effect different from others of the same type, for example a color.
+ * @param paramSize the size of param in bytes.
+ * @return returns a key that is the same only for effects that are the same.
+ */
+string RazerEffectCache::makeKey(int effectClass, int effectType, const void* param, size_t paramSize) {
+    string key;
+    key.push_back((char) effectClass);
+    key.append((const char*) &effectType, sizeof(effectType));
+    key.append((const char*) param, paramSize);
+    return key;
+}
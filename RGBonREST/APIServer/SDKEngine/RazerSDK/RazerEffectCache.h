@@ -0,0 +1,59 @@
+//
+// @file : RazerEffectCache.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class RazerEffectCache
+//
+
+#ifndef RGBONREST_RAZEREFFECTCACHE_H
+#define RGBONREST_RAZEREFFECTCACHE_H
+#pragma once
+
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "./includes/RzChromaSDKTypes.h"
+#include "./includes/RzErrors.h"
+
+using std::string;
+using std::list;
+using std::map;
+using std::vector;
+using std::pair;
+using std::atomic;
+using std::function;
+
+
+/**
+ * A class that remembers effects that were created with Chroma SDK, so that the same effect is never created twice.
+ * Effects are looked up by a key that RazerSDK builds from the device class and the parameters of the effect.
+ * At most capacity effects are kept. When a new one does not fit, the one that was used least recently is evicted,
+ * and the caller has to DeleteEffect it.
+ * This is only used from the executor of RazerSDK, so only the counters are safe to read from other threads.
+ */
+class RazerEffectCache {
+private:
+    size_t capacity;
+    list<pair<string, RZEFFECTID>> entries; // most recently used first.
+    map<string, list<pair<string, RZEFFECTID>>::iterator> entryIndex;
+public:
+    atomic<uint64_t> hitCount{0};
+    atomic<uint64_t> missCount{0};
+    atomic<uint64_t> evictionCount{0};
+    atomic<uint64_t> cachedCount{0};
+
+    explicit RazerEffectCache(size_t);
+    bool find(const string&, RZEFFECTID&);
+    vector<RZEFFECTID> insert(const string&, const RZEFFECTID&);
+    RZRESULT acquire(const string&, const function<RZRESULT(RZEFFECTID*)>&, const function<RZRESULT(RZEFFECTID)>&,
+                     RZEFFECTID&);
+    vector<RZEFFECTID> clear();
+    static string makeKey(int, int, const void*, size_t);
+};
+
+
+#endif //RGBONREST_RAZEREFFECTCACHE_H
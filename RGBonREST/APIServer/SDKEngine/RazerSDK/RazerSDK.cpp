@@ -223,10 +223,14 @@ void RazerSDK::connect() {
 
 /**
  * A disconnect member function that performs UnInit for RazerSDK.
+ * Every effect that was kept for reuse and every animation is deleted first.
  * @throws SDKExceptions::SDKUnexpectedError: when this->UnInit() was not RZRESULT_SUCCESS.
  */
 void RazerSDK::disconnect() {
     this->isConnected = false;
+    this->deleteCachedEffects(); // effects are gone after UnInit anyway
+    while (!this->animations.empty())
+        this->deleteAnimation(this->animations.begin()->first);
     if (this->UnInit() == RZRESULT_SUCCESS) return;
     else throw SDKExceptions::SDKUnexpectedError();
 }
@@ -289,14 +293,16 @@ void RazerSDK::setRGB(DeviceType argDeviceType, int r, int g, int b) {
  * @return returns 1 if successfully set RGB.
  */
 int RazerSDK::setMouseRgb(int r, int g, int b) {
-    ChromaSDK::Mouse::STATIC_EFFECT_TYPE StaticEffect = {};
-    RZEFFECTID EffectId;
-
-    StaticEffect.Color = RGB(r, g, b);
-    StaticEffect.LEDId = ChromaSDK::Mouse::RZLED_ALL;
-
-    this->CreateMouseEffect(ChromaSDK::Mouse::CHROMA_STATIC, &StaticEffect, &EffectId);
-    return translateRzResult(this->SetEffect(EffectId));
+    COLORREF color = RGB(r, g, b);
+    this->fillLedFrame(RazerMouseEffect, color); // so that set_leds starts from this color
+
+    return translateRzResult(this->applyEffect(RazerMouseEffect, ChromaSDK::Mouse::CHROMA_STATIC, &color, sizeof(color),
+                                               [this, color](RZEFFECTID* effectId) {
+        ChromaSDK::Mouse::STATIC_EFFECT_TYPE StaticEffect = {};
+        StaticEffect.Color = color;
+        StaticEffect.LEDId = ChromaSDK::Mouse::RZLED_ALL;
+        return this->CreateMouseEffect(ChromaSDK::Mouse::CHROMA_STATIC, &StaticEffect, effectId);
+    }));
 }
 
 /**
@@ -311,13 +317,15 @@ int RazerSDK::setMouseRgb(int r, int g, int b) {
  * @return returns 1 if successfully set RGB.
  */
 int RazerSDK::setKeyboardRgb(int r, int g, int b) {
-    ChromaSDK::Keyboard::STATIC_EFFECT_TYPE StaticEffect = {};
-    RZEFFECTID EffectId;
-
-    StaticEffect.Color = RGB(r, g, b);
-
-    CreateKeyboardEffect(ChromaSDK::Keyboard::CHROMA_STATIC, &StaticEffect, &EffectId);
-    return translateRzResult(this->SetEffect(EffectId));
+    COLORREF color = RGB(r, g, b);
+    this->fillLedFrame(RazerKeyboardEffect, color); // so that set_leds starts from this color
+
+    return translateRzResult(this->applyEffect(RazerKeyboardEffect, ChromaSDK::Keyboard::CHROMA_STATIC, &color,
+                                               sizeof(color), [this, color](RZEFFECTID* effectId) {
+        ChromaSDK::Keyboard::STATIC_EFFECT_TYPE StaticEffect = {};
+        StaticEffect.Color = color;
+        return this->CreateKeyboardEffect(ChromaSDK::Keyboard::CHROMA_STATIC, &StaticEffect, effectId);
+    }));
 }
 
 /**
@@ -331,13 +339,15 @@ int RazerSDK::setKeyboardRgb(int r, int g, int b) {
  * @return returns 1 if successfully set RGB.
  */
 int RazerSDK::setHeadsetRgb(int r, int g, int b) {
-    ChromaSDK::Headset::STATIC_EFFECT_TYPE StaticEffect = {};
-    RZEFFECTID EffectId;
-
-    StaticEffect.Color = RGB(r, g, b);
-
-    CreateHeadsetEffect(ChromaSDK::Headset::CHROMA_STATIC, &StaticEffect, &EffectId);
-    return translateRzResult(this->SetEffect(EffectId));
+    COLORREF color = RGB(r, g, b);
+    this->fillLedFrame(RazerHeadsetEffect, color); // so that set_leds starts from this color
+
+    return translateRzResult(this->applyEffect(RazerHeadsetEffect, ChromaSDK::Headset::CHROMA_STATIC, &color,
+                                               sizeof(color), [this, color](RZEFFECTID* effectId) {
+        ChromaSDK::Headset::STATIC_EFFECT_TYPE StaticEffect = {};
+        StaticEffect.Color = color;
+        return this->CreateHeadsetEffect(ChromaSDK::Headset::CHROMA_STATIC, &StaticEffect, effectId);
+    }));
 }
 
 /**
@@ -351,13 +361,15 @@ int RazerSDK::setHeadsetRgb(int r, int g, int b) {
  * @return returns 1 if successfully set RGB.
  */
 int RazerSDK::setMouseMatRgb(int r, int g, int b) {
-    ChromaSDK::Mousepad::STATIC_EFFECT_TYPE StaticEffect = {};
-    RZEFFECTID EffectId;
-
-    StaticEffect.Color = RGB(r, g, b);
-
-    CreateMousepadEffect(ChromaSDK::Mousepad::CHROMA_STATIC, &StaticEffect, &EffectId);
-    return translateRzResult(this->SetEffect(EffectId));
+    COLORREF color = RGB(r, g, b);
+    this->fillLedFrame(RazerMousepadEffect, color); // so that set_leds starts from this color
+
+    return translateRzResult(this->applyEffect(RazerMousepadEffect, ChromaSDK::Mousepad::CHROMA_STATIC, &color,
+                                               sizeof(color), [this, color](RZEFFECTID* effectId) {
+        ChromaSDK::Mousepad::STATIC_EFFECT_TYPE StaticEffect = {};
+        StaticEffect.Color = color;
+        return this->CreateMousepadEffect(ChromaSDK::Mousepad::CHROMA_STATIC, &StaticEffect, effectId);
+    }));
 }
 
 /**
@@ -374,19 +386,22 @@ int RazerSDK::setMouseMatRgb(int r, int g, int b) {
  * @return returns 1 if successfully set RGB.
  */
 int RazerSDK::setETCRgb(int r, int g, int b) {
-    ChromaSDK::Keypad::STATIC_EFFECT_TYPE KeypadStaticEffect = {};
-    ChromaSDK::ChromaLink::STATIC_EFFECT_TYPE ChromaLinkStaticEffect = {};
-    RZEFFECTID KeypadStaticEffectId;
-    RZEFFECTID ChromaLinkStaticEffectId;
-
-    KeypadStaticEffect.Color = RGB(r, g, b); // For Keypads
-    ChromaLinkStaticEffect.Color = RGB(r, g, b); // For ChromaLink
-
-    CreateKeypadEffect(ChromaSDK::Keypad::CHROMA_STATIC, &KeypadStaticEffect, &KeypadStaticEffectId);
-    CreateChromaLinkEffect(ChromaSDK::ChromaLink::CHROMA_STATIC, &KeypadStaticEffect, &ChromaLinkStaticEffectId);
-
-    int result1 = SetEffect(KeypadStaticEffectId);
-    int result2 = SetEffect(ChromaLinkStaticEffectId);
+    COLORREF color = RGB(r, g, b);
+    this->fillLedFrame(RazerKeypadEffect, color); // so that set_leds starts from this color
+    this->fillLedFrame(RazerChromaLinkEffect, color);
+
+    int result1 = this->applyEffect(RazerKeypadEffect, ChromaSDK::Keypad::CHROMA_STATIC, &color, sizeof(color),
+                                    [this, color](RZEFFECTID* effectId) { // For Keypads
+        ChromaSDK::Keypad::STATIC_EFFECT_TYPE KeypadStaticEffect = {};
+        KeypadStaticEffect.Color = color;
+        return this->CreateKeypadEffect(ChromaSDK::Keypad::CHROMA_STATIC, &KeypadStaticEffect, effectId);
+    });
+    int result2 = this->applyEffect(RazerChromaLinkEffect, ChromaSDK::ChromaLink::CHROMA_STATIC, &color, sizeof(color),
+                                    [this, color](RZEFFECTID* effectId) { // For ChromaLink
+        ChromaSDK::ChromaLink::STATIC_EFFECT_TYPE ChromaLinkStaticEffect = {};
+        ChromaLinkStaticEffect.Color = color;
+        return this->CreateChromaLinkEffect(ChromaSDK::ChromaLink::CHROMA_STATIC, &ChromaLinkStaticEffect, effectId);
+    });
 
     if ((result1 == result2) && (result1 == 0)) return 1; // When all successfully set RGB
     else if ((result1 == result2) && (result1 != 0)) throw SDKExceptions::AllRGBFailed(); // When some set RGB
@@ -421,6 +436,321 @@ void RazerSDK::setAllRgb(int r, int g, int b) {
     else throw SDKExceptions::AllRGBFailed();
 }
 
+/**
+ * A member function that sets an effect, creating it with Chroma SDK only if the same effect was not created before.
+ * Effects are kept in effectCache, keyed by effectClass, effectType and the bytes of param. When effectCache is full,
+ * the effect that was used least recently is deleted with DeleteEffect.
+ * @param effectClass the Create...Effect function that createEffect calls.
+ * @param effectType the EFFECT_TYPE that createEffect creates, for example CHROMA_STATIC.
+ * @param param the parameters that make this effect different from others of the same type, for example a color.
+ * @param paramSize the size of param in bytes.
+ * @param createEffect a function that creates the effect and stores its RZEFFECTID, when it was not found.
+ * @return returns the RZRESULT of creating the effect if that failed, otherwise the RZRESULT of SetEffect.
+ */
+RZRESULT RazerSDK::applyEffect(RazerEffectClass effectClass, int effectType, const void* param, size_t paramSize,
+                               const function<RZRESULT(RZEFFECTID*)>& createEffect) {
+    string key = RazerEffectCache::makeKey(effectClass, effectType, param, paramSize);
+    RZEFFECTID effectId;
+    RZRESULT result = this->effectCache.acquire(key, createEffect, this->DeleteEffect, effectId);
+    if (result != RZRESULT_SUCCESS) return result;
+    return this->SetEffect(effectId);
+}
+
+/**
+ * A member function that deletes every effect that effectCache kept.
+ */
+void RazerSDK::deleteCachedEffects() {
+    vector<RZEFFECTID> effectIds = this->effectCache.clear();
+    if (this->DeleteEffect == nullptr) return; // DLL was never loaded
+
+    for (auto const& x : effectIds)
+        this->DeleteEffect(x);
+}
+
+/**
+ * A member function for class RazerSDK that finds which Create...Effect function sets a device.
+ * Keypads and ChromaLink devices are both ETC, so they are told apart by their RZDEVICEID.
+ * @param device the device to find the effect class of.
+ * @return returns the RazerEffectClass of the device.
+ */
+RazerEffectClass RazerSDK::getEffectClass(const Device* device) {
+    switch (device->deviceType) {
+        case DeviceType::Mouse:
+            return RazerMouseEffect;
+        case DeviceType::Keyboard:
+            return RazerKeyboardEffect;
+        case DeviceType::Headset:
+            return RazerHeadsetEffect;
+        case DeviceType::Mousemat:
+            return RazerMousepadEffect;
+        default: {
+            RZDEVICEID deviceName = getNthElementFromList(this->deviceNames, device->deviceIndex);
+            if ((deviceName == ChromaSDK::TARTARUS_CHROMA) || (deviceName == ChromaSDK::ORBWEAVER_CHROMA))
+                return RazerKeypadEffect;
+            else
+                return RazerChromaLinkEffect;
+        }
+    }
+}
+
+/**
+ * A static member function for class RazerSDK that returns how many LEDs the custom effect of a class has.
+ * Grids are counted as rows * columns.
+ * @param effectClass the RazerEffectClass to count LEDs of.
+ * @return returns the number of LEDs.
+ */
+size_t RazerSDK::getLedCount(RazerEffectClass effectClass) {
+    switch (effectClass) {
+        case RazerMouseEffect:
+            return ChromaSDK::Mouse::MAX_LEDS2; // 9 x 7 grid of CHROMA_CUSTOM2
+        case RazerKeyboardEffect:
+            return ChromaSDK::Keyboard::MAX_KEYS; // 6 x 22 grid
+        case RazerHeadsetEffect:
+            return ChromaSDK::Headset::MAX_LEDS;
+        case RazerMousepadEffect:
+            return ChromaSDK::Mousepad::MAX_LEDS;
+        case RazerKeypadEffect:
+            return ChromaSDK::Keypad::MAX_KEYS; // 4 x 5 grid
+        default:
+            return ChromaSDK::ChromaLink::MAX_LEDS;
+    }
+}
+
+/**
+ * A member function for class RazerSDK that returns the colors of every LED of a class, as they were set last time.
+ * @param effectClass the RazerEffectClass to get colors of.
+ * @return returns the colors, one for each LED. Grids are stored row by row.
+ */
+vector<COLORREF>& RazerSDK::getLedFrame(RazerEffectClass effectClass) {
+    vector<COLORREF>& ledFrame = this->ledFrames[effectClass];
+    if (ledFrame.empty())
+        ledFrame.resize(getLedCount(effectClass), RGB(0, 0, 0));
+    return ledFrame;
+}
+
+/**
+ * A member function for class RazerSDK that sets every LED of a class to the same color.
+ * This does not apply anything, it only remembers the color that a static effect just set.
+ * @param effectClass the RazerEffectClass to set colors of.
+ * @param color the color to set.
+ */
+void RazerSDK::fillLedFrame(RazerEffectClass effectClass, COLORREF color) {
+    vector<COLORREF>& ledFrame = this->getLedFrame(effectClass);
+    std::fill(ledFrame.begin(), ledFrame.end(), color);
+}
+
+/**
+ * A member function for class RazerSDK that creates a custom effect from the colors of every LED of a class.
+ * The colors are copied into the custom effect structure at once, since both are stored row by row.
+ * @param effectClass the RazerEffectClass to create the effect for.
+ * @param ledFrame the colors, one for each LED, as getLedFrame stores them.
+ * @param effectId the RZEFFECTID of the created effect.
+ * @return returns the RZRESULT of the Create...Effect function.
+ */
+RZRESULT RazerSDK::createLedFrameEffect(RazerEffectClass effectClass, const vector<COLORREF>& ledFrame,
+                                        RZEFFECTID* effectId) {
+    switch (effectClass) {
+        case RazerMouseEffect: {
+            ChromaSDK::Mouse::CUSTOM_EFFECT_TYPE2 CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateMouseEffect(ChromaSDK::Mouse::CHROMA_CUSTOM2, &CustomEffect, effectId);
+        }
+        case RazerKeyboardEffect: {
+            ChromaSDK::Keyboard::CUSTOM_EFFECT_TYPE CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateKeyboardEffect(ChromaSDK::Keyboard::CHROMA_CUSTOM, &CustomEffect, effectId);
+        }
+        case RazerHeadsetEffect: {
+            ChromaSDK::Headset::CUSTOM_EFFECT_TYPE CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateHeadsetEffect(ChromaSDK::Headset::CHROMA_CUSTOM, &CustomEffect, effectId);
+        }
+        case RazerMousepadEffect: {
+            ChromaSDK::Mousepad::CUSTOM_EFFECT_TYPE CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateMousepadEffect(ChromaSDK::Mousepad::CHROMA_CUSTOM, &CustomEffect, effectId);
+        }
+        case RazerKeypadEffect: {
+            ChromaSDK::Keypad::CUSTOM_EFFECT_TYPE CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateKeypadEffect(ChromaSDK::Keypad::CHROMA_CUSTOM, &CustomEffect, effectId);
+        }
+        default: {
+            ChromaSDK::ChromaLink::CUSTOM_EFFECT_TYPE CustomEffect = {};
+            memcpy(CustomEffect.Color, ledFrame.data(), sizeof(CustomEffect.Color));
+            return this->CreateChromaLinkEffect(ChromaSDK::ChromaLink::CHROMA_CUSTOM, &CustomEffect, effectId);
+        }
+    }
+}
+
+/**
+ * A member function for class RazerSDK that applies the colors of every LED of a class as one custom effect.
+ * @param effectClass the RazerEffectClass to apply.
+ * @return returns the RZRESULT of applyEffect.
+ */
+RZRESULT RazerSDK::applyLedFrame(RazerEffectClass effectClass) {
+    const vector<COLORREF>& ledFrame = this->getLedFrame(effectClass);
+    int effectType = (effectClass == RazerMouseEffect) ? (int) ChromaSDK::Mouse::CHROMA_CUSTOM2 : (int) ChromaSDK::CHROMA_CUSTOM;
+
+    return this->applyEffect(effectClass, effectType, ledFrame.data(), ledFrame.size() * sizeof(COLORREF),
+                             [this, effectClass, &ledFrame](RZEFFECTID* effectId) {
+        return this->createLedFrameEffect(effectClass, ledFrame, effectId);
+    });
+}
+
+/**
+ * A member function for class RazerSDK that creates an effect for every frame of an animation.
+ * Each frame starts from the colors of the frame before it, and the first frame starts from the current colors.
+ * Frames are not put into effectCache, they are kept until deleteAnimation so that showAnimationFrame is only a
+ * SetEffect call.
+ * @param device the device to play the animation on. Every device of the same class shows it.
+ * @param frames the LEDs to set in each frame, with ids from getLedIds. LED ids that the device does not have are ignored.
+ * @return returns the id of the animation.
+ * @throws SDKExceptions::SDKNotConnected: When SDK was not connected before.
+ * @throws SDKExceptions::InvalidAnimation: When there were no frames or more than RAZER_ANIMATION_MAX_FRAMES.
+ * @throws SDKExceptions::InvalidRGBValue: When a color was not from 0 to 255.
+ * @throws SDKExceptions::SDKServiceNotRunning: when SDK could not find Razer Chroma software running.
+ * @throws SDKExceptions::NoDevicesConnected: when SDK could not find any Razer devices connected.
+ * @throws SDKExceptions::SDKUnexpectedError: when SDK encountered unexpected error.
+ */
+int RazerSDK::uploadAnimation(const Device* device, const vector<vector<LedColor>>& frames) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (frames.empty() || frames.size() > RAZER_ANIMATION_MAX_FRAMES) throw SDKExceptions::InvalidAnimation();
+    for (auto const& x : frames)
+        for (auto const& y : x)
+            if (!(((y.r >= 0) && (y.r <= 255)) && ((y.g >= 0) && (y.g <= 255)) && ((y.b >= 0) && (y.b <= 255))))
+                throw SDKExceptions::InvalidRGBValue();
+
+    RazerAnimation animation;
+    animation.effectClass = this->getEffectClass(device);
+    vector<COLORREF> ledFrame = this->getLedFrame(animation.effectClass); // copy, the current colors stay as they are
+
+    for (auto const& x : frames) {
+        for (auto const& y : x) {
+            if ((y.ledId < 0) || ((size_t) y.ledId >= ledFrame.size())) continue; // no such LED
+            ledFrame[y.ledId] = RGB(y.r, y.g, y.b);
+        }
+
+        RZEFFECTID effectId;
+        RZRESULT result = this->createLedFrameEffect(animation.effectClass, ledFrame, &effectId);
+        if (result != RZRESULT_SUCCESS) { // delete frames that were created already
+            for (auto const& y : animation.effectIds)
+                this->DeleteEffect(y);
+            translateRzResult(result);
+        }
+        animation.effectIds.push_back(effectId);
+    }
+
+    int animationId = this->nextAnimationId++;
+    this->animations[animationId] = animation;
+    return animationId;
+}
+
+/**
+ * A member function for class RazerSDK that shows a frame of an animation with a single SetEffect.
+ * @param animationId the id from uploadAnimation.
+ * @param frame the index of the frame. Indices past the last frame wrap around, so animations loop.
+ * @throws SDKExceptions::SDKNotConnected: When SDK was not connected before.
+ * @throws SDKExceptions::InvalidAnimation: When there was no animation with animationId.
+ * @throws the same exceptions as translateRzResult when SetEffect failed.
+ */
+void RazerSDK::showAnimationFrame(int animationId, size_t frame) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    auto found = this->animations.find(animationId);
+    if (found == this->animations.end()) throw SDKExceptions::InvalidAnimation();
+
+    const vector<RZEFFECTID>& effectIds = found->second.effectIds;
+    translateRzResult(this->SetEffect(effectIds[frame % effectIds.size()]));
+}
+
+/**
+ * A member function for class RazerSDK that deletes the effect of every frame of an animation.
+ * Devices keep showing whatever frame they showed last.
+ * @param animationId the id from uploadAnimation.
+ * @throws SDKExceptions::InvalidAnimation: When there was no animation with animationId.
+ */
+void RazerSDK::deleteAnimation(int animationId) {
+    auto found = this->animations.find(animationId);
+    if (found == this->animations.end()) throw SDKExceptions::InvalidAnimation();
+
+    if (this->DeleteEffect != nullptr)
+        for (auto const& x : found->second.effectIds)
+            this->DeleteEffect(x);
+    this->animations.erase(found);
+}
+
+/**
+ * A member function for class RazerSDK that returns the ids of every LED of a device.
+ * Ids are positions in the custom effect of the device. Grids are numbered row by row, so the key at row 2 and
+ * column 3 of a keyboard is 2 * 22 + 3.
+ * @param device the device to get LEDs of.
+ * @return returns ids from 0 to the number of LEDs - 1.
+ */
+vector<int> RazerSDK::getLedIds(const Device* device) {
+    vector<int> ledIds;
+    size_t ledCount = getLedCount(this->getEffectClass(device));
+    for (size_t i = 0 ; i < ledCount ; i++)
+        ledIds.push_back((int) i);
+    return ledIds;
+}
+
+/**
+ * A member function for class RazerSDK that sets colors of some LEDs of a device.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with ids from getLedIds.
+ * @throws the same exceptions as setLedColorsBatch.
+ */
+void RazerSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    this->setLedColorsBatch(vector<DeviceLedColors>{DeviceLedColors{device, leds}});
+}
+
+/**
+ * A member function for class RazerSDK that sets colors of LEDs of several devices.
+ * Only the given LEDs change, the rest keep the color they had. Every device class that changed is applied with a
+ * single custom effect. Chroma SDK sets every device of a class at once, so devices of the same class share colors.
+ * LED ids that the device does not have are ignored.
+ * @param deviceLeds the devices and their LEDs to set.
+ * @throws SDKExceptions::SDKNotConnected: When SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: When a color was not from 0 to 255. Nothing is set in this case.
+ * @throws SDKExceptions::SDKServiceNotRunning: when SDK could not find Razer Chroma software running.
+ * @throws SDKExceptions::NoDevicesConnected: when SDK could not find any Razer devices connected.
+ * @throws SDKExceptions::SDKUnexpectedError: when SDK encountered unexpected error.
+ */
+void RazerSDK::setLedColorsBatch(const vector<DeviceLedColors>& deviceLeds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    for (auto const& x : deviceLeds)
+        for (auto const& y : x.leds)
+            if (!(((y.r >= 0) && (y.r <= 255)) && ((y.g >= 0) && (y.g <= 255)) && ((y.b >= 0) && (y.b <= 255))))
+                throw SDKExceptions::InvalidRGBValue();
+
+    set<RazerEffectClass> changedClasses;
+    for (auto const& x : deviceLeds) {
+        RazerEffectClass effectClass = this->getEffectClass(x.device);
+        vector<COLORREF>& ledFrame = this->getLedFrame(effectClass);
+        for (auto const& y : x.leds) {
+            if ((y.ledId < 0) || ((size_t) y.ledId >= ledFrame.size())) continue; // no such LED
+            ledFrame[y.ledId] = RGB(y.r, y.g, y.b);
+            changedClasses.insert(effectClass);
+        }
+    }
+
+    for (auto const& x : changedClasses) // one SetEffect for each class
+        translateRzResult(this->applyLedFrame(x));
+}
+
+/**
+ * A member function for class RazerSDK that returns counters of effectCache.
+ * @return returns effect_cache_hits, effect_cache_misses, effect_cache_evictions and effect_cache_size.
+ */
+map<string, uint64_t> RazerSDK::getStatistics() {
+    map<string, uint64_t> statistics;
+    statistics["effect_cache_hits"] = this->effectCache.hitCount.load();
+    statistics["effect_cache_misses"] = this->effectCache.missCount.load();
+    statistics["effect_cache_evictions"] = this->effectCache.evictionCount.load();
+    statistics["effect_cache_size"] = this->effectCache.cachedCount.load();
+    return statistics;
+}
+
 /**
  * A method that counts total connected devices using isConnected
  * This also generates all this->deviceNames list which contains all CHROMA available devices' name in const char *
@@ -15,15 +15,38 @@
 #include <wtypes.h>
 #include <list>
 #include <vector>
+#include <string>
+#include <set>
+#include <cstring>
+#include <functional>
 
 #include "./includes/RzChromaSDKTypes.h"
 #include "./includes/RzChromaSDKTypes.h"
 #include "./includes/RzErrors.h"
 #include "../AbstractSDK.h"
+#include "../../Utils/Defines.h"
+#include "./RazerEffectCache.h"
 
 using std::vector;
 using std::list;
 using std::pair;
+using std::string;
+using std::function;
+using std::set;
+
+/**
+ * An enum that represents which Create...Effect function of Chroma SDK an effect was created with.
+ */
+enum RazerEffectClass {RazerMouseEffect, RazerKeyboardEffect, RazerHeadsetEffect, RazerMousepadEffect,
+        RazerKeypadEffect, RazerChromaLinkEffect};
+
+/**
+ * A struct that stores an animation, which is an effect for every frame that was created when it was uploaded.
+ */
+typedef struct razerAnimation {
+    RazerEffectClass effectClass;
+    vector<RZEFFECTID> effectIds;
+} RazerAnimation;
 
 
 class RazerSDK : public AbstractSDK {
@@ -57,6 +80,10 @@ private:
     QUERYDEVICE QueryDevice = nullptr;
     HMODULE m_ChromaSDKModule = nullptr;
     list<RZDEVICEID> deviceNames;
+    RazerEffectCache effectCache{RAZER_EFFECT_CACHE_SIZE};
+    map<RazerEffectClass, vector<COLORREF>> ledFrames; // color of every LED, in the order custom effects store them.
+    map<int, RazerAnimation> animations;
+    int nextAnimationId = 1;
 
     int deviceCount = 0;
 
@@ -66,6 +93,14 @@ private:
     int setMouseMatRgb(int, int, int);
     int setETCRgb(int, int, int);
     void setAllRgb(int, int, int);
+    RZRESULT applyEffect(RazerEffectClass, int, const void*, size_t, const function<RZRESULT(RZEFFECTID*)>&);
+    void deleteCachedEffects();
+    RazerEffectClass getEffectClass(const Device*);
+    vector<COLORREF>& getLedFrame(RazerEffectClass);
+    void fillLedFrame(RazerEffectClass, COLORREF);
+    RZRESULT createLedFrameEffect(RazerEffectClass, const vector<COLORREF>&, RZEFFECTID*);
+    RZRESULT applyLedFrame(RazerEffectClass);
+    static size_t getLedCount(RazerEffectClass);
     void setAllDeviceInfo();
     void setDeviceCount();
     void initDeviceNames();
@@ -82,6 +117,13 @@ public:
     void disconnect() override;
     void setRGB(DeviceType, int, int, int) override;
     map<DeviceType, list<Device*>*> getDevices() override;
+    vector<int> getLedIds(const Device*) override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+    void setLedColorsBatch(const vector<DeviceLedColors>&) override;
+    int uploadAnimation(const Device*, const vector<vector<LedColor>>&) override;
+    void showAnimationFrame(int, size_t) override;
+    void deleteAnimation(int) override;
+    map<string, uint64_t> getStatistics() override;
 };
 
 
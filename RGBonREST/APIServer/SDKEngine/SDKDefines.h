@@ -10,9 +10,11 @@
 
 #include <string>
 #include <exception>
+#include <vector>
 
 using std::string;
 using std::exception;
+using std::vector;
 
 
 enum DeviceType {
@@ -38,6 +40,49 @@ typedef struct device{
     int deviceIndex = 0;
 } Device;
 
+/**
+ * A struct that stores a single set RGB command, which is one item of a batch.
+ */
+typedef struct rgbCommand {
+    DeviceType deviceType;
+    int r;
+    int g;
+    int b;
+} RGBCommand;
+
+/**
+ * A struct that stores the color of a single LED of a device.
+ * ledId is whatever id the SDK uses for that LED, as returned by AbstractSDK::getLedIds.
+ */
+typedef struct ledColor {
+    int ledId;
+    int r;
+    int g;
+    int b;
+} LedColor;
+
+/**
+ * A struct that stores colors of some LEDs of a single device.
+ */
+typedef struct deviceLedColors {
+    const Device* device;
+    vector<LedColor> leds;
+} DeviceLedColors;
+
+/**
+ * An enum that represents the result of a single command in a batch.
+ * Each value matches one of the exceptions that AbstractSDK::setRGB can throw.
+ */
+enum CommandResult {
+    CommandSuccess = 0,
+    CommandSomeRGBFailed = 1,
+    CommandAllRGBFailed = 2,
+    CommandInvalidDeviceType = 3,
+    CommandInvalidRGBValue = 4,
+    CommandSDKNotConnected = 5,
+    CommandUnexpectedError = 6
+};
+
 class SDKExceptions {
 public:
     class SDKAlreadyConnected : public exception {
@@ -72,6 +117,12 @@ public:
 
     class SomeRGBFailed : public exception {
     };
+
+    class AnimationNotSupported : public exception {
+    };
+
+    class InvalidAnimation : public exception {
+    };
 };
 
 #endif //RGBONREST_SDKDEFINES_H
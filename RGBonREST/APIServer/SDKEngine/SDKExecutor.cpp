@@ -0,0 +1,152 @@
+//
+// @file : SDKExecutor.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class SDKExecutor
+//
+
+#include "SDKExecutor.h"
+
+
+/**
+ * A constructor member function for class SDKExecutor.
+ * This starts the worker thread right away.
+ * @param argCapacity how many jobs can wait in the queue at once.
+ */
+SDKExecutor::SDKExecutor(size_t argCapacity) {
+    this->capacity = argCapacity;
+    this->exitFlag = false;
+    this->workerThread = new thread(&SDKExecutor::workerLoop, this);
+}
+
+/**
+ * A destructor member function for class SDKExecutor.
+ * This stops the worker thread if it is still running.
+ */
+SDKExecutor::~SDKExecutor() {
+    this->stop();
+}
+
+/**
+ * A member function for class SDKExecutor that queues a job to run on the worker thread.
+ * Jobs run one at a time, in the order they were submitted.
+ * @param job the job to run. Jobs should catch their own exceptions.
+ * @return returns true if the job was queued, false if the queue was full or the executor was stopped.
+ */
+bool SDKExecutor::submit(const function<void()>& job) {
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        if (this->exitFlag || this->jobs.size() >= this->capacity) {
+            this->refusedCount++;
+            return false;
+        }
+        this->jobs.push_back({-1, job, nullptr});
+    }
+    this->queueCondition.notify_one();
+    return true;
+}
+
+/**
+ * A member function for class SDKExecutor that queues a job which replaces any waiting job with the same key.
+ * The replaced job is removed from its place and this job goes to the back of the queue, so that jobs for other keys
+ * that were submitted in between still run before it. The supersede function of the replaced job is called.
+ * @param key the target of the job, for example a DeviceType. Must not be negative.
+ * @param job the job to run. Jobs should catch their own exceptions.
+ * @param supersede the function to call instead of job if a newer job with the same key replaces it.
+ * @return returns true if the job was queued, false if the queue was full or the executor was stopped.
+ */
+bool SDKExecutor::submitLatest(int key, const function<void()>& job, const function<void()>& supersede) {
+    function<void()> superseded; // called after unlocking, since it might reply to a request
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        if (this->exitFlag) {
+            this->refusedCount++;
+            return false;
+        }
+
+        auto found = this->keyedJobs.find(key);
+        if (found != this->keyedJobs.end()) { // replace the waiting job for this key
+            superseded = found->second->supersede;
+            this->jobs.erase(found->second);
+            this->keyedJobs.erase(found);
+            this->supersededCount++;
+        } else if (this->jobs.size() >= this->capacity) {
+            this->refusedCount++;
+            return false;
+        }
+
+        this->jobs.push_back({key, job, supersede});
+        this->keyedJobs[key] = std::prev(this->jobs.end());
+    }
+    this->queueCondition.notify_one();
+
+    if (superseded) superseded();
+    return true;
+}
+
+/**
+ * A member function for class SDKExecutor that returns how many jobs are waiting.
+ * @return returns the number of jobs in the queue, not counting the one that is running.
+ */
+size_t SDKExecutor::getQueueLength() {
+    lock_guard<mutex> lock(this->queueMutex);
+    return this->jobs.size();
+}
+
+/**
+ * A member function for class SDKExecutor that sets a function to call on the worker thread after every job.
+ * This lets a component that caches state of the SDK see every change to it, in the same order as the SDK does.
+ * @param listener the function to call with the key of the job that ran, -1 for jobs without a key. It must not
+ * submit jobs to this executor.
+ */
+void SDKExecutor::setJobListener(const function<void(int)>& listener) {
+    lock_guard<mutex> lock(this->queueMutex);
+    this->jobListener = listener;
+}
+
+/**
+ * A member function for class SDKExecutor that stops the worker thread.
+ * Jobs that were already queued still run, so that everyone waiting for them gets an answer.
+ */
+void SDKExecutor::stop() {
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        this->exitFlag = true;
+    }
+    this->queueCondition.notify_one();
+
+    if (this->workerThread != nullptr) {
+        this->workerThread->join();
+        delete this->workerThread;
+        this->workerThread = nullptr;
+    }
+}
+
+/**
+ * A member function for class SDKExecutor that runs jobs until stop() was called and the queue is empty.
+ */
+void SDKExecutor::workerLoop() {
+    while (true) {
+        function<void()> job;
+        function<void(int)> listener;
+        int key;
+        {
+            unique_lock<mutex> lock(this->queueMutex);
+            this->queueCondition.wait(lock, [this] { return this->exitFlag || !this->jobs.empty(); });
+            if (this->jobs.empty()) return; // stopped and nothing left to run
+
+            if (this->jobs.front().key >= 0) // a running job can no longer be superseded
+                this->keyedJobs.erase(this->jobs.front().key);
+            key = this->jobs.front().key;
+            job = std::move(this->jobs.front().run);
+            listener = this->jobListener;
+            this->jobs.pop_front();
+        }
+
+        try {
+            job();
+        } catch (...) { // a job that throws must not take the worker down with it
+        }
+        if (listener) listener(key);
+        this->executedCount++;
+    }
+}
@@ -0,0 +1,77 @@
+//
+// @file : SDKExecutor.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class SDKExecutor
+//
+
+#ifndef RGBONREST_SDKEXECUTOR_H
+#define RGBONREST_SDKEXECUTOR_H
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+
+using std::thread;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
+using std::function;
+using std::atomic;
+using std::list;
+using std::map;
+
+
+/**
+ * A struct that stores a job that is waiting in SDKExecutor.
+ * Jobs with a key can be superseded by a newer job with the same key. When that happens, supersede is called instead
+ * of run so that whoever is waiting for the job still gets an answer.
+ */
+typedef struct executorJob {
+    int key;
+    function<void()> run;
+    function<void()> supersede;
+} ExecutorJob;
+
+/**
+ * A class that runs every command for a single SDK on a dedicated thread.
+ * Vendor SDKs are not meant to be called from several threads at once, and a slow SDK should not make requests for
+ * other SDKs wait. So each AbstractSDK owns one SDKExecutor, and everything that talks to that SDK submits a job here.
+ * The queue is bounded, so a stalled SDK makes new jobs be refused instead of piling up.
+ * Jobs that only set a target to a state, such as the color of a DeviceType, can be submitted with a key. Then there is
+ * at most one waiting job for that key, and a newer one replaces it, so the SDK always applies the freshest state.
+ */
+class SDKExecutor {
+private:
+    thread* workerThread;
+    mutex queueMutex;
+    condition_variable queueCondition;
+    list<ExecutorJob> jobs;
+    map<int, list<ExecutorJob>::iterator> keyedJobs; // key -> the waiting job with that key
+    function<void(int)> jobListener;
+    size_t capacity;
+    bool exitFlag;
+
+    void workerLoop();
+public:
+    atomic<uint64_t> executedCount{0};
+    atomic<uint64_t> supersededCount{0};
+    atomic<uint64_t> refusedCount{0};
+
+    explicit SDKExecutor(size_t);
+    ~SDKExecutor();
+    bool submit(const function<void()>&);
+    bool submitLatest(int, const function<void()>&, const function<void()>&);
+    size_t getQueueLength();
+    void setJobListener(const function<void(int)>&);
+    void stop();
+};
+
+
+#endif //RGBONREST_SDKEXECUTOR_H
@@ -0,0 +1,330 @@
+//
+// @file : SysfsSDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class SysfsSDK
+//
+
+#include "SysfsSDK.h"
+
+#ifdef __linux__
+
+
+/**
+ * A constructor member function for class SysfsSDK.
+ * Nothing is opened until connect is called.
+ * @param argLedsPath the directory with a node for every LED, which is /sys/class/leds unless testing.
+ */
+SysfsSDK::SysfsSDK(const string& argLedsPath) {
+    this->sdkName = "Sysfs";
+    this->isConnected = false;
+    this->ledsPath = argLedsPath;
+
+    this->devices[DeviceType::Keyboard] = new list<Device*>; // lists are refilled on every connect
+    this->devices[DeviceType::Mouse] = new list<Device*>;
+    this->devices[DeviceType::ETC] = new list<Device*>;
+}
+
+/**
+ * A destructor member function for class SysfsSDK.
+ * This closes every file that was still open, then deletes all Device objects and device lists.
+ */
+SysfsSDK::~SysfsSDK() {
+    this->closeFiles();
+
+    for (auto const& x : this->sysfsDevices)
+        delete x;
+    for (auto const& x : this->devices)
+        delete x.second;
+}
+
+/**
+ * A member function for class SysfsSDK that opens every LED node that can be written.
+ * Nodes whose files cannot be opened, usually because of permissions, are skipped.
+ * @throws SDKExceptions::SDKAlreadyConnected: when SDK was already connected.
+ * @throws SDKExceptions::NoDevicesConnected: when no LED node could be opened.
+ */
+void SysfsSDK::connect() {
+    if (this->isConnected) throw SDKExceptions::SDKAlreadyConnected();
+
+    this->setAllDeviceInfo();
+    if (this->leds.empty()) throw SDKExceptions::NoDevicesConnected();
+    this->isConnected = true;
+}
+
+/**
+ * A member function for class SysfsSDK that closes every LED node. LEDs keep whatever value they had.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+void SysfsSDK::disconnect() {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+
+    this->isConnected = false;
+    this->closeFiles();
+}
+
+/**
+ * A member function for class SysfsSDK that sets every LED of a DeviceType.
+ * @param deviceType the DeviceType to set RGB values. ALL sets every LED.
+ * @param r the R value.
+ * @param g the G value.
+ * @param b the B value.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a value was not from 0 to 255.
+ * @throws SDKExceptions::InvalidDeviceType: when deviceType was not a DeviceType.
+ * @throws SDKExceptions::SomeRGBFailed: when some writes failed, at the same time some did not.
+ * @throws SDKExceptions::AllRGBFailed: when every write failed.
+ */
+void SysfsSDK::setRGB(DeviceType deviceType, int r, int g, int b) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (!isValidRgb(r, g, b)) throw SDKExceptions::InvalidRGBValue();
+    if (deviceType < DeviceType::ALL || deviceType > DeviceType::RAM) throw SDKExceptions::InvalidDeviceType();
+
+    int successCount = 0;
+    int attemptCount = 0;
+    for (size_t i = 0 ; i < this->leds.size() ; i++) {
+        if (deviceType != DeviceType::ALL && this->sysfsDevices[i]->deviceType != deviceType) continue;
+        successCount += this->writeLed(this->leds[i], r, g, b);
+        attemptCount++;
+    }
+
+    if (successCount == attemptCount) return;
+    else if (successCount > 0) throw SDKExceptions::SomeRGBFailed();
+    else throw SDKExceptions::AllRGBFailed();
+}
+
+/**
+ * A member function for class SysfsSDK that returns member variable 'devices'.
+ * @return returns a map of list that represents pointer address to connected devices.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+map<DeviceType, list<Device*>*> SysfsSDK::getDevices() {
+    if (this->isConnected)
+        return this->devices;
+    else
+        throw SDKExceptions::SDKNotConnected();
+}
+
+/**
+ * A member function for class SysfsSDK that sets the color of a single LED node.
+ * Every node has a single LED with id 0, so the last LED with id 0 in leds wins.
+ * @param device the device of the LED node.
+ * @param leds the LEDs to set.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a value was not from 0 to 255.
+ * @throws SDKExceptions::AllRGBFailed: when the write failed.
+ */
+void SysfsSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (device->deviceIndex >= (int) this->leds.size()) return; // gone since the last connect
+
+    for (auto it = leds.rbegin() ; it != leds.rend() ; it++) {
+        if (it->ledId != 0) continue;
+        if (!isValidRgb(it->r, it->g, it->b)) throw SDKExceptions::InvalidRGBValue();
+        if (!this->writeLed(this->leds[device->deviceIndex], it->r, it->g, it->b)) throw SDKExceptions::AllRGBFailed();
+        return;
+    }
+}
+
+/**
+ * A member function for class SysfsSDK that returns counters of writes.
+ * @return returns writes, writes_skipped and writes_failed.
+ */
+map<string, uint64_t> SysfsSDK::getStatistics() {
+    map<string, uint64_t> statistics;
+    statistics["writes"] = this->writeCount.load();
+    statistics["writes_skipped"] = this->skippedWriteCount.load();
+    statistics["writes_failed"] = this->failedWriteCount.load();
+    return statistics;
+}
+
+/**
+ * A member function that opens every LED node under ledsPath into member variable devices, sorted by name.
+ * Device objects are reused by their index, so pointers that were handed out before stay valid.
+ */
+void SysfsSDK::setAllDeviceInfo() {
+    vector<string> names;
+    DIR* directory = opendir(this->ledsPath.c_str());
+    if (directory != nullptr) {
+        struct dirent* entry;
+        while ((entry = readdir(directory)) != nullptr)
+            if (entry->d_name[0] != '.') names.emplace_back(entry->d_name);
+        closedir(directory);
+    }
+    std::sort(names.begin(), names.end()); // readdir has no order
+
+    for (auto const& x : this->devices)
+        x.second->clear();
+    this->leds.clear();
+
+    for (auto const& name : names) {
+        SysfsLed led;
+        if (!this->openLed(name, led)) continue;
+
+        size_t index = this->leds.size();
+        if (index >= this->sysfsDevices.size()) this->sysfsDevices.push_back(new Device);
+        Device* tmpDevice = this->sysfsDevices[index];
+        tmpDevice->sdkName = this->sdkName;
+        tmpDevice->name = name;
+        tmpDevice->deviceType = translateDeviceType(name);
+        tmpDevice->deviceIndex = (int) index;
+        this->devices[tmpDevice->deviceType]->push_back(tmpDevice);
+        this->leds.push_back(led);
+    }
+}
+
+/**
+ * A member function that closes files of every LED node.
+ */
+void SysfsSDK::closeFiles() {
+    for (auto const& x : this->leds) {
+        close(x.brightnessFd);
+        if (x.intensityFd != -1) close(x.intensityFd);
+    }
+    this->leds.clear();
+}
+
+/**
+ * A member function that opens the files of a single LED node.
+ * @param name the name of the node under ledsPath.
+ * @param led the opened node is stored here.
+ * @return returns false if the node had no max_brightness, or brightness could not be opened for writing.
+ */
+bool SysfsSDK::openLed(const string& name, SysfsLed& led) {
+    string nodePath = this->ledsPath + "/" + name;
+    string content;
+    if (!readFile(nodePath + "/max_brightness", content)) return false;
+
+    led.name = name;
+    led.maxBrightness = (unsigned int) strtoul(content.c_str(), nullptr, 10);
+    led.intensityFd = -1;
+    led.brightnessFd = open((nodePath + "/brightness").c_str(), O_WRONLY | O_CLOEXEC);
+    if (led.maxBrightness == 0 || led.brightnessFd == -1) {
+        if (led.brightnessFd != -1) close(led.brightnessFd);
+        return false;
+    }
+
+    if (readFile(nodePath + "/multi_index", content)) { // multicolor node, like "red green blue"
+        led.intensityFd = open((nodePath + "/multi_intensity").c_str(), O_WRONLY | O_CLOEXEC);
+        size_t begin = 0;
+        while (led.intensityFd != -1 && begin < content.size()) {
+            size_t end = content.find_first_of(" \n", begin);
+            if (end == string::npos) end = content.size();
+            string channel = content.substr(begin, end - begin);
+            begin = end + 1;
+            if (channel.empty()) continue;
+
+            if (channel == "red") led.channels.push_back('r');
+            else if (channel == "green") led.channels.push_back('g');
+            else if (channel == "blue") led.channels.push_back('b');
+            else if (channel == "white") led.channels.push_back('w');
+            else led.channels.push_back('0');
+        }
+    }
+    return true;
+}
+
+/**
+ * A member function that writes a color into a single LED node.
+ * Multicolor nodes get each channel scaled to max_brightness and full brightness. Other nodes get the brightest of
+ * r, g and b as brightness.
+ * @param led the LED node to write.
+ * @param r the r value
+ * @param g the g value
+ * @param b the b value
+ * @return returns true if every write succeeded or was skipped.
+ */
+bool SysfsSDK::writeLed(SysfsLed& led, int r, int g, int b) {
+    bool isSuccess = true;
+    unsigned int brightness = (unsigned int) std::max(r, std::max(g, b));
+
+    if (led.intensityFd != -1) {
+        string intensity;
+        for (auto const& x : led.channels) {
+            unsigned int value = 0;
+            if (x == 'r') value = r;
+            else if (x == 'g') value = g;
+            else if (x == 'b') value = b;
+            else if (x == 'w') value = (unsigned int) std::min(r, std::min(g, b));
+
+            if (!intensity.empty()) intensity += " ";
+            intensity += std::to_string(value * led.maxBrightness / 255);
+        }
+        isSuccess = this->writeValue(led.intensityFd, intensity + "\n", led.lastIntensity);
+        brightness = (brightness == 0) ? 0 : 255; // color is in the intensities, so just turn it on or off
+    }
+
+    string brightnessValue = std::to_string(brightness * led.maxBrightness / 255) + "\n";
+    return this->writeValue(led.brightnessFd, brightnessValue, led.lastBrightness) && isSuccess;
+}
+
+/**
+ * A member function that writes a value into a sysfs file that is kept open.
+ * The value is written from offset 0 with pwrite, since sysfs files take a whole value with every write.
+ * @param fd the file descriptor to write.
+ * @param value the value to write.
+ * @param lastValue the value that was written last to fd. Updated when the write succeeded.
+ * @return returns true if value was written or was already written before.
+ */
+bool SysfsSDK::writeValue(int fd, const string& value, string& lastValue) {
+    if (value == lastValue) {
+        this->skippedWriteCount++;
+        return true;
+    }
+
+    if (pwrite(fd, value.c_str(), value.size(), 0) != (ssize_t) value.size()) {
+        this->failedWriteCount++;
+        lastValue.clear(); // do not skip the next try
+        return false;
+    }
+    this->writeCount++;
+    lastValue = value;
+    return true;
+}
+
+/**
+ * A static member function for class SysfsSDK that reads a small file.
+ * @param path the path of the file.
+ * @param content the content is stored here.
+ * @return returns false if the file could not be read.
+ */
+bool SysfsSDK::readFile(const string& path, string& content) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return false;
+
+    char buffer[256];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length < 0) return false;
+
+    content.assign(buffer, length);
+    return true;
+}
+
+/**
+ * A static member function for class SysfsSDK that checks if RGB values are from 0 to 255.
+ * @param r the r value
+ * @param g the g value
+ * @param b the b value
+ * @return returns true if every value was valid, false if not.
+ */
+bool SysfsSDK::isValidRgb(int r, int g, int b) {
+    return (((r >= 0) && (r <= 255)) && ((g >= 0) && (g <= 255))) && ((b >= 0) && (b <= 255));
+}
+
+/**
+ * A static member function for class SysfsSDK that guesses a DeviceType from the name of an LED node.
+ * Names look like "devicename:color:function", for example "asus::kbd_backlight".
+ * @param name the name of the LED node.
+ * @return returns Keyboard for keyboard backlights and lock LEDs, Mouse for mice, ETC for everything else.
+ */
+DeviceType SysfsSDK::translateDeviceType(const string& name) {
+    if (name.find("kbd") != string::npos || name.find("capslock") != string::npos ||
+        name.find("numlock") != string::npos || name.find("scrolllock") != string::npos)
+        return DeviceType::Keyboard;
+    else if (name.find("mouse") != string::npos)
+        return DeviceType::Mouse;
+    else
+        return DeviceType::ETC;
+}
+
+#endif //__linux__
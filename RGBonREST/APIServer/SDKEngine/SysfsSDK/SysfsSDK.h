@@ -0,0 +1,84 @@
+//
+// @file : SysfsSDK.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class SysfsSDK
+//
+
+#ifndef RGBONREST_SYSFSSDK_H
+#define RGBONREST_SYSFSSDK_H
+#pragma once
+
+#ifdef __linux__
+
+#include <list>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#include "../AbstractSDK.h"
+
+using std::list;
+using std::vector;
+using std::string;
+using std::atomic;
+
+
+/**
+ * A struct that stores a single LED class node, with its files kept open for writing.
+ * channels has a letter for each value of multi_intensity, in the order of multi_index: 'r', 'g', 'b', 'w' for white,
+ * or '0' for colors that RGBonREST does not know. It is empty for LEDs that only have brightness.
+ */
+typedef struct sysfsLed {
+    string name;
+    int brightnessFd;
+    int intensityFd; // -1 when the LED is not multicolor
+    unsigned int maxBrightness;
+    vector<char> channels;
+    string lastBrightness; // what was written last, so that the same value is never written again
+    string lastIntensity;
+} SysfsLed;
+
+
+/**
+ * A class that is an SDK for LEDs that Linux exposes under /sys/class/leds.
+ * Every LED node becomes a device with a single LED. Multicolor nodes get their color through multi_intensity and
+ * full brightness, other nodes get the brightest of r, g and b as brightness.
+ * Files are opened once at connect and written with pwrite, and values that did not change are not written at all.
+ */
+class SysfsSDK : public AbstractSDK {
+private:
+    string ledsPath;
+    vector<SysfsLed> leds; // deviceIndex -> LED node
+    vector<Device*> sysfsDevices; // deviceIndex -> Device, kept until destruction so pointers stay valid
+
+    atomic<uint64_t> writeCount{0};
+    atomic<uint64_t> skippedWriteCount{0};
+    atomic<uint64_t> failedWriteCount{0};
+
+    void setAllDeviceInfo();
+    void closeFiles();
+    bool openLed(const string&, SysfsLed&);
+    bool writeLed(SysfsLed&, int, int, int);
+    bool writeValue(int, const string&, string&);
+    static bool readFile(const string&, string&);
+    static bool isValidRgb(int, int, int);
+    static DeviceType translateDeviceType(const string&);
+public:
+    explicit SysfsSDK(const string&);
+    ~SysfsSDK();
+    void connect() override;
+    void disconnect() override;
+    void setRGB(DeviceType, int, int, int) override;
+    map<DeviceType, list<Device*>*> getDevices() override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+    map<string, uint64_t> getStatistics() override;
+};
+
+#endif //__linux__
+
+
+#endif //RGBONREST_SYSFSSDK_H
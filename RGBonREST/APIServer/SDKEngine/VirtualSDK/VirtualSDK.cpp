@@ -0,0 +1,277 @@
+//
+// @file : VirtualSDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class VirtualSDK
+//
+
+#include "VirtualSDK.h"
+
+
+/**
+ * A constructor member function for class VirtualSDK.
+ * @param argDeviceConfigs which devices to simulate, usually virtual_devices from config.json.
+ * @param argFrameHistory how many of the latest applied frames to keep for getFrames.
+ * @param argSeed the seed for picking latencies and failures, so that runs can be repeated.
+ */
+VirtualSDK::VirtualSDK(const vector<VirtualDeviceConfig>& argDeviceConfigs, size_t argFrameHistory, unsigned int argSeed) {
+    this->sdkName = "Virtual";
+    this->isConnected = false;
+    this->deviceConfigs = argDeviceConfigs;
+    this->frameHistory = argFrameHistory;
+    this->random.seed(argSeed);
+}
+
+/**
+ * A destructor member function for class VirtualSDK.
+ * This deletes all Device objects and device lists that were generated by setAllDeviceInfo.
+ */
+VirtualSDK::~VirtualSDK() {
+    for (auto const& x : this->virtualDevices)
+        delete x;
+    for (auto const& x : this->devices)
+        delete x.second;
+}
+
+/**
+ * A member function for class VirtualSDK that connects into the simulated devices.
+ * Every LED starts black.
+ * @throws SDKExceptions::SDKAlreadyConnected: when SDK was already connected.
+ * @throws SDKExceptions::NoDevicesConnected: when virtual_devices did not describe any device.
+ */
+void VirtualSDK::connect() {
+    if (this->isConnected) throw SDKExceptions::SDKAlreadyConnected();
+
+    this->setAllDeviceInfo();
+    if (this->virtualDevices.empty()) throw SDKExceptions::NoDevicesConnected();
+    this->isConnected = true;
+}
+
+/**
+ * A member function for class VirtualSDK that disconnects from the simulated devices.
+ * Recorded frames are kept, so that they can still be read after a run.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+void VirtualSDK::disconnect() {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    this->isConnected = false;
+}
+
+/**
+ * A member function for class VirtualSDK that sets every LED of every device of a DeviceType with a single flush.
+ * @param deviceType the DeviceType to set RGB values. ALL sets every device.
+ * @param r the R value.
+ * @param g the G value.
+ * @param b the B value.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a value was not from 0 to 255.
+ * @throws SDKExceptions::InvalidDeviceType: when deviceType was not a DeviceType.
+ * @throws SDKExceptions::SomeRGBFailed: when some devices failed, at the same time some did not.
+ * @throws SDKExceptions::AllRGBFailed: when every device failed.
+ */
+void VirtualSDK::setRGB(DeviceType deviceType, int r, int g, int b) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    if (!isValidRgb(r, g, b)) throw SDKExceptions::InvalidRGBValue();
+    if (deviceType < DeviceType::ALL || deviceType > DeviceType::RAM) throw SDKExceptions::InvalidDeviceType();
+
+    map<int, vector<LedColor>> writes;
+    for (auto const& x : this->virtualDevices) {
+        if (deviceType != DeviceType::ALL && x->deviceType != deviceType) continue;
+
+        vector<LedColor>& leds = writes[x->deviceIndex];
+        unsigned int ledCount = this->deviceConfigs[this->configIndices[x->deviceIndex]].ledCount;
+        for (unsigned int i = 0 ; i < ledCount ; i++)
+            leds.push_back({(int) i, r, g, b});
+    }
+    this->flush(writes);
+}
+
+/**
+ * A member function for class VirtualSDK that returns member variable 'devices'.
+ * @return returns a map of list that represents pointer address to connected devices.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+map<DeviceType, list<Device*>*> VirtualSDK::getDevices() {
+    if (this->isConnected)
+        return this->devices;
+    else
+        throw SDKExceptions::SDKNotConnected();
+}
+
+/**
+ * A member function for class VirtualSDK that returns the ids of every LED of a device.
+ * @param device the device to get LEDs of.
+ * @return returns ids from 0 to the LED count of the device - 1.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ */
+vector<int> VirtualSDK::getLedIds(const Device* device) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+
+    vector<int> ledIds(this->deviceConfigs[this->configIndices[device->deviceIndex]].ledCount);
+    for (size_t i = 0 ; i < ledIds.size() ; i++)
+        ledIds[i] = (int) i;
+    return ledIds;
+}
+
+/**
+ * A member function for class VirtualSDK that sets colors of some LEDs of a device.
+ * @param device the device that the LEDs belong to.
+ * @param leds the LEDs to set, with ids from getLedIds.
+ * @throws the same exceptions as setLedColorsBatch.
+ */
+void VirtualSDK::setLedColors(const Device* device, const vector<LedColor>& leds) {
+    this->setLedColorsBatch(vector<DeviceLedColors>{DeviceLedColors{device, leds}});
+}
+
+/**
+ * A member function for class VirtualSDK that sets colors of LEDs of several devices with a single flush.
+ * LEDs with ids that the device does not have are ignored.
+ * @param deviceLeds the devices and their LEDs to set.
+ * @throws SDKExceptions::SDKNotConnected: when SDK was not connected before.
+ * @throws SDKExceptions::InvalidRGBValue: when a color was not from 0 to 255. Nothing is written in this case.
+ * @throws SDKExceptions::SomeRGBFailed: when some devices failed, at the same time some did not.
+ * @throws SDKExceptions::AllRGBFailed: when every device failed.
+ */
+void VirtualSDK::setLedColorsBatch(const vector<DeviceLedColors>& deviceLeds) {
+    if (!this->isConnected) throw SDKExceptions::SDKNotConnected();
+    for (auto const& x : deviceLeds)
+        for (auto const& y : x.leds)
+            if (!isValidRgb(y.r, y.g, y.b)) throw SDKExceptions::InvalidRGBValue();
+
+    map<int, vector<LedColor>> writes;
+    for (auto const& x : deviceLeds) {
+        unsigned int ledCount = this->deviceConfigs[this->configIndices[x.device->deviceIndex]].ledCount;
+        for (auto const& y : x.leds)
+            if (y.ledId >= 0 && y.ledId < (int) ledCount) writes[x.device->deviceIndex].push_back(y);
+    }
+    this->flush(writes);
+}
+
+/**
+ * A member function for class VirtualSDK that returns counters of simulated flushes.
+ * @return returns flushes, frames_applied, devices_failed and simulated_latency_us.
+ */
+map<string, uint64_t> VirtualSDK::getStatistics() {
+    map<string, uint64_t> statistics;
+    statistics["flushes"] = this->flushCount.load();
+    statistics["frames_applied"] = this->appliedFrameCount.load();
+    statistics["devices_failed"] = this->failedDeviceCount.load();
+    statistics["simulated_latency_us"] = this->latencyTotalUs.load();
+    return statistics;
+}
+
+/**
+ * A member function for class VirtualSDK that returns the latest frames that were applied, oldest first.
+ * This is safe to call from any thread.
+ * @return returns a copy of at most frameHistory frames.
+ */
+vector<VirtualFrame> VirtualSDK::getFrames() {
+    lock_guard<mutex> lock(this->stateMutex);
+    return vector<VirtualFrame>(this->frames.begin(), this->frames.end());
+}
+
+/**
+ * A member function for class VirtualSDK that returns the current color of every LED of a device.
+ * This is safe to call from any thread.
+ * @param device the device to get colors of.
+ * @return returns a LedColor for every LED, in the order of getLedIds.
+ */
+vector<LedColor> VirtualSDK::getLedColors(const Device* device) {
+    lock_guard<mutex> lock(this->stateMutex);
+    return this->ledStates[device->deviceIndex];
+}
+
+/**
+ * A member function that generates Device objects from deviceConfigs into member variable devices.
+ * Device objects are only generated on the first connect, so pointers that were handed out before stay valid.
+ */
+void VirtualSDK::setAllDeviceInfo() {
+    if (!this->virtualDevices.empty()) return;
+
+    for (size_t i = 0 ; i < this->deviceConfigs.size() ; i++) {
+        const VirtualDeviceConfig& config = this->deviceConfigs[i];
+        DeviceType deviceType = (DeviceType) config.deviceType;
+        if (this->devices.find(deviceType) == this->devices.end())
+            this->devices[deviceType] = new list<Device*>;
+
+        for (unsigned int j = 0 ; j < config.count ; j++) {
+            Device* tmpDevice = new Device;
+            tmpDevice->sdkName = this->sdkName;
+            tmpDevice->name = "Virtual " + Misc::convertDeviceType(deviceType) + " " + std::to_string(j + 1);
+            tmpDevice->deviceType = deviceType;
+            tmpDevice->deviceIndex = (int) this->virtualDevices.size();
+
+            this->devices[deviceType]->push_back(tmpDevice);
+            this->virtualDevices.push_back(tmpDevice);
+            this->configIndices.push_back(i);
+
+            vector<LedColor> leds;
+            for (unsigned int k = 0 ; k < config.ledCount ; k++)
+                leds.push_back({(int) k, 0, 0, 0});
+            lock_guard<mutex> lock(this->stateMutex);
+            this->ledStates.push_back(leds);
+        }
+    }
+}
+
+/**
+ * A member function that simulates a single flush of LEDs of several devices.
+ * A latency is picked for every device from its range and the flush sleeps for the slowest one, since real SDKs
+ * send to devices at the same time. Then every device fails with its own failure rate. Only devices that did not fail
+ * have their LEDs changed and a frame recorded.
+ * @param writes deviceIndex -> LEDs to write to that device.
+ * @throws SDKExceptions::SomeRGBFailed: when some devices failed, at the same time some did not.
+ * @throws SDKExceptions::AllRGBFailed: when every device failed.
+ */
+void VirtualSDK::flush(const map<int, vector<LedColor>>& writes) {
+    if (writes.empty()) return; // nothing to flush
+
+    unsigned int latencyUs = 0;
+    vector<bool> isFailed;
+    for (auto const& x : writes) {
+        const VirtualDeviceConfig& config = this->deviceConfigs[this->configIndices[x.first]];
+        unsigned int maxLatencyUs = std::max(config.minLatencyUs, config.maxLatencyUs);
+        std::uniform_int_distribution<unsigned int> latencyDistribution(config.minLatencyUs, maxLatencyUs);
+        std::bernoulli_distribution failureDistribution(std::min(std::max(config.failureRate, 0.0), 1.0));
+
+        latencyUs = std::max(latencyUs, latencyDistribution(this->random));
+        isFailed.push_back(failureDistribution(this->random));
+    }
+    if (latencyUs > 0) std::this_thread::sleep_for(std::chrono::microseconds(latencyUs));
+
+    int failedCount = 0;
+    size_t i = 0;
+    {
+        lock_guard<mutex> lock(this->stateMutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto const& x : writes) {
+            if (isFailed[i++]) {
+                failedCount++;
+                continue;
+            }
+
+            for (auto const& y : x.second)
+                this->ledStates[x.first][y.ledId] = y;
+            this->frames.push_back(VirtualFrame{++this->lastSequence, now, x.first, x.second});
+            while (this->frames.size() > this->frameHistory) this->frames.pop_front();
+        }
+    }
+
+    this->flushCount++;
+    this->latencyTotalUs += latencyUs;
+    this->failedDeviceCount += failedCount;
+    this->appliedFrameCount += writes.size() - failedCount;
+
+    if (failedCount == (int) writes.size()) throw SDKExceptions::AllRGBFailed();
+    else if (failedCount > 0) throw SDKExceptions::SomeRGBFailed();
+}
+
+/**
+ * A static member function for class VirtualSDK that checks if RGB values are from 0 to 255.
+ * @param r the r value
+ * @param g the g value
+ * @param b the b value
+ * @return returns true if every value was valid, false if not.
+ */
+bool VirtualSDK::isValidRgb(int r, int g, int b) {
+    return (((r >= 0) && (r <= 255)) && ((g >= 0) && (g <= 255))) && ((b >= 0) && (b <= 255));
+}
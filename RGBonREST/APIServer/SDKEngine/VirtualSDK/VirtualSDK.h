@@ -0,0 +1,90 @@
+//
+// @file : VirtualSDK.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class VirtualSDK
+//
+
+#ifndef RGBONREST_VIRTUALSDK_H
+#define RGBONREST_VIRTUALSDK_H
+#pragma once
+
+#include <list>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <thread>
+
+#include "../AbstractSDK.h"
+#include "../../Utils/ConfigValues.h"
+#include "../../Utils/Misc.h"
+
+using std::list;
+using std::vector;
+using std::deque;
+using std::map;
+using std::mutex;
+using std::lock_guard;
+using std::atomic;
+using std::mt19937;
+
+
+/**
+ * A struct that stores a single frame that VirtualSDK applied to a device.
+ * leds are only the LEDs that were written by this frame.
+ */
+typedef struct virtualFrame {
+    uint64_t sequence;
+    std::chrono::steady_clock::time_point appliedAt;
+    int deviceIndex;
+    vector<LedColor> leds;
+} VirtualFrame;
+
+
+/**
+ * A class that is an SDK without any hardware, so that every path of the servers can run on any platform.
+ * Devices are generated from virtual_devices in config.json, each with its own LED count, flush latency and failure
+ * rate. Every flush sleeps for the slowest latency that was picked for its devices, then each device fails on its own.
+ * Frames that were applied are kept in a buffer of the latest frameHistory frames, which can be read with getFrames.
+ */
+class VirtualSDK : public AbstractSDK {
+private:
+    vector<VirtualDeviceConfig> deviceConfigs;
+    vector<Device*> virtualDevices; // deviceIndex -> Device, kept until destruction so pointers stay valid
+    vector<size_t> configIndices; // deviceIndex -> index of its config in deviceConfigs
+    vector<vector<LedColor>> ledStates; // deviceIndex -> current color of every LED
+    deque<VirtualFrame> frames;
+    size_t frameHistory;
+    mutex stateMutex; // ledStates and frames are read from other threads
+    mt19937 random;
+    uint64_t lastSequence = 0;
+
+    atomic<uint64_t> flushCount{0};
+    atomic<uint64_t> failedDeviceCount{0};
+    atomic<uint64_t> appliedFrameCount{0};
+    atomic<uint64_t> latencyTotalUs{0};
+
+    void setAllDeviceInfo();
+    void flush(const map<int, vector<LedColor>>&);
+    static bool isValidRgb(int, int, int);
+public:
+    VirtualSDK(const vector<VirtualDeviceConfig>&, size_t, unsigned int);
+    ~VirtualSDK();
+    void connect() override;
+    void disconnect() override;
+    void setRGB(DeviceType, int, int, int) override;
+    map<DeviceType, list<Device*>*> getDevices() override;
+    vector<int> getLedIds(const Device*) override;
+    void setLedColors(const Device*, const vector<LedColor>&) override;
+    void setLedColorsBatch(const vector<DeviceLedColors>&) override;
+    map<string, uint64_t> getStatistics() override;
+
+    vector<VirtualFrame> getFrames();
+    vector<LedColor> getLedColors(const Device*);
+};
+
+
+#endif //RGBONREST_VIRTUALSDK_H
@@ -0,0 +1,48 @@
+//
+// @file : Frame.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class Frame
+//
+
+#include "Frame.h"
+
+
+/**
+ * A member function for class Frame that parses a binary frame into this instance.
+ * @param data the pointer to the received bytes.
+ * @param length the number of received bytes.
+ * @return returns true if the bytes were a well formed frame, false if not.
+ */
+bool Frame::parse(const uint8_t* data, size_t length) {
+    if (length < FRAME_HEADER_SIZE) return false;
+    if (data[0] != FRAME_MAGIC_0 || data[1] != FRAME_MAGIC_1 || data[2] != FRAME_VERSION) return false;
+
+    size_t recordCount = data[3];
+    if (length != FRAME_HEADER_SIZE + recordCount * FRAME_RECORD_SIZE) return false;
+
+    this->sequence = ((uint32_t) data[4] << 24) | ((uint32_t) data[5] << 16) | ((uint32_t) data[6] << 8) | data[7];
+    this->records.resize(recordCount);
+
+    const uint8_t* cursor = data + FRAME_HEADER_SIZE;
+    for (auto& record : this->records) { // records are plain bytes, so copy them field by field.
+        record.sdkIndex = cursor[0];
+        record.deviceType = cursor[1];
+        record.deviceIndex = cursor[2];
+        record.r = cursor[3];
+        record.g = cursor[4];
+        record.b = cursor[5];
+        cursor += FRAME_RECORD_SIZE;
+    }
+    return true;
+}
+
+/**
+ * A static member function for class Frame that checks if a sequence number comes after another one.
+ * This uses serial number arithmetic so that the sequence number can wrap around.
+ * @param sequence the sequence number of the received frame.
+ * @param lastSequence the sequence number of the last applied frame.
+ * @return returns true if sequence is newer than lastSequence.
+ */
+bool Frame::isNewer(uint32_t sequence, uint32_t lastSequence) {
+    return (int32_t) (sequence - lastSequence) > 0;
+}
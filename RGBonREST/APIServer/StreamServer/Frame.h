@@ -0,0 +1,55 @@
+//
+// @file : Frame.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the binary color frame and all member functions for class Frame
+//
+
+#ifndef RGBONREST_FRAME_H
+#define RGBONREST_FRAME_H
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+#define FRAME_MAGIC_0 'R'
+#define FRAME_MAGIC_1 'F'
+#define FRAME_VERSION 1
+#define FRAME_HEADER_SIZE 8
+#define FRAME_RECORD_SIZE 6
+#define FRAME_TARGET_ALL 0xFF // sdkIndex or deviceIndex value that targets every SDK or every device
+
+
+/**
+ * A struct that stores one color command inside a frame.
+ * sdkIndex is the index of the SDK in RESTServer (in the order the SDKs were loaded) or FRAME_TARGET_ALL.
+ * deviceType is a DeviceType value. deviceIndex is reserved for per device addressing and must be FRAME_TARGET_ALL.
+ */
+typedef struct frameRecord {
+    uint8_t sdkIndex;
+    uint8_t deviceType;
+    uint8_t deviceIndex;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} FrameRecord;
+
+/**
+ * A class that represents a binary color frame.
+ * A frame is laid out as below, all multi byte values are big endian:
+ * | 'R' | 'F' | version (1) | record count (1) | sequence number (4) | record count * FRAME_RECORD_SIZE bytes |
+ * Each record is | sdk index | device type | device index | r | g | b |, which is a packed RGB24 color with its target.
+ */
+class Frame {
+public:
+    uint32_t sequence = 0;
+    vector<FrameRecord> records;
+
+    bool parse(const uint8_t*, size_t);
+    static bool isNewer(uint32_t, uint32_t);
+};
+
+
+#endif //RGBONREST_FRAME_H
@@ -0,0 +1,32 @@
+//
+// @file : StreamDispatcher.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class StreamDispatcher
+//
+
+#include "StreamDispatcher.h"
+
+
+/**
+ * A static member function for class StreamDispatcher that applies a record to its target SDKs using
+ * AbstractSDK::setRGB on each SDK's executor.
+ * Records replace waiting records for the same DeviceType, so an SDK that cannot keep up only applies the latest
+ * colors. Stream clients do not get a reply per color, so errors from SDKs are ignored, and a record is dropped for an
+ * SDK whose executor is full.
+ * @param record the record to apply.
+ * @param sdks the pointer to the array of AbstractSDK*.
+ */
+void StreamDispatcher::apply(const FrameRecord& record, vector<AbstractSDK*>* sdks) {
+    if (record.deviceIndex != FRAME_TARGET_ALL) return; // per device addressing is not supported by setRGB.
+
+    for (int i = 0 ; i < (int) sdks->size() ; i++) {
+        if (record.sdkIndex != FRAME_TARGET_ALL && record.sdkIndex != i) continue;
+        AbstractSDK* sdk = sdks->at(i);
+        sdk->executor->submitLatest(record.deviceType, [sdk, record] {
+            try {
+                sdk->setRGB((DeviceType) record.deviceType, record.r, record.g, record.b);
+            } catch (const exception& e) { // not connected, invalid device type, failed RGBs
+            }
+        }, [] {});
+    }
+}
@@ -0,0 +1,30 @@
+//
+// @file : StreamDispatcher.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class StreamDispatcher
+//
+
+#ifndef RGBONREST_STREAMDISPATCHER_H
+#define RGBONREST_STREAMDISPATCHER_H
+#pragma once
+
+#include <exception>
+
+#include "./Frame.h"
+#include "../Utils/Defines.h"
+#include "../SDKEngine/AbstractSDK.h"
+
+using std::exception;
+
+
+/**
+ * A class that applies color records that came from stream servers to SDKs.
+ * This class has all static member functions that can be called from UDPServer and WebSocketServer.
+ */
+class StreamDispatcher {
+public:
+    static void apply(const FrameRecord&, vector<AbstractSDK*>*);
+};
+
+
+#endif //RGBONREST_STREAMDISPATCHER_H
@@ -0,0 +1,112 @@
+//
+// @file : UDPServer.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class UDPServer
+//
+
+#include "UDPServer.h"
+
+
+/**
+ * A constructor member function for class UDPServer.
+ * @param argIp the IPv4 address to listen on.
+ * @param argPort the UDP port to listen on.
+ * @param argSdks the pointer to the array of AbstractSDK* to apply frames to.
+ */
+UDPServer::UDPServer(const string& argIp, unsigned int argPort, vector<AbstractSDK*>* argSdks) {
+    this->ip = argIp;
+    this->port = argPort;
+    this->sdks = argSdks;
+    this->socketHandle = INVALID_SOCKET;
+    this->receiveThread = nullptr;
+}
+
+/**
+ * A destructor member function for class UDPServer.
+ * This stops the receive thread if it is still running.
+ */
+UDPServer::~UDPServer() {
+    this->stop();
+}
+
+/**
+ * A member function for class UDPServer that opens the socket and starts the receive thread.
+ * @throws UDPServer::socketFailedError when the socket could not be opened or bound.
+ */
+void UDPServer::start() {
+    if (!SocketUtils::initialize())
+        throw UDPServer::socketFailedError();
+
+    sockaddr_in address{};
+    this->socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (this->socketHandle == INVALID_SOCKET || !SocketUtils::fillAddress(this->ip, this->port, address) ||
+        bind(this->socketHandle, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR) {
+        if (this->socketHandle != INVALID_SOCKET)
+            SocketUtils::closeSocket(this->socketHandle);
+        this->socketHandle = INVALID_SOCKET;
+        SocketUtils::cleanup();
+        throw UDPServer::socketFailedError();
+    }
+
+    // Wake up every once in a while so that stop() does not have to wait for a datagram.
+    SocketUtils::setReceiveTimeout(this->socketHandle, STREAM_RECEIVE_TIMEOUT_MS);
+    this->receiveThread = new thread(&UDPServer::receiveLoop, this);
+}
+
+/**
+ * A member function for class UDPServer that stops the receive thread and closes the socket.
+ */
+void UDPServer::stop() {
+    if (this->receiveThread == nullptr) return;
+
+    this->exitFlag = true;
+    this->receiveThread->join();
+    delete this->receiveThread;
+    this->receiveThread = nullptr;
+
+    SocketUtils::closeSocket(this->socketHandle);
+    this->socketHandle = INVALID_SOCKET;
+    SocketUtils::cleanup();
+}
+
+/**
+ * A member function for class UDPServer that receives datagrams until stop() is called.
+ * A datagram is applied only if it is a well formed frame that is newer than the last frame from the same sender.
+ */
+void UDPServer::receiveLoop() {
+    uint8_t buffer[FRAME_HEADER_SIZE + 255 * FRAME_RECORD_SIZE];
+    Frame frame;
+
+    while (!this->exitFlag) {
+        sockaddr_in sender{};
+        socklen_t senderLength = sizeof(sender);
+        int length = recvfrom(this->socketHandle, (char*) buffer, sizeof(buffer), 0, (sockaddr*) &sender, &senderLength);
+        if (length <= 0) continue; // timed out or failed, check exitFlag and try again.
+
+        this->receivedCount++;
+        if (!frame.parse(buffer, length)) {
+            this->malformedCount++;
+            continue;
+        }
+
+        uint64_t senderKey = ((uint64_t) sender.sin_addr.s_addr << 16) | sender.sin_port;
+        auto last = this->lastSequences.find(senderKey);
+        if (last != this->lastSequences.end() && !Frame::isNewer(frame.sequence, last->second)) {
+            this->droppedCount++; // late or out of order frame, a newer color was already applied.
+            continue;
+        }
+        this->lastSequences[senderKey] = frame.sequence;
+
+        this->applyFrame(frame);
+        this->appliedCount++;
+    }
+}
+
+/**
+ * A member function for class UDPServer that applies every record of a frame.
+ * @param frame the frame to apply.
+ */
+void UDPServer::applyFrame(const Frame& frame) {
+    for (auto const& record : frame.records)
+        StreamDispatcher::apply(record, this->sdks);
+}
@@ -0,0 +1,71 @@
+//
+// @file : UDPServer.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class UDPServer
+//
+
+#ifndef RGBONREST_UDPSERVER_H
+#define RGBONREST_UDPSERVER_H
+#pragma once
+
+#include "../Utils/SocketUtils.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <exception>
+
+#include "./Frame.h"
+#include "./StreamDispatcher.h"
+#include "../Utils/Defines.h"
+#include "../SDKEngine/AbstractSDK.h"
+
+using std::string;
+using std::thread;
+using std::atomic;
+using std::unordered_map;
+using std::exception;
+using std::cout;
+using std::endl;
+
+
+/**
+ * A class that receives binary color frames over UDP and applies them to SDKs.
+ * This skips HTTP and JSON entirely, which is meant for clients that stream colors at a high rate.
+ * Frames that are older than the last applied frame from the same sender are dropped.
+ */
+class UDPServer {
+private:
+    string ip;
+    unsigned int port;
+    SocketHandle socketHandle;
+    thread* receiveThread;
+    atomic<bool> exitFlag{false};
+
+    vector<AbstractSDK*>* sdks;
+    unordered_map<uint64_t, uint32_t> lastSequences; // sender address -> last applied sequence number
+
+    void receiveLoop();
+    void applyFrame(const Frame&);
+public:
+    atomic<uint64_t> receivedCount{0};
+    atomic<uint64_t> appliedCount{0};
+    atomic<uint64_t> droppedCount{0};
+    atomic<uint64_t> malformedCount{0};
+
+    UDPServer(const string&, unsigned int, vector<AbstractSDK*>*);
+    ~UDPServer();
+    void start();
+    void stop();
+
+    /**
+     * A class that is for exception when the UDP socket could not be opened.
+     */
+    class socketFailedError : public exception {
+    };
+};
+
+
+#endif //RGBONREST_UDPSERVER_H
@@ -0,0 +1,527 @@
+//
+// @file : WebSocketServer.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class WebSocketServer
+//
+
+#include "WebSocketServer.h"
+
+
+/**
+ * A constructor member function for class WebSocketServer.
+ * @param argIp the IPv4 address to listen on.
+ * @param argPort the TCP port to listen on.
+ * @param argSdks the pointer to the array of AbstractSDK* to apply colors to.
+ */
+WebSocketServer::WebSocketServer(const string& argIp, unsigned int argPort, vector<AbstractSDK*>* argSdks) {
+    this->ip = argIp;
+    this->port = argPort;
+    this->sdks = argSdks;
+    this->listenSocket = INVALID_SOCKET;
+    this->acceptThread = nullptr;
+}
+
+/**
+ * A destructor member function for class WebSocketServer.
+ * This closes all connections and stops the accept thread if it is still running.
+ */
+WebSocketServer::~WebSocketServer() {
+    this->stop();
+}
+
+/**
+ * A member function for class WebSocketServer that opens the listening socket and starts the accept thread.
+ * @throws WebSocketServer::socketFailedError when the socket could not be opened, bound or listened on.
+ */
+void WebSocketServer::start() {
+    if (!SocketUtils::initialize())
+        throw WebSocketServer::socketFailedError();
+
+    sockaddr_in address{};
+    int reuse = 1;
+    this->listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (this->listenSocket != INVALID_SOCKET)
+        setsockopt(this->listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*) &reuse, sizeof(reuse));
+
+    if (this->listenSocket == INVALID_SOCKET || !SocketUtils::fillAddress(this->ip, this->port, address) ||
+        bind(this->listenSocket, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR ||
+        listen(this->listenSocket, STREAM_MAX_CONNECTIONS) == SOCKET_ERROR) {
+        if (this->listenSocket != INVALID_SOCKET)
+            SocketUtils::closeSocket(this->listenSocket);
+        this->listenSocket = INVALID_SOCKET;
+        SocketUtils::cleanup();
+        throw WebSocketServer::socketFailedError();
+    }
+
+    this->acceptThread = new thread(&WebSocketServer::acceptLoop, this);
+}
+
+/**
+ * A member function for class WebSocketServer that stops accepting clients and closes every connection.
+ */
+void WebSocketServer::stop() {
+    if (this->acceptThread == nullptr) return;
+
+    this->exitFlag = true;
+    this->acceptThread->join();
+    delete this->acceptThread;
+    this->acceptThread = nullptr;
+
+    for (auto const& connection : this->connections)
+        this->closeConnection(connection);
+    this->removeClosedConnections(true);
+
+    SocketUtils::closeSocket(this->listenSocket);
+    this->listenSocket = INVALID_SOCKET;
+    SocketUtils::cleanup();
+}
+
+/**
+ * A member function for class WebSocketServer that accepts clients until stop() is called.
+ * This uses select with a timeout so that it can check exitFlag without a client connecting.
+ */
+void WebSocketServer::acceptLoop() {
+    while (!this->exitFlag) {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(this->listenSocket, &readSet);
+        timeval timeout{};
+        timeout.tv_usec = STREAM_RECEIVE_TIMEOUT_MS * 1000;
+
+        this->removeClosedConnections(false); // clean up clients that went away
+        if (select((int) this->listenSocket + 1, &readSet, nullptr, nullptr, &timeout) <= 0) continue;
+
+        SocketHandle clientSocket = accept(this->listenSocket, nullptr, nullptr);
+        if (clientSocket == INVALID_SOCKET) continue;
+
+        if (this->connections.size() >= STREAM_MAX_CONNECTIONS) { // refuse instead of spawning unbounded threads
+            SocketUtils::closeSocket(clientSocket);
+            continue;
+        }
+
+        int noDelay = 1; // acks are tiny, do not let Nagle hold them back.
+        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, (const char*) &noDelay, sizeof(noDelay));
+
+        StreamConnection* connection = new StreamConnection;
+        connection->socketHandle = clientSocket;
+        connection->readThread = new thread(&WebSocketServer::readLoop, this, connection);
+        this->connections.push_back(connection);
+    }
+}
+
+/**
+ * A member function for class WebSocketServer that performs handshake and reads messages from a client.
+ * This runs on its own thread per client and starts the apply thread once the handshake was successful.
+ * @param connection the client to read from.
+ */
+void WebSocketServer::readLoop(StreamConnection* connection) {
+    if (!this->performHandshake(connection)) {
+        connection->closed = true;
+        return;
+    }
+    connection->applyThread = new thread(&WebSocketServer::applyLoop, this, connection);
+
+    int opcode;
+    string message;
+    while (!this->exitFlag && !connection->closed && this->readMessage(connection, opcode, message))
+        this->handleMessage(connection, opcode, message);
+
+    this->closeConnection(connection);
+}
+
+/**
+ * A member function for class WebSocketServer that applies the latest colors of a client.
+ * This waits until something is pending, takes every pending record at once, applies them and then acks.
+ * @param connection the client to apply colors for.
+ */
+void WebSocketServer::applyLoop(StreamConnection* connection) {
+    while (true) {
+        map<uint16_t, FrameRecord> batch;
+        uint64_t superseded;
+        {
+            unique_lock<mutex> lock(connection->pendingMutex);
+            connection->pendingCondition.wait(lock, [connection] {
+                return connection->closed || !connection->pending.empty();
+            });
+            if (connection->closed) return;
+
+            batch.swap(connection->pending);
+            superseded = connection->supersededCount;
+            connection->supersededCount = 0;
+        }
+
+        for (auto const& x : batch)
+            StreamDispatcher::apply(x.second, this->sdks);
+        this->appliedCount += batch.size();
+        this->supersededCount += superseded;
+
+        // This is the backpressure signal. Clients that see superseded > 0 are sending faster than SDKs can apply.
+        json ack;
+        ack["applied"] = batch.size();
+        ack["superseded"] = superseded;
+        sendFrame(connection, WEBSOCKET_OPCODE_TEXT, ack.dump());
+    }
+}
+
+/**
+ * A member function for class WebSocketServer that performs the opening handshake of RFC 6455.
+ * @param connection the client to perform handshake with.
+ * @return returns true if the client asked for /stream with a valid Sec-WebSocket-Key, false if not.
+ */
+bool WebSocketServer::performHandshake(StreamConnection* connection) {
+    string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == string::npos) { // read until the end of headers
+        int length = recv(connection->socketHandle, buffer, sizeof(buffer), 0);
+        if (length <= 0 || request.size() + length > STREAM_MAX_HANDSHAKE_SIZE) return false;
+        request.append(buffer, length);
+    }
+
+    string lowerRequest = request;
+    transform(lowerRequest.begin(), lowerRequest.end(), lowerRequest.begin(), ::tolower);
+
+    size_t keyStart = lowerRequest.find("sec-websocket-key:");
+    bool isStream = lowerRequest.compare(0, 12, "get /stream ") == 0 || lowerRequest.compare(0, 13, "get /stream/ ") == 0;
+    if (!isStream || keyStart == string::npos) {
+        string response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(connection->socketHandle, response.c_str(), (int) response.size(), 0);
+        return false;
+    }
+
+    keyStart += 18; // strlen("sec-websocket-key:")
+    size_t keyEnd = request.find("\r\n", keyStart);
+    string key = request.substr(keyStart, keyEnd - keyStart);
+    key.erase(0, key.find_first_not_of(" \t"));
+    key.erase(key.find_last_not_of(" \t") + 1);
+
+    string response = "HTTP/1.1 101 Switching Protocols\r\n"
+                      "Upgrade: websocket\r\n"
+                      "Connection: Upgrade\r\n"
+                      "Sec-WebSocket-Accept: " + computeAcceptKey(key) + "\r\n\r\n";
+    return send(connection->socketHandle, response.c_str(), (int) response.size(), 0) == (int) response.size();
+}
+
+/**
+ * A member function for class WebSocketServer that reads a whole message from a client.
+ * Fragmented messages are joined. Ping is answered with pong and pong is ignored.
+ * @param connection the client to read from.
+ * @param opcode the opcode of the message is stored here.
+ * @param message the payload of the message is stored here.
+ * @return returns true if a message was read, false if the client closed or violated the protocol.
+ */
+bool WebSocketServer::readMessage(StreamConnection* connection, int& opcode, string& message) {
+    message.clear();
+    opcode = -1;
+
+    while (true) {
+        unsigned char header[2];
+        if (!receiveExactly(connection->socketHandle, (char*) header, 2)) return false;
+
+        bool isFinal = (header[0] & 0x80) != 0;
+        int frameOpcode = header[0] & 0x0F;
+        bool isMasked = (header[1] & 0x80) != 0;
+        uint64_t length = header[1] & 0x7F;
+        if (!isMasked) return false; // clients must mask every frame.
+
+        if (length == 126 || length == 127) { // extended payload length
+            unsigned char extended[8];
+            int extendedSize = (length == 126) ? 2 : 8;
+            if (!receiveExactly(connection->socketHandle, (char*) extended, extendedSize)) return false;
+            length = 0;
+            for (int i = 0 ; i < extendedSize ; i++)
+                length = (length << 8) | extended[i];
+        }
+        if (message.size() + length > STREAM_MAX_MESSAGE_SIZE) return false;
+
+        unsigned char mask[4];
+        if (!receiveExactly(connection->socketHandle, (char*) mask, 4)) return false;
+
+        string payload(length, '\0');
+        if (length > 0 && !receiveExactly(connection->socketHandle, &payload[0], length)) return false;
+        for (size_t i = 0 ; i < length ; i++)
+            payload[i] = (char) (payload[i] ^ mask[i % 4]);
+
+        switch (frameOpcode) {
+            case WEBSOCKET_OPCODE_PING:
+                sendFrame(connection, WEBSOCKET_OPCODE_PONG, payload);
+                continue;
+            case WEBSOCKET_OPCODE_PONG:
+                continue;
+            case WEBSOCKET_OPCODE_CLOSE:
+                sendFrame(connection, WEBSOCKET_OPCODE_CLOSE, payload.substr(0, 2)); // echo status code back
+                return false;
+            case WEBSOCKET_OPCODE_CONTINUATION:
+                if (opcode == -1) return false; // continuation without a first fragment
+                break;
+            case WEBSOCKET_OPCODE_TEXT:
+            case WEBSOCKET_OPCODE_BINARY:
+                if (opcode != -1) return false; // new message in the middle of a fragmented one
+                opcode = frameOpcode;
+                break;
+            default:
+                return false;
+        }
+
+        message += payload;
+        if (isFinal) return true;
+    }
+}
+
+/**
+ * A member function for class WebSocketServer that turns a message into records and queues them.
+ * Messages that cannot be parsed are ignored, just like malformed UDP frames.
+ * @param connection the client that sent the message.
+ * @param opcode the opcode of the message.
+ * @param message the payload of the message.
+ */
+void WebSocketServer::handleMessage(StreamConnection* connection, int opcode, const string& message) {
+    if (opcode == WEBSOCKET_OPCODE_BINARY) {
+        Frame frame;
+        if (!frame.parse((const uint8_t*) message.data(), message.size())) return;
+        for (auto const& record : frame.records)
+            this->queueRecord(connection, record);
+        return;
+    }
+
+    try {
+        json jsonData = json::parse(message);
+        FrameRecord record{};
+        if (jsonData.is_array()) {
+            for (auto const& x : jsonData)
+                if (this->parseTextRecord(x, record))
+                    this->queueRecord(connection, record);
+        } else if (this->parseTextRecord(jsonData, record)) {
+            this->queueRecord(connection, record);
+        }
+    } catch (const json::exception& e) {
+    }
+}
+
+/**
+ * A member function for class WebSocketServer that stores a record into the pending slot of its target.
+ * If the slot already had a record that was not applied yet, it is replaced and counted as superseded.
+ * @param connection the client that sent the record.
+ * @param record the record to queue.
+ */
+void WebSocketServer::queueRecord(StreamConnection* connection, const FrameRecord& record) {
+    uint16_t target = (uint16_t) ((record.sdkIndex << 8) | record.deviceType);
+    {
+        lock_guard<mutex> lock(connection->pendingMutex);
+        auto result = connection->pending.insert(std::make_pair(target, record));
+        if (!result.second) { // latest wins
+            result.first->second = record;
+            connection->supersededCount++;
+        }
+    }
+    connection->pendingCondition.notify_one();
+}
+
+/**
+ * A member function for class WebSocketServer that converts a json color message into a record.
+ * "sdk" is the lower case SDK name or "all", and defaults to "all" when it is missing.
+ * @param jsonData the json object to convert.
+ * @param record the converted record is stored here.
+ * @return returns true if the json object was a valid color message, false if not or if r, g or b is not in 0 - 255.
+ */
+bool WebSocketServer::parseTextRecord(const json& jsonData, FrameRecord& record) {
+    if (!jsonData.is_object()) return false;
+    string sdkName = jsonData.value("sdk", string("all"));
+    transform(sdkName.begin(), sdkName.end(), sdkName.begin(), ::tolower);
+
+    record.sdkIndex = FRAME_TARGET_ALL;
+    if (sdkName != "all") {
+        record.sdkIndex = 0xFE; // no such SDK
+        for (int i = 0 ; i < (int) this->sdks->size() ; i++) {
+            string lowerSDKName = this->sdks->at(i)->sdkName;
+            transform(lowerSDKName.begin(), lowerSDKName.end(), lowerSDKName.begin(), ::tolower);
+            if (lowerSDKName == sdkName) record.sdkIndex = (uint8_t) i;
+        }
+        if (record.sdkIndex == 0xFE) return false;
+    }
+
+    record.deviceType = (uint8_t) Misc::convertDeviceType(jsonData.value("DeviceType", string("All")));
+    record.deviceIndex = FRAME_TARGET_ALL;
+    int r = jsonData.value("r", 0);
+    int g = jsonData.value("g", 0);
+    int b = jsonData.value("b", 0);
+    if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) return false;
+    record.r = (uint8_t) r;
+    record.g = (uint8_t) g;
+    record.b = (uint8_t) b;
+    return true;
+}
+
+/**
+ * A member function for class WebSocketServer that marks a connection as closed and wakes up its threads.
+ * @param connection the client to close.
+ */
+void WebSocketServer::closeConnection(StreamConnection* connection) {
+    {
+        lock_guard<mutex> lock(connection->pendingMutex);
+        connection->closed = true;
+    }
+    connection->pendingCondition.notify_one();
+    SocketUtils::shutdownSocket(connection->socketHandle);
+}
+
+/**
+ * A member function for class WebSocketServer that joins and deletes connections that were closed.
+ * @param all if true, waits for every connection, not only the closed ones.
+ */
+void WebSocketServer::removeClosedConnections(bool all) {
+    for (auto it = this->connections.begin() ; it != this->connections.end() ;) {
+        StreamConnection* connection = *it;
+        if (!all && !connection->closed) {
+            it++;
+            continue;
+        }
+
+        connection->readThread->join();
+        delete connection->readThread;
+        if (connection->applyThread != nullptr) {
+            connection->applyThread->join();
+            delete connection->applyThread;
+        }
+        SocketUtils::closeSocket(connection->socketHandle);
+        delete connection;
+        it = this->connections.erase(it);
+    }
+}
+
+/**
+ * A static member function for class WebSocketServer that sends a single unmasked frame to a client.
+ * @param connection the client to send to.
+ * @param opcode the opcode of the frame.
+ * @param payload the payload of the frame.
+ * @return returns true if the whole frame was sent.
+ */
+bool WebSocketServer::sendFrame(StreamConnection* connection, int opcode, const string& payload) {
+    string frame;
+    frame += (char) (0x80 | opcode); // always final, server frames are never fragmented.
+    if (payload.size() < 126) {
+        frame += (char) payload.size();
+    } else if (payload.size() <= 0xFFFF) {
+        frame += (char) 126;
+        frame += (char) ((payload.size() >> 8) & 0xFF);
+        frame += (char) (payload.size() & 0xFF);
+    } else {
+        frame += (char) 127;
+        for (int i = 7 ; i >= 0 ; i--)
+            frame += (char) (((uint64_t) payload.size() >> (i * 8)) & 0xFF);
+    }
+    frame += payload;
+
+    lock_guard<mutex> lock(connection->writeMutex);
+    size_t sent = 0;
+    while (sent < frame.size()) {
+        int length = send(connection->socketHandle, frame.data() + sent, (int) (frame.size() - sent), 0);
+        if (length <= 0) return false;
+        sent += length;
+    }
+    return true;
+}
+
+/**
+ * A static member function for class WebSocketServer that receives exactly the given number of bytes.
+ * @param socketHandle the socket to receive from.
+ * @param buffer the buffer to store bytes into.
+ * @param length the number of bytes to receive.
+ * @return returns true if every byte was received, false if the socket was closed or failed.
+ */
+bool WebSocketServer::receiveExactly(SocketHandle socketHandle, char* buffer, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        int result = recv(socketHandle, buffer + received, (int) (length - received), 0);
+        if (result <= 0) return false;
+        received += result;
+    }
+    return true;
+}
+
+/**
+ * A static member function for class WebSocketServer that computes Sec-WebSocket-Accept from Sec-WebSocket-Key.
+ * @param key the value of Sec-WebSocket-Key.
+ * @return returns base64(sha1(key + GUID)) as described in RFC 6455.
+ */
+string WebSocketServer::computeAcceptKey(const string& key) {
+    return base64Encode(sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"));
+}
+
+/**
+ * A static member function for class WebSocketServer that computes SHA-1 digest.
+ * This is only used for the handshake, so it favours being short over being fast.
+ * @param input the bytes to hash.
+ * @return returns the 20 byte digest.
+ */
+string WebSocketServer::sha1(const string& input) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    string data = input;
+    uint64_t bitLength = (uint64_t) input.size() * 8;
+    data += (char) 0x80;
+    while (data.size() % 64 != 56) data += (char) 0x00;
+    for (int i = 7 ; i >= 0 ; i--) data += (char) ((bitLength >> (i * 8)) & 0xFF);
+
+    for (size_t chunk = 0 ; chunk < data.size() ; chunk += 64) {
+        uint32_t w[80];
+        for (int i = 0 ; i < 16 ; i++)
+            w[i] = ((uint32_t) (unsigned char) data[chunk + i * 4] << 24) |
+                   ((uint32_t) (unsigned char) data[chunk + i * 4 + 1] << 16) |
+                   ((uint32_t) (unsigned char) data[chunk + i * 4 + 2] << 8) |
+                   ((uint32_t) (unsigned char) data[chunk + i * 4 + 3]);
+        for (int i = 16 ; i < 80 ; i++) {
+            uint32_t x = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+            w[i] = (x << 1) | (x >> 31);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0 ; i < 80 ; i++) {
+            uint32_t f, k;
+            if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+
+            uint32_t temp = ((a << 5) | (a >> 27)) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = (b << 30) | (b >> 2);
+            b = a;
+            a = temp;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    string digest;
+    for (uint32_t x : h)
+        for (int i = 3 ; i >= 0 ; i--)
+            digest += (char) ((x >> (i * 8)) & 0xFF);
+    return digest;
+}
+
+/**
+ * A static member function for class WebSocketServer that encodes bytes into base64.
+ * @param input the bytes to encode.
+ * @return returns the base64 string with padding.
+ */
+string WebSocketServer::base64Encode(const string& input) {
+    static const char* table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string output;
+    size_t i = 0;
+    for (; i + 2 < input.size() ; i += 3) {
+        uint32_t x = ((unsigned char) input[i] << 16) | ((unsigned char) input[i + 1] << 8) | (unsigned char) input[i + 2];
+        output += table[(x >> 18) & 0x3F];
+        output += table[(x >> 12) & 0x3F];
+        output += table[(x >> 6) & 0x3F];
+        output += table[x & 0x3F];
+    }
+    if (i < input.size()) { // one or two bytes left
+        uint32_t x = (unsigned char) input[i] << 16;
+        if (i + 1 < input.size()) x |= (unsigned char) input[i + 1] << 8;
+        output += table[(x >> 18) & 0x3F];
+        output += table[(x >> 12) & 0x3F];
+        output += (i + 1 < input.size()) ? table[(x >> 6) & 0x3F] : '=';
+        output += '=';
+    }
+    return output;
+}
@@ -0,0 +1,123 @@
+//
+// @file : WebSocketServer.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class WebSocketServer
+//
+
+#ifndef RGBONREST_WEBSOCKETSERVER_H
+#define RGBONREST_WEBSOCKETSERVER_H
+#pragma once
+
+#include "../Utils/SocketUtils.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <list>
+#include <exception>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+#include "./Frame.h"
+#include "./StreamDispatcher.h"
+#include "../Utils/Defines.h"
+#include "../Utils/Misc.h"
+#include "../SDKEngine/AbstractSDK.h"
+
+using std::string;
+using std::thread;
+using std::atomic;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
+using std::map;
+using std::list;
+using std::exception;
+using std::transform;
+using std::cout;
+using std::endl;
+using json = nlohmann::json;
+
+#define WEBSOCKET_OPCODE_CONTINUATION 0x0
+#define WEBSOCKET_OPCODE_TEXT 0x1
+#define WEBSOCKET_OPCODE_BINARY 0x2
+#define WEBSOCKET_OPCODE_CLOSE 0x8
+#define WEBSOCKET_OPCODE_PING 0x9
+#define WEBSOCKET_OPCODE_PONG 0xA
+
+
+/**
+ * A struct that stores a single WebSocket client.
+ * Messages are read by readThread and stored into pending, which has one slot per (SDK, DeviceType) target.
+ * applyThread applies whatever is in pending, so a newer color for a target replaces an older one that was not applied
+ * yet. After every batch, applyThread tells the client how many colors it applied and how many were superseded.
+ */
+typedef struct streamConnection {
+    SocketHandle socketHandle;
+    thread* readThread = nullptr;
+    thread* applyThread = nullptr;
+    atomic<bool> closed{false};
+
+    mutex pendingMutex;
+    condition_variable pendingCondition;
+    map<uint16_t, FrameRecord> pending; // (sdkIndex << 8 | deviceType) -> latest record
+    uint64_t supersededCount = 0;
+
+    mutex writeMutex; // pongs from readThread and acks from applyThread must not interleave.
+} StreamConnection;
+
+/**
+ * A class that serves a WebSocket endpoint for streaming colors.
+ * cpprestsdk only implements WebSocket clients, so this listens on its own port and speaks RFC 6455 by itself.
+ * Binary messages are frames as described in Frame.h. Text messages are compact json such as
+ * {"sdk":"corsair","DeviceType":"Mouse","r":255,"g":0,"b":0}, or an array of those.
+ */
+class WebSocketServer {
+private:
+    string ip;
+    unsigned int port;
+    SocketHandle listenSocket;
+    thread* acceptThread;
+    atomic<bool> exitFlag{false};
+
+    vector<AbstractSDK*>* sdks;
+    list<StreamConnection*> connections;
+
+    void acceptLoop();
+    void readLoop(StreamConnection*);
+    void applyLoop(StreamConnection*);
+    bool performHandshake(StreamConnection*);
+    bool readMessage(StreamConnection*, int&, string&);
+    void handleMessage(StreamConnection*, int, const string&);
+    void queueRecord(StreamConnection*, const FrameRecord&);
+    bool parseTextRecord(const json&, FrameRecord&);
+    void closeConnection(StreamConnection*);
+    void removeClosedConnections(bool);
+    static bool sendFrame(StreamConnection*, int, const string&);
+    static bool receiveExactly(SocketHandle, char*, size_t);
+    static string computeAcceptKey(const string&);
+    static string sha1(const string&);
+    static string base64Encode(const string&);
+public:
+    atomic<uint64_t> appliedCount{0};
+    atomic<uint64_t> supersededCount{0};
+
+    WebSocketServer(const string&, unsigned int, vector<AbstractSDK*>*);
+    ~WebSocketServer();
+    void start();
+    void stop();
+
+    /**
+     * A class that is for exception when the listening socket could not be opened.
+     */
+    class socketFailedError : public exception {
+    };
+};
+
+
+#endif //RGBONREST_WEBSOCKETSERVER_H
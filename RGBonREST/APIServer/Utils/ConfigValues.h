@@ -9,10 +9,27 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <map>
 
 using std::string;
+using std::vector;
+using std::map;
 
 
+/**
+ * A struct that describes devices of a single DeviceType that VirtualSDK simulates.
+ * Every flush of such a device takes from minLatencyUs to maxLatencyUs, and fails with a chance of failureRate.
+ */
+typedef struct virtualDeviceConfig {
+    int deviceType;
+    unsigned int count;
+    unsigned int ledCount;
+    unsigned int minLatencyUs;
+    unsigned int maxLatencyUs;
+    double failureRate;
+} VirtualDeviceConfig;
+
 /**
  * A struct that is for saving config values for server.
  */
@@ -22,6 +39,26 @@ typedef struct configValues {
     string logFileName;
     string loggerName;
     bool logEnabled;
+    string logSynchronous;
+    unsigned int logSegmentCount;
+    unsigned int logSegmentRecords;
+    map<string, double> logSampleRates;
+    bool logCoalesce;
+    bool udpEnabled;
+    unsigned int udpPort;
+    bool streamEnabled;
+    unsigned int streamPort;
+    unsigned int effectFps;
+    unsigned int corsairFlushesInFlight;
+    vector<string> sdkBackends;
+    string pluginDirectory;
+    vector<string> plugins;
+    vector<VirtualDeviceConfig> virtualDevices;
+    unsigned int virtualFrameHistory;
+    unsigned int virtualSeed;
+    string openRGBHost;
+    unsigned int openRGBPort;
+    string sysfsLedsPath;
 } ConfigValues;
 
 
@@ -9,6 +9,24 @@
 #pragma once
 
 #define RGBONREST_VERSION "1.0.0_SNAPSHOT"
-#define SUPPORTED_SDK_COUNT 2
+#define SHUTDOWN_DRAIN_TIMEOUT_MS 5000 // How long to wait for in-flight handlers before closing listeners
+#define SDK_EXECUTOR_QUEUE_SIZE 64 // Maximum number of commands waiting for a single SDK before new ones are refused
+#define EFFECT_EXECUTOR_KEY_BASE 256 // Executor keys of effects, DeviceType keys below this belong to client set_rgb
+#define FRAMEBUFFER_EXECUTOR_KEY_BASE 512 // Executor keys of framebuffer segments
+#define ANIMATION_EXECUTOR_KEY_BASE 65536 // Executor keys of playing animations
+#define CORSAIR_FLUSH_ACK_TIMEOUT_MS 1000 // How long to wait for iCUE to acknowledge a flush before treating it as failed
+#define CORSAIR_FLUSH_FAIL_HISTORY 256 // How many failed flushes are remembered for requests that wait for acks
+#define RAZER_EFFECT_CACHE_SIZE 64 // Maximum number of Chroma effects kept alive for reuse before the oldest is deleted
+#define RAZER_ANIMATION_MAX_FRAMES 600 // Maximum number of frames of a single uploaded Razer animation
+#define OPENRGB_RECEIVE_TIMEOUT_MS 2000 // How long to wait for an OpenRGB server to answer while connecting
+#define OPENRGB_MAX_PACKET_SIZE 16777216 // Maximum payload size of a packet from an OpenRGB server
+#define LOGGER_RING_SIZE 8192 // Maximum number of log entries waiting for the writer before new ones are dropped
+#define LOGGER_BATCH_SIZE 1024 // Maximum number of log entries written in a single transaction
+#define LOGGER_FLUSH_INTERVAL_MS 100 // How often the writer wakes up to write log entries that are waiting
+#define LOGGER_COALESCE_MAX_MS 1000 // Longest time a run of identical log entries is held before it is written as one
+#define STREAM_RECEIVE_TIMEOUT_MS 250 // How often stream servers wake up from a blocking receive to check for stop
+#define STREAM_MAX_CONNECTIONS 16 // Maximum number of WebSocket stream clients at once
+#define STREAM_MAX_HANDSHAKE_SIZE 8192 // Maximum size of WebSocket handshake request headers
+#define STREAM_MAX_MESSAGE_SIZE 65536 // Maximum size of a single WebSocket message
 
 #endif //RGBONREST_DEFINES_H
@@ -7,16 +7,6 @@
 #include "Misc.h"
 
 
-/**
- * A static member function for class Misc that converts std::string object to std::wstring object.
- * @param argString the std::string object to transform into std::wstring
- * @return returns std::wstring that represents converted string.
- */
-wstring Misc::convertWstring(string argString) {
-    wstring newString = wstring(argString.begin(), argString.end());
-    return newString;
-}
-
 /**
  * A static member function for class Misc that reads config.json and stores everything into ConfigValues struct.
  * @return returns ConfigValues type value that represents values from config.json
@@ -33,7 +23,30 @@ ConfigValues Misc::readConfig() {
         "host_port": 9000,
         "log_logger": "sqlite3",
         "log_logfile": "log.db",
-        "log_enabled": true
+        "log_enabled": true,
+        "log_synchronous": "NORMAL",
+        "log_segments": 8,
+        "log_segment_records": 131072,
+        "log_sample_rates": {},
+        "log_coalesce": false,
+        "udp_enabled": true,
+        "udp_port": 9001,
+        "stream_enabled": true,
+        "stream_port": 9002,
+        "effect_fps": 30,
+        "corsair_flushes_in_flight": 2,
+        "sdk_backends": ["corsair", "razer"],
+        "plugin_directory": "plugins",
+        "plugins": [],
+        "virtual_devices": [
+          {"DeviceType": "Keyboard", "count": 1, "leds": 104, "latency_min_us": 500, "latency_max_us": 2000, "failure_rate": 0.0},
+          {"DeviceType": "Mouse", "count": 1, "leds": 3, "latency_min_us": 500, "latency_max_us": 2000, "failure_rate": 0.0}
+        ],
+        "virtual_frame_history": 1024,
+        "virtual_seed": 1,
+        "openrgb_host": "127.0.0.1",
+        "openrgb_port": 6742,
+        "sysfs_leds_path": "/sys/class/leds"
       }
     )"_json;
 
@@ -74,6 +87,27 @@ ConfigValues Misc::readConfig() {
         values.loggerName = jsonData["log_logger"];
         values.logFileName = jsonData["log_logfile"];
         values.logEnabled = jsonData["log_enabled"];
+        // Keys below were added later, so config.json files from older versions may not have them.
+        values.udpEnabled = jsonData.value("udp_enabled", (bool) defaultContent["udp_enabled"]);
+        values.udpPort = jsonData.value("udp_port", (unsigned int) defaultContent["udp_port"]);
+        values.streamEnabled = jsonData.value("stream_enabled", (bool) defaultContent["stream_enabled"]);
+        values.streamPort = jsonData.value("stream_port", (unsigned int) defaultContent["stream_port"]);
+        values.effectFps = jsonData.value("effect_fps", (unsigned int) defaultContent["effect_fps"]);
+        values.corsairFlushesInFlight = jsonData.value("corsair_flushes_in_flight", (unsigned int) defaultContent["corsair_flushes_in_flight"]);
+        values.sdkBackends = jsonData.value("sdk_backends", defaultContent["sdk_backends"].get<vector<string>>());
+        values.pluginDirectory = jsonData.value("plugin_directory", (string) defaultContent["plugin_directory"]);
+        values.plugins = jsonData.value("plugins", defaultContent["plugins"].get<vector<string>>());
+        values.virtualDevices = Misc::parseVirtualDevices(jsonData.value("virtual_devices", defaultContent["virtual_devices"]));
+        values.virtualFrameHistory = jsonData.value("virtual_frame_history", (unsigned int) defaultContent["virtual_frame_history"]);
+        values.virtualSeed = jsonData.value("virtual_seed", (unsigned int) defaultContent["virtual_seed"]);
+        values.openRGBHost = jsonData.value("openrgb_host", (string) defaultContent["openrgb_host"]);
+        values.openRGBPort = jsonData.value("openrgb_port", (unsigned int) defaultContent["openrgb_port"]);
+        values.sysfsLedsPath = jsonData.value("sysfs_leds_path", (string) defaultContent["sysfs_leds_path"]);
+        values.logSynchronous = jsonData.value("log_synchronous", (string) defaultContent["log_synchronous"]);
+        values.logSegmentCount = jsonData.value("log_segments", (unsigned int) defaultContent["log_segments"]);
+        values.logSegmentRecords = jsonData.value("log_segment_records", (unsigned int) defaultContent["log_segment_records"]);
+        values.logSampleRates = jsonData.value("log_sample_rates", defaultContent["log_sample_rates"].get<map<string, double>>());
+        values.logCoalesce = jsonData.value("log_coalesce", (bool) defaultContent["log_coalesce"]);
     } catch (const json::exception& e) { // If not possible, set it to default.
         cout << "[-] Cannot parse config.json, using default settings..." << endl;
         values.ip = defaultContent["host_ip"];
@@ -81,10 +115,52 @@ ConfigValues Misc::readConfig() {
         values.loggerName = defaultContent["log_logger"];
         values.logFileName = defaultContent["log_logfile"];
         values.logEnabled = defaultContent["log_enabled"];
+        values.udpEnabled = defaultContent["udp_enabled"];
+        values.udpPort = defaultContent["udp_port"];
+        values.streamEnabled = defaultContent["stream_enabled"];
+        values.streamPort = defaultContent["stream_port"];
+        values.effectFps = defaultContent["effect_fps"];
+        values.corsairFlushesInFlight = defaultContent["corsair_flushes_in_flight"];
+        values.sdkBackends = defaultContent["sdk_backends"].get<vector<string>>();
+        values.pluginDirectory = defaultContent["plugin_directory"];
+        values.plugins = defaultContent["plugins"].get<vector<string>>();
+        values.virtualDevices = Misc::parseVirtualDevices(defaultContent["virtual_devices"]);
+        values.virtualFrameHistory = defaultContent["virtual_frame_history"];
+        values.virtualSeed = defaultContent["virtual_seed"];
+        values.openRGBHost = defaultContent["openrgb_host"];
+        values.openRGBPort = defaultContent["openrgb_port"];
+        values.sysfsLedsPath = defaultContent["sysfs_leds_path"];
+        values.logSynchronous = defaultContent["log_synchronous"];
+        values.logSegmentCount = defaultContent["log_segments"];
+        values.logSegmentRecords = defaultContent["log_segment_records"];
+        values.logSampleRates = defaultContent["log_sample_rates"].get<map<string, double>>();
+        values.logCoalesce = defaultContent["log_coalesce"];
     }
     return values;
 }
 
+/**
+ * A static member function for class Misc that reads virtual_devices of config.json.
+ * Missing keys of a device fall back to a single device with a single LED, no latency and no failures.
+ * @param jsonData the array under virtual_devices.
+ * @return returns a VirtualDeviceConfig for each item, in the same order.
+ * @throws json::exception when jsonData was not an array of objects, or a value had a wrong type.
+ */
+vector<VirtualDeviceConfig> Misc::parseVirtualDevices(const json& jsonData) {
+    vector<VirtualDeviceConfig> deviceConfigs;
+    for (auto const& x : jsonData) {
+        VirtualDeviceConfig config;
+        config.deviceType = Misc::convertDeviceType(x.value("DeviceType", string("ETC")));
+        config.count = x.value("count", (unsigned int) 1);
+        config.ledCount = x.value("leds", (unsigned int) 1);
+        config.minLatencyUs = x.value("latency_min_us", (unsigned int) 0);
+        config.maxLatencyUs = x.value("latency_max_us", config.minLatencyUs);
+        config.failureRate = x.value("failure_rate", 0.0);
+        deviceConfigs.push_back(config);
+    }
+    return deviceConfigs;
+}
+
 /**
  * A member function for class Misc that converts device type enumeration value into string.
  * @param enumValue an integer value that represents DeviceType enum
@@ -16,7 +16,6 @@
 
 #include "ConfigValues.h"
 
-using std::wstring;
 using std::string;
 using std::cout;
 using std::endl;
@@ -29,8 +28,8 @@ using json = nlohmann::json;
  */
 class Misc {
 public:
-    static wstring convertWstring(string);
     static ConfigValues readConfig();
+    static vector<VirtualDeviceConfig> parseVirtualDevices(const json&);
     static string convertDeviceType(int);
     static int convertDeviceType(const string&);
 };
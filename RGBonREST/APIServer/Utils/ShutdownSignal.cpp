@@ -0,0 +1,76 @@
+//
+// @file : ShutdownSignal.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class ShutdownSignal
+//
+
+#include "ShutdownSignal.h"
+
+
+/**
+ * A constructor member function for class ShutdownSignal.
+ * The write end of the pipe does not block, so that notify never waits even if it was called many times.
+ * @throws ShutdownSignal::creationFailedError when the pipe or event could not be created.
+ */
+ShutdownSignal::ShutdownSignal() {
+#ifdef _WIN32
+    this->eventHandle = CreateEventA(nullptr, TRUE, FALSE, nullptr); // stays set, so every waiter wakes up
+    if (this->eventHandle == nullptr) throw ShutdownSignal::creationFailedError();
+#else
+    int fds[2];
+    if (pipe(fds) != 0) throw ShutdownSignal::creationFailedError();
+    this->readFd = fds[0];
+    this->writeFd = fds[1];
+    fcntl(this->readFd, F_SETFD, FD_CLOEXEC);
+    fcntl(this->writeFd, F_SETFD, FD_CLOEXEC);
+    fcntl(this->writeFd, F_SETFL, fcntl(this->writeFd, F_GETFL) | O_NONBLOCK);
+#endif
+}
+
+/**
+ * A destructor member function for class ShutdownSignal.
+ * No thread may be inside wait when this is called.
+ */
+ShutdownSignal::~ShutdownSignal() {
+#ifdef _WIN32
+    CloseHandle(this->eventHandle);
+#else
+    close(this->readFd);
+    close(this->writeFd);
+#endif
+}
+
+/**
+ * A member function for class ShutdownSignal that wakes up every thread in wait, now and in the future.
+ * This is async signal safe, so it can be called from a signal handler.
+ */
+void ShutdownSignal::notify() {
+#ifdef _WIN32
+    SetEvent(this->eventHandle);
+#else
+    int savedErrno = errno; // a signal handler must leave errno as it found it
+    char byte = 1;
+    ssize_t ignored = write(this->writeFd, &byte, 1); // a full pipe means someone already notified
+    (void) ignored;
+    errno = savedErrno;
+#endif
+}
+
+/**
+ * A member function for class ShutdownSignal that blocks until notify was called.
+ * This returns right away if notify was called before. The byte in the pipe is never read, so it stays readable.
+ */
+void ShutdownSignal::wait() {
+#ifdef _WIN32
+    WaitForSingleObject(this->eventHandle, INFINITE);
+#else
+    fd_set readSet;
+    while (true) {
+        FD_ZERO(&readSet);
+        FD_SET(this->readFd, &readSet);
+        int result = select(this->readFd + 1, &readSet, nullptr, nullptr, nullptr); // no timeout
+        if (result > 0) return;
+        if (result < 0 && errno != EINTR) return; // the pipe is broken, do not spin on it
+    }
+#endif
+}
@@ -0,0 +1,53 @@
+//
+// @file : ShutdownSignal.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class ShutdownSignal
+//
+
+#ifndef RGBONREST_SHUTDOWNSIGNAL_H
+#define RGBONREST_SHUTDOWNSIGNAL_H
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <cerrno>
+#endif
+
+#include <exception>
+
+using std::exception;
+
+
+/**
+ * A class that parks a thread until another thread, or a signal handler, asks it to wake up.
+ * A condition variable can not be notified from a signal handler, so this is a self pipe on POSIX and a manual reset
+ * event on Windows. notify only makes a single write() or SetEvent, which are safe inside a signal handler, and wait
+ * blocks without any timeout, so a parked thread costs no CPU at all.
+ */
+class ShutdownSignal {
+private:
+#ifdef _WIN32
+    HANDLE eventHandle;
+#else
+    int readFd;
+    int writeFd;
+#endif
+public:
+    ShutdownSignal();
+    ~ShutdownSignal();
+    void notify();
+    void wait();
+
+    /**
+     * A class that is for exception when the pipe or event could not be created.
+     */
+    class creationFailedError : public exception {
+    };
+};
+
+
+#endif //RGBONREST_SHUTDOWNSIGNAL_H
@@ -0,0 +1,100 @@
+//
+// @file : SocketUtils.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that implements all member functions for class SocketUtils
+//
+
+#include "SocketUtils.h"
+
+
+/**
+ * A static member function for class SocketUtils that initializes the socket library.
+ * This calls WSAStartup on Windows and does nothing on other platforms. Every successful call needs a cleanup().
+ * @return returns true if sockets can be used.
+ */
+bool SocketUtils::initialize() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+#else
+    return true;
+#endif
+}
+
+/**
+ * A static member function for class SocketUtils that releases the socket library.
+ */
+void SocketUtils::cleanup() {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+/**
+ * A static member function for class SocketUtils that closes a socket.
+ * @param socketHandle the socket to close.
+ */
+void SocketUtils::closeSocket(SocketHandle socketHandle) {
+#ifdef _WIN32
+    closesocket(socketHandle);
+#else
+    close(socketHandle);
+#endif
+}
+
+/**
+ * A static member function for class SocketUtils that shuts down both directions of a socket.
+ * This wakes up any thread that is blocked on the socket, without closing the handle under its feet.
+ * @param socketHandle the socket to shut down.
+ */
+void SocketUtils::shutdownSocket(SocketHandle socketHandle) {
+#ifdef _WIN32
+    shutdown(socketHandle, SD_BOTH);
+#else
+    shutdown(socketHandle, SHUT_RDWR);
+#endif
+}
+
+/**
+ * A static member function for class SocketUtils that sets how long a blocking receive may wait.
+ * @param socketHandle the socket to set timeout for.
+ * @param milliseconds the timeout in milliseconds.
+ * @return returns true if timeout was set.
+ */
+bool SocketUtils::setReceiveTimeout(SocketHandle socketHandle, int milliseconds) {
+#ifdef _WIN32
+    DWORD timeout = milliseconds;
+#else
+    timeval timeout{};
+    timeout.tv_sec = milliseconds / 1000;
+    timeout.tv_usec = (milliseconds % 1000) * 1000;
+#endif
+    return setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, (const char*) &timeout, sizeof(timeout)) == 0;
+}
+
+/**
+ * A static member function for class SocketUtils that checks if a socket can be read without waiting.
+ * @param socketHandle the socket to check.
+ * @return returns true if data, or the other side closing the connection, is waiting to be received.
+ */
+bool SocketUtils::isReadable(SocketHandle socketHandle) {
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(socketHandle, &readSet);
+    timeval timeout{}; // zero, so that select only looks
+    return select((int) socketHandle + 1, &readSet, nullptr, nullptr, &timeout) > 0;
+}
+
+/**
+ * A static member function for class SocketUtils that fills sockaddr_in from an IPv4 address and a port.
+ * @param ip the IPv4 address in dotted notation.
+ * @param port the port number.
+ * @param address the sockaddr_in to fill.
+ * @return returns true if ip was a valid IPv4 address.
+ */
+bool SocketUtils::fillAddress(const string& ip, unsigned int port, sockaddr_in& address) {
+    address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short) port);
+    return inet_pton(AF_INET, ip.c_str(), &address.sin_addr) == 1;
+}
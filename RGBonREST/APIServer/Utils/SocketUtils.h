@@ -0,0 +1,52 @@
+//
+// @file : SocketUtils.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines all member functions for class SocketUtils
+//
+
+#ifndef RGBONREST_SOCKETUTILS_H
+#define RGBONREST_SOCKETUTILS_H
+#pragma once
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+typedef SOCKET SocketHandle;
+#define MSG_NOSIGNAL 0 // Winsock never raises SIGPIPE
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+
+typedef int SocketHandle;
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#endif
+
+#include <string>
+
+using std::string;
+
+
+/**
+ * A class that is a set of static member functions for hiding the differences between Winsock and BSD sockets.
+ */
+class SocketUtils {
+public:
+    static bool initialize();
+    static void cleanup();
+    static void closeSocket(SocketHandle);
+    static void shutdownSocket(SocketHandle);
+    static bool setReceiveTimeout(SocketHandle, int);
+    static bool isReadable(SocketHandle);
+    static bool fillAddress(const string&, unsigned int, sockaddr_in&);
+};
+
+
+#endif //RGBONREST_SOCKETUTILS_H
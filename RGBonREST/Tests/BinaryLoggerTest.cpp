@@ -0,0 +1,155 @@
+//
+// @file : BinaryLoggerTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks records written by BinaryLogger come back out of BinaryLogReader as they went in
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include "TestUtils.h"
+#include "../APIServer/RESTServer/Logger/BinaryLogger.h"
+
+using std::string;
+using std::vector;
+using std::ifstream;
+
+
+/**
+ * A function that removes every segment file of a log, so that every run starts empty.
+ * @param baseName the name that segment files are named after.
+ * @param segmentCount how many segment files there are.
+ */
+void removeSegments(const string& baseName, uint32_t segmentCount) {
+    for (uint32_t i = 0 ; i < segmentCount ; i++)
+        remove(binaryLogSegmentName(baseName, i).c_str());
+}
+
+/**
+ * A function that runs BinaryLogReader over every segment of a log and reads the CSV it wrote.
+ * @param readerPath the path of the BinaryLogReader executable.
+ * @param baseName the name that segment files are named after.
+ * @param segmentCount how many segment files there are.
+ * @return returns every row of the CSV split into columns, without the header, or nothing if the reader failed.
+ */
+vector<vector<string>> readCsv(const string& readerPath, const string& baseName, uint32_t segmentCount) {
+    string csvName = baseName + ".csv";
+    string command = "\"" + readerPath + "\" csv \"" + csvName + "\"";
+    for (uint32_t i = 0 ; i < segmentCount ; i++)
+        command += " \"" + binaryLogSegmentName(baseName, i) + "\"";
+
+    vector<vector<string>> rows;
+    if (system(command.c_str()) != 0)
+        return rows;
+
+    ifstream file(csvName);
+    string line;
+    std::getline(file, line);
+    CHECK(line == "sequence,time,endpoint,target,r,g,b,status,latency_us,count,span_ms");
+    while (std::getline(file, line)) {
+        vector<string> columns;
+        std::stringstream stream(line);
+        string column;
+        while (std::getline(stream, column, ','))
+            columns.push_back(column);
+        if (!line.empty() && line.back() == ',') columns.push_back(""); // getline drops an empty last column
+        rows.push_back(columns);
+    }
+    remove(csvName.c_str());
+    return rows;
+}
+
+/**
+ * A function that checks every field of a record makes the round trip, including records without a target or color.
+ * @param readerPath the path of the BinaryLogReader executable.
+ * @param baseName the name that segment files are named after.
+ */
+void testRoundTrip(const string& readerPath, const string& baseName) {
+    removeSegments(baseName, 2);
+    {
+        BinaryLogger logger(baseName, 2, 8);
+        LogEntry entry;
+        entry.endpoint = "/virtual/set_rgb";
+        entry.statusCode = 200;
+        entry.target = 3; // Keyboard
+        entry.r = 255;
+        entry.g = 128;
+        entry.b = 0;
+        entry.latencyUs = 1234;
+        entry.count = 7;
+        entry.spanUs = 25000;
+        logger.logRequest(entry);
+
+        logger.log("/general/connection", "", "Success");
+    }
+
+    vector<vector<string>> rows = readCsv(readerPath, baseName, 2);
+    CHECK(rows.size() == 2);
+    if (rows.size() == 2) {
+        CHECK(rows[0].size() == 11);
+        CHECK(rows[0][0] == "1");
+        CHECK(rows[0][2] == "/virtual/set_rgb");
+        CHECK(rows[0][3] == "Keyboard");
+        CHECK(rows[0][4] == "255" && rows[0][5] == "128" && rows[0][6] == "0");
+        CHECK(rows[0][7] == "200");
+        CHECK(rows[0][8] == "1234");
+        CHECK(rows[0][9] == "7");
+        CHECK(rows[0][10] == "25");
+
+        CHECK(rows[1].size() == 11);
+        CHECK(rows[1][0] == "2");
+        CHECK(rows[1][2] == "/general/connection");
+        CHECK(rows[1][3].empty());
+        CHECK(rows[1][4].empty() && rows[1][5].empty() && rows[1][6].empty());
+        CHECK(rows[1][9] == "1");
+    }
+    removeSegments(baseName, 2);
+}
+
+/**
+ * A function that checks the segments make up a ring that keeps the newest records, and that a reopened log
+ * continues after its newest record.
+ * @param readerPath the path of the BinaryLogReader executable.
+ * @param baseName the name that segment files are named after.
+ */
+void testRing(const string& readerPath, const string& baseName) {
+    removeSegments(baseName, 2);
+    {
+        BinaryLogger logger(baseName, 2, 4);
+        for (int i = 0 ; i < 10 ; i++)
+            logger.log("/all/set_rgb", "", "Success");
+        CHECK(logger.getStatistics()["overwritten"] == 2);
+    }
+    {
+        BinaryLogger logger(baseName, 2, 4);
+        logger.log("/all/get_devices", "", "Success");
+        CHECK(logger.getStatistics()["logged"] == 1);
+    }
+
+    vector<vector<string>> rows = readCsv(readerPath, baseName, 2);
+    CHECK(rows.size() == 8);
+    for (size_t i = 0 ; i < rows.size() ; i++)
+        CHECK(rows[i][0] == std::to_string(i + 4)); // 1 to 3 were overwritten
+    if (!rows.empty())
+        CHECK(rows.back()[2] == "/all/get_devices");
+    removeSegments(baseName, 2);
+}
+
+/**
+ * A function that runs every check.
+ * Usage: BinaryLoggerTest <path of BinaryLogReader> [directory for segment files]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: %s <path of BinaryLogReader> [directory for segment files]\n", argv[0]);
+        return 1;
+    }
+    string baseName = string(argc > 2 ? argv[2] : ".") + "/binary_logger_test.bin";
+    testRoundTrip(argv[1], baseName);
+    testRing(argv[1], baseName);
+    return finishTest();
+}
@@ -0,0 +1,122 @@
+//
+// @file : CorsairSDKTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that runs CorsairSDK against FakeCUESDK and checks the LED topology is cached at connect
+//
+
+#include <cstdio>
+#include <vector>
+
+#include "TestUtils.h"
+#include "fakes/FakeCUESDK.h"
+#include "../APIServer/SDKEngine/CorsairSDK/CorsairSDK.h"
+
+using std::vector;
+
+
+/**
+ * A function that returns the buffer calls of a device.
+ * @param calls the calls from FakeCUESDK::getBufferCalls.
+ * @param deviceIndex the index of the device.
+ * @return returns the calls of the device, in order.
+ */
+vector<FakeCorsairBufferCall> callsOf(const vector<FakeCorsairBufferCall>& calls, int deviceIndex) {
+    vector<FakeCorsairBufferCall> found;
+    for (auto const& x : calls)
+        if (x.deviceIndex == deviceIndex) found.push_back(x);
+    return found;
+}
+
+/**
+ * A function that checks a buffer call has every LED of a device, ids from 1 in order, all in a single color.
+ * @param call the call to check.
+ * @param ledCount the number of LEDs of the device.
+ * @param r the r value every LED should have.
+ * @param g the g value every LED should have.
+ * @param b the b value every LED should have.
+ */
+void checkBufferCall(const FakeCorsairBufferCall& call, int ledCount, int r, int g, int b) {
+    CHECK((int) call.leds.size() == ledCount);
+    for (size_t i = 0 ; i < call.leds.size() ; i++) {
+        CHECK(call.leds[i].ledId == static_cast<CorsairLedId>(i + 1));
+        CHECK(call.leds[i].r == r && call.leds[i].g == g && call.leds[i].b == b);
+    }
+}
+
+/**
+ * A function that checks LED positions are only asked for at connect, and setting RGB afterwards hands iCUE the same
+ * cached array with the same ids, with only the colors rewritten.
+ */
+void testTopologyIsCached() {
+    FakeCUESDK::reset({{CDT_Keyboard, 120, false}, {CDT_Mouse, 4, false}, {CDT_Headset, 0, false}}, 0);
+    CorsairSDK sdk(0);
+    sdk.connect();
+    CHECK(FakeCUESDK::getPositionQueryCount() == 3);
+
+    sdk.setRGB(DeviceType::Keyboard, 255, 0, 0);
+    sdk.setRGB(DeviceType::Keyboard, 0, 255, 0);
+    sdk.setRGB(DeviceType::Mouse, 0, 0, 255);
+    sdk.setRGB(DeviceType::Mouse, 1, 2, 3);
+    CHECK(FakeCUESDK::getPositionQueryCount() == 3); // nothing asked again
+
+    vector<FakeCorsairBufferCall> calls = FakeCUESDK::getBufferCalls();
+    vector<FakeCorsairBufferCall> keyboard = callsOf(calls, 0);
+    vector<FakeCorsairBufferCall> mouse = callsOf(calls, 1);
+    CHECK(keyboard.size() == 2);
+    CHECK(mouse.size() == 2);
+    if (keyboard.size() != 2 || mouse.size() != 2) return;
+
+    CHECK(keyboard[0].ledsColors == keyboard[1].ledsColors); // the same cached array
+    CHECK(mouse[0].ledsColors == mouse[1].ledsColors);
+    CHECK(keyboard[0].ledsColors != mouse[0].ledsColors);
+    checkBufferCall(keyboard[0], 120, 255, 0, 0);
+    checkBufferCall(keyboard[1], 120, 0, 255, 0);
+    checkBufferCall(mouse[0], 4, 0, 0, 255);
+    checkBufferCall(mouse[1], 4, 1, 2, 3);
+    sdk.disconnect();
+}
+
+/**
+ * A function that checks a device without LED positions is never handed to iCUE.
+ */
+void testDeviceWithoutLeds() {
+    FakeCUESDK::reset({{CDT_Headset, 0, false}, {CDT_Headset, 2, false}}, 0);
+    CorsairSDK sdk(0);
+    sdk.connect();
+    sdk.setRGB(DeviceType::Headset, 10, 20, 30);
+
+    vector<FakeCorsairBufferCall> calls = FakeCUESDK::getBufferCalls();
+    CHECK(callsOf(calls, 0).empty());
+    CHECK(callsOf(calls, 1).size() == 1);
+    if (calls.size() == 1) checkBufferCall(calls.front(), 2, 10, 20, 30);
+    sdk.disconnect();
+}
+
+/**
+ * A function that checks reconnecting asks for positions again, since devices may have changed meanwhile.
+ */
+void testReconnect() {
+    FakeCUESDK::reset({{CDT_Mouse, 4, false}}, 0);
+    CorsairSDK sdk(0);
+    sdk.connect();
+    sdk.disconnect();
+    FakeCUESDK::reset({{CDT_Mouse, 6, false}}, 0);
+    sdk.connect();
+    CHECK(FakeCUESDK::getPositionQueryCount() == 1);
+
+    sdk.setRGB(DeviceType::Mouse, 7, 8, 9);
+    vector<FakeCorsairBufferCall> calls = FakeCUESDK::getBufferCalls();
+    CHECK(calls.size() == 1);
+    if (calls.size() == 1) checkBufferCall(calls.front(), 6, 7, 8, 9);
+    sdk.disconnect();
+}
+
+/**
+ * A function that runs every check.
+ */
+int main() {
+    testTopologyIsCached();
+    testDeviceWithoutLeds();
+    testReconnect();
+    return finishTest();
+}
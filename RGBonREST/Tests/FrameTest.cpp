@@ -0,0 +1,91 @@
+//
+// @file : FrameTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks Frame parses well formed frames, refuses malformed ones, and orders sequence numbers
+//
+
+#include <vector>
+
+#include "TestUtils.h"
+#include "../APIServer/StreamServer/Frame.h"
+
+using std::vector;
+
+
+/**
+ * A function that builds a frame.
+ * @param sequence the sequence number of the frame.
+ * @param records the records of the frame, FRAME_RECORD_SIZE bytes each.
+ * @return returns the bytes of the frame.
+ */
+vector<uint8_t> buildFrame(uint32_t sequence, const vector<uint8_t>& records) {
+    vector<uint8_t> data = {FRAME_MAGIC_0, FRAME_MAGIC_1, FRAME_VERSION, (uint8_t) (records.size() / FRAME_RECORD_SIZE),
+                            (uint8_t) (sequence >> 24), (uint8_t) (sequence >> 16), (uint8_t) (sequence >> 8),
+                            (uint8_t) sequence};
+    data.insert(data.end(), records.begin(), records.end());
+    return data;
+}
+
+/**
+ * A function that checks a well formed frame is parsed with every field.
+ */
+void testParse() {
+    Frame frame;
+    vector<uint8_t> data = buildFrame(0x01020304, {0, 3, FRAME_TARGET_ALL, 255, 128, 0,
+                                                   FRAME_TARGET_ALL, 1, FRAME_TARGET_ALL, 1, 2, 3});
+    CHECK(frame.parse(data.data(), data.size()));
+    CHECK(frame.sequence == 0x01020304);
+    CHECK(frame.records.size() == 2);
+    CHECK(frame.records[0].sdkIndex == 0);
+    CHECK(frame.records[0].deviceType == 3);
+    CHECK(frame.records[0].deviceIndex == FRAME_TARGET_ALL);
+    CHECK(frame.records[0].r == 255 && frame.records[0].g == 128 && frame.records[0].b == 0);
+    CHECK(frame.records[1].sdkIndex == FRAME_TARGET_ALL);
+    CHECK(frame.records[1].r == 1 && frame.records[1].g == 2 && frame.records[1].b == 3);
+
+    data = buildFrame(7, {}); // a frame without records is still a frame
+    CHECK(frame.parse(data.data(), data.size()));
+    CHECK(frame.sequence == 7);
+    CHECK(frame.records.empty());
+}
+
+/**
+ * A function that checks malformed frames are refused.
+ */
+void testMalformed() {
+    Frame frame;
+    vector<uint8_t> data = buildFrame(1, {0, 3, FRAME_TARGET_ALL, 255, 0, 0});
+    CHECK(!frame.parse(data.data(), FRAME_HEADER_SIZE - 1)); // shorter than the header
+    CHECK(!frame.parse(data.data(), data.size() - 1)); // record count does not match the length
+
+    vector<uint8_t> longer = data;
+    longer.push_back(0);
+    CHECK(!frame.parse(longer.data(), longer.size()));
+
+    vector<uint8_t> badMagic = data;
+    badMagic[1] = 'X';
+    CHECK(!frame.parse(badMagic.data(), badMagic.size()));
+
+    vector<uint8_t> badVersion = data;
+    badVersion[2] = FRAME_VERSION + 1;
+    CHECK(!frame.parse(badVersion.data(), badVersion.size()));
+}
+
+/**
+ * A function that checks sequence numbers are ordered with serial number arithmetic.
+ */
+void testIsNewer() {
+    CHECK(Frame::isNewer(2, 1));
+    CHECK(!Frame::isNewer(1, 2));
+    CHECK(!Frame::isNewer(5, 5));
+    CHECK(Frame::isNewer(0, 0xFFFFFFFF)); // wrapped around
+    CHECK(Frame::isNewer(3, 0xFFFFFFF0));
+    CHECK(!Frame::isNewer(0xFFFFFFF0, 3));
+}
+
+int main() {
+    testParse();
+    testMalformed();
+    testIsNewer();
+    return finishTest();
+}
@@ -0,0 +1,136 @@
+//
+// @file : LogRingTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks LogRing keeps order, refuses pushes when full, and loses nothing between threads
+//
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+
+#include "TestUtils.h"
+#include "../APIServer/RESTServer/Logger/LogRing.h"
+
+using std::vector;
+
+
+/**
+ * A function that makes a LogEntry with only strings.
+ * @param endpoint the endpoint of the entry.
+ * @param parameters the parameters of the entry.
+ * @return returns the LogEntry.
+ */
+LogEntry makeEntry(const string& endpoint, const string& parameters) {
+    LogEntry entry;
+    entry.endpoint = endpoint;
+    entry.parameters = parameters;
+    entry.result = "Success";
+    return entry;
+}
+
+/**
+ * A function that checks records come out in the order they were pushed, with their fields.
+ */
+void testOrder() {
+    LogRing ring(4);
+    LogRecord record;
+    CHECK(!ring.pop(record));
+
+    LogEntry entry = makeEntry("/virtual/set_rgb", "first");
+    entry.count = 3;
+    entry.spanUs = 2500;
+    CHECK(ring.push(entry, 100));
+    CHECK(ring.push(makeEntry("/virtual/set_rgb", "second"), 101));
+
+    CHECK(ring.pop(record));
+    CHECK(record.time == 100);
+    CHECK(record.count == 3);
+    CHECK(record.spanMs == 2);
+    CHECK(strcmp(record.endpoint, "/virtual/set_rgb") == 0);
+    CHECK(strcmp(record.parameters, "first") == 0);
+    CHECK(strcmp(record.result, "Success") == 0);
+    CHECK(ring.pop(record));
+    CHECK(strcmp(record.parameters, "second") == 0);
+    CHECK(!ring.pop(record));
+}
+
+/**
+ * A function that checks the capacity is rounded up to a power of two, and a full ring refuses pushes until a
+ * record is popped.
+ */
+void testFull() {
+    LogRing ring(3); // rounded up to 4
+    for (int i = 0 ; i < 4 ; i++)
+        CHECK(ring.push(makeEntry("/general/connection", std::to_string(i)), i));
+    CHECK(!ring.push(makeEntry("/general/connection", "refused"), 4));
+
+    LogRecord record;
+    CHECK(ring.pop(record));
+    CHECK(strcmp(record.parameters, "0") == 0);
+    CHECK(ring.push(makeEntry("/general/connection", "4"), 4));
+    for (int i = 1 ; i <= 4 ; i++) {
+        CHECK(ring.pop(record));
+        CHECK(strcmp(record.parameters, std::to_string(i).c_str()) == 0);
+    }
+    CHECK(!ring.pop(record));
+}
+
+/**
+ * A function that checks strings that do not fit are cut and still null terminated.
+ */
+void testCut() {
+    LogRing ring(2);
+    LogRecord record;
+    CHECK(ring.push(makeEntry(string(LOG_RECORD_ENDPOINT_SIZE * 2, 'e'), ""), 0));
+    CHECK(ring.pop(record));
+    CHECK(strlen(record.endpoint) == LOG_RECORD_ENDPOINT_SIZE - 1);
+}
+
+/**
+ * A function that checks every record pushed by several threads is popped exactly once.
+ */
+void testThreads() {
+    const int threadCount = 4;
+    const int perThread = 20000;
+    LogRing ring(256);
+    vector<std::thread> producers;
+    for (int t = 0 ; t < threadCount ; t++) {
+        producers.emplace_back([&ring, t] {
+            for (int i = 0 ; i < perThread ; i++) {
+                LogEntry entry = makeEntry("/all/set_rgb", "");
+                entry.count = (uint32_t) i;
+                while (!ring.push(entry, t)) // full, wait for the consumer
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    vector<int> nextCount(threadCount, 0);
+    int popped = 0;
+    bool isOrdered = true;
+    LogRecord record;
+    while (popped < threadCount * perThread) {
+        if (!ring.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if ((int) record.count != nextCount[record.time]) // each producer pushes in order
+            isOrdered = false;
+        nextCount[record.time] = (int) record.count + 1;
+        popped++;
+    }
+    for (auto& x : producers)
+        x.join();
+
+    CHECK(isOrdered);
+    CHECK(!ring.pop(record));
+}
+
+int main() {
+    testOrder();
+    testFull();
+    testCut();
+    testThreads();
+    return finishTest();
+}
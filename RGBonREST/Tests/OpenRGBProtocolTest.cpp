@@ -0,0 +1,135 @@
+//
+// @file : OpenRGBProtocolTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks OpenRGBProtocol builds and reads packets byte for byte as OpenRGB does
+//
+
+#include <string>
+#include <vector>
+
+#include "TestUtils.h"
+#include "../APIServer/SDKEngine/OpenRGBSDK/OpenRGBProtocol.h"
+
+using std::string;
+using std::vector;
+
+
+/**
+ * A function that appends a string the way OpenRGB does, a uint16_t length including the null terminator and then
+ * the bytes.
+ * @param buffer the buffer to append to.
+ * @param value the string to append.
+ */
+void appendString(string& buffer, const string& value) {
+    OpenRGBProtocol::appendUint16(buffer, (uint16_t) (value.size() + 1));
+    buffer += value;
+    buffer += '\0';
+}
+
+/**
+ * A function that builds the reply of RequestControllerData the way OpenRGB serializes a controller.
+ * The controller has a single mode with one color, a single zone with a 2 byte matrix, and ledCount LEDs.
+ * @param protocolVersion the protocol version to serialize with.
+ * @param name the name of the controller.
+ * @param type the device_type of the controller.
+ * @param ledCount how many LEDs the controller has.
+ * @return returns the payload.
+ */
+string buildControllerData(uint32_t protocolVersion, const string& name, uint32_t type, uint16_t ledCount) {
+    string body;
+    OpenRGBProtocol::appendUint32(body, type);
+    appendString(body, name);
+    if (protocolVersion >= 1) appendString(body, "Vendor");
+    appendString(body, "Description");
+    appendString(body, "1.0");
+    appendString(body, "Serial");
+    appendString(body, "Location");
+
+    OpenRGBProtocol::appendUint16(body, 1); // modes
+    OpenRGBProtocol::appendUint32(body, 0); // active mode
+    appendString(body, "Direct");
+    body += string(protocolVersion >= 3 ? 4 * 12 : 4 * 9, '\x01');
+    OpenRGBProtocol::appendUint16(body, 1);
+    OpenRGBProtocol::appendUint32(body, OpenRGBProtocol::packColor(1, 2, 3));
+
+    OpenRGBProtocol::appendUint16(body, 1); // zones
+    appendString(body, "Zone");
+    body += string(4 * 4, '\x02');
+    OpenRGBProtocol::appendUint16(body, 2);
+    body += "\x03\x03";
+
+    OpenRGBProtocol::appendUint16(body, ledCount);
+    for (uint16_t i = 0 ; i < ledCount ; i++) {
+        appendString(body, "LED " + std::to_string(i));
+        OpenRGBProtocol::appendUint32(body, i);
+    }
+    OpenRGBProtocol::appendUint16(body, ledCount);
+    for (uint16_t i = 0 ; i < ledCount ; i++)
+        OpenRGBProtocol::appendUint32(body, 0);
+
+    string payload;
+    OpenRGBProtocol::appendUint32(payload, (uint32_t) (body.size() + 4));
+    return payload + body;
+}
+
+/**
+ * A function that checks a packet is built with a little endian header, and that the header reads back.
+ */
+void testPacket() {
+    string buffer;
+    OpenRGBProtocol::appendPacket(buffer, 2, OpenRGBUpdateLeds, "ab");
+    CHECK(buffer.size() == OPENRGB_HEADER_SIZE + 2);
+    CHECK(buffer == string("ORGB\x02\x00\x00\x00\x1A\x04\x00\x00\x02\x00\x00\x00" "ab", OPENRGB_HEADER_SIZE + 2));
+
+    uint32_t deviceIndex, packetId, payloadSize;
+    CHECK(OpenRGBProtocol::parseHeader(buffer.data(), deviceIndex, packetId, payloadSize));
+    CHECK(deviceIndex == 2);
+    CHECK(packetId == OpenRGBUpdateLeds);
+    CHECK(payloadSize == 2);
+
+    buffer[0] = 'X';
+    CHECK(!OpenRGBProtocol::parseHeader(buffer.data(), deviceIndex, packetId, payloadSize));
+}
+
+/**
+ * A function that checks the payload of UpdateLEDs has its own size, the LED count and every color.
+ */
+void testUpdateLeds() {
+    CHECK(OpenRGBProtocol::packColor(0x11, 0x22, 0x33) == 0x00332211);
+
+    string payload = OpenRGBProtocol::buildUpdateLeds({OpenRGBProtocol::packColor(255, 0, 0),
+                                                       OpenRGBProtocol::packColor(0, 0, 255)});
+    CHECK(payload.size() == 6 + 2 * 4);
+    CHECK(payload == string("\x0E\x00\x00\x00\x02\x00" "\xFF\x00\x00\x00" "\x00\x00\xFF\x00", 14));
+
+    payload = OpenRGBProtocol::buildUpdateLeds({});
+    CHECK(payload == string("\x06\x00\x00\x00\x00\x00", 6));
+}
+
+/**
+ * A function that checks controller data is read for every protocol version that this client supports, and that
+ * truncated data is refused.
+ */
+void testControllerData() {
+    for (uint32_t version = 0 ; version <= OPENRGB_CLIENT_PROTOCOL_VERSION ; version++) {
+        OpenRGBController controller;
+        CHECK(OpenRGBProtocol::parseControllerData(buildControllerData(version, "Keyboard", 5, 3), version, controller));
+        CHECK(controller.name == "Keyboard");
+        CHECK(controller.type == 5);
+        CHECK(controller.ledCount == 3);
+    }
+
+    string payload = buildControllerData(OPENRGB_CLIENT_PROTOCOL_VERSION, "Mouse", 6, 2);
+    OpenRGBController controller;
+    for (size_t length = 0 ; length < payload.size() ; length++)
+        CHECK(!OpenRGBProtocol::parseControllerData(payload.substr(0, length), OPENRGB_CLIENT_PROTOCOL_VERSION,
+                                                    controller));
+    CHECK(!OpenRGBProtocol::parseControllerData(payload, 1, controller)); // modes are shorter before version 3
+}
+
+int main() {
+    testPacket();
+    testUpdateLeds();
+    testControllerData();
+    return finishTest();
+}
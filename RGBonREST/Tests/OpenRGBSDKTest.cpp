@@ -0,0 +1,142 @@
+//
+// @file : OpenRGBSDKTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that runs OpenRGBSDK against OpenRGBReplayServer replaying the sessions in Tools/recordings
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "TestUtils.h"
+#include "../APIServer/SDKEngine/OpenRGBSDK/OpenRGBSDK.h"
+
+using std::string;
+using std::vector;
+
+
+/**
+ * A class that runs OpenRGBReplayServer on its own thread for a single session.
+ */
+class ReplayServer {
+private:
+    std::thread* serverThread;
+    int exitCode = -1;
+public:
+    /**
+     * A constructor member function that starts the server with a recording.
+     * @param serverPath the path of the OpenRGBReplayServer executable.
+     * @param recording the path of the recording to replay.
+     * @param port the port to listen on.
+     */
+    ReplayServer(const string& serverPath, const string& recording, unsigned int port) {
+        string command = "\"" + serverPath + "\" replay \"" + recording + "\" " + std::to_string(port);
+        this->serverThread = new std::thread([this, command] { this->exitCode = system(command.c_str()); });
+    }
+
+    /**
+     * A member function that waits for the session to end.
+     * @return returns true if the client sent every packet that the recording expected.
+     */
+    bool join() {
+        this->serverThread->join();
+        delete this->serverThread;
+        this->serverThread = nullptr;
+        return this->exitCode == 0;
+    }
+
+    ~ReplayServer() {
+        if (this->serverThread != nullptr) this->join();
+    }
+};
+
+/**
+ * A function that connects an SDK, trying again while the server is not listening yet.
+ * @param sdk the SDK to connect.
+ * @return returns true if the SDK was connected.
+ */
+bool connectWhenListening(OpenRGBSDK& sdk) {
+    for (int i = 0 ; i < 100 ; i++) {
+        try {
+            sdk.connect();
+            return true;
+        } catch (SDKExceptions::SDKServiceNotRunning&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+    return false;
+}
+
+/**
+ * A function that checks controllers are enumerated, and that sets send exactly what two_controllers.orgb expects.
+ * @param serverPath the path of the OpenRGBReplayServer executable.
+ * @param recordings the directory of the recordings.
+ * @param port the port to replay on.
+ */
+void testSession(const string& serverPath, const string& recordings, unsigned int port) {
+    ReplayServer server(serverPath, recordings + "/two_controllers.orgb", port);
+    OpenRGBSDK sdk("127.0.0.1", port);
+    CHECK(connectWhenListening(sdk));
+    if (!sdk.isConnected) return;
+
+    map<DeviceType, list<Device*>*> devices = sdk.getDevices();
+    CHECK(devices[DeviceType::Keyboard]->size() == 1);
+    CHECK(devices[DeviceType::Mouse]->size() == 1);
+    if (devices[DeviceType::Mouse]->size() != 1) return;
+    Device* mouse = devices[DeviceType::Mouse]->front();
+    CHECK(devices[DeviceType::Keyboard]->front()->name == "Keyboard");
+    CHECK(mouse->name == "Mouse");
+    CHECK(sdk.getLedIds(mouse).size() == 2);
+
+    sdk.setRGB(DeviceType::Keyboard, 255, 0, 0);
+    sdk.setRGB(DeviceType::ALL, 0, 0, 255);
+    sdk.setLedColors(mouse, {{1, 0, 255, 0}});
+    CHECK(sdk.getStatistics()["packets_sent"] == 4);
+    sdk.disconnect();
+    CHECK(server.join());
+}
+
+/**
+ * A function that checks DeviceListUpdated, which the server sends on its own, disconnects the SDK at the next set.
+ * @param serverPath the path of the OpenRGBReplayServer executable.
+ * @param recordings the directory of the recordings.
+ * @param port the port to replay on.
+ */
+void testDeviceListUpdated(const string& serverPath, const string& recordings, unsigned int port) {
+    ReplayServer server(serverPath, recordings + "/device_list_updated.orgb", port);
+    OpenRGBSDK sdk("127.0.0.1", port);
+    CHECK(connectWhenListening(sdk));
+    if (!sdk.isConnected) return;
+
+    sdk.setRGB(DeviceType::Keyboard, 255, 0, 0); // the server answers this with DeviceListUpdated
+    bool isThrown = false;
+    for (int i = 0 ; i < 100 && !isThrown ; i++) { // until the packet arrived
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        try {
+            sdk.setRGB(DeviceType::Keyboard, 255, 0, 0);
+        } catch (SDKExceptions::AllRGBFailed&) {
+            isThrown = true;
+        }
+    }
+    CHECK(isThrown);
+    CHECK(!sdk.isConnected);
+    CHECK(server.join());
+}
+
+/**
+ * A function that runs every check.
+ * Usage: OpenRGBSDKTest <path of OpenRGBReplayServer> <path of Tools/recordings> [port]
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("Usage: %s <path of OpenRGBReplayServer> <path of Tools/recordings> [port]\n", argv[0]);
+        return 1;
+    }
+    unsigned int port = argc > 3 ? (unsigned int) strtoul(argv[3], nullptr, 10) : 16742;
+    testSession(argv[1], argv[2], port);
+    testDeviceListUpdated(argv[1], argv[2], port);
+    return finishTest();
+}
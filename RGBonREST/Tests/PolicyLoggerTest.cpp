@@ -0,0 +1,178 @@
+//
+// @file : PolicyLoggerTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks PolicyLogger samples entries by endpoint and coalesces runs of identical entries
+//
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <chrono>
+
+#include "TestUtils.h"
+#include "../APIServer/RESTServer/Logger/PolicyLogger.h"
+
+using std::string;
+using std::vector;
+using std::map;
+
+
+/**
+ * A class that is a logger which keeps every entry it is given, for checking what PolicyLogger passed on.
+ * PolicyLogger deletes the logger it owns, so the entries are kept in a vector that outlives it.
+ */
+class RecordingLogger : public AbstractLogger {
+private:
+    vector<LogEntry>* entries;
+    mutex* m;
+public:
+    RecordingLogger(vector<LogEntry>* argEntries, mutex* argM) {
+        this->loggerName = "Recording";
+        this->entries = argEntries;
+        this->m = argM;
+    }
+
+    void log(const string& endpointName, const string& parameters, const string& result) override {
+        LogEntry entry;
+        entry.endpoint = endpointName;
+        entry.parameters = parameters;
+        entry.result = result;
+        this->logRequest(entry);
+    }
+
+    void logRequest(const LogEntry& entry) override {
+        lock_guard<mutex> lock(*this->m);
+        this->entries->push_back(entry);
+    }
+};
+
+/**
+ * A function that returns the current time.
+ * @return returns microseconds since epoch.
+ */
+uint64_t getTimeUs() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * A function that makes a LogEntry.
+ * @param endpoint the endpoint of the entry.
+ * @param parameters the parameters of the entry.
+ * @param statusCode the status of the entry.
+ * @param timeUs when the entry was logged.
+ * @return returns the LogEntry.
+ */
+LogEntry makeEntry(const string& endpoint, const string& parameters, int statusCode, uint64_t timeUs) {
+    LogEntry entry;
+    entry.endpoint = endpoint;
+    entry.parameters = parameters;
+    entry.result = statusCode >= 400 ? "Failed" : "Success";
+    entry.statusCode = statusCode;
+    entry.timeUs = timeUs;
+    return entry;
+}
+
+/**
+ * A function that checks sample rates keep exactly their share, that the longest * key and exact keys win, and that
+ * errors are never dropped.
+ */
+void testSampling() {
+    vector<LogEntry> entries;
+    mutex m;
+    map<string, uint64_t> statistics;
+    {
+        PolicyLogger logger(new RecordingLogger(&entries, &m),
+                            {{"*/set_rgb", 0.5}, {"*ll/set_rgb", 0.25}, {"/virtual/set_rgb", 0.0}}, false);
+        for (int i = 0 ; i < 8 ; i++) {
+            logger.logRequest(makeEntry("/corsair/set_rgb", std::to_string(i), 200, 0)); // */set_rgb
+            logger.logRequest(makeEntry("/all/set_rgb", std::to_string(i), 200, 0)); // *ll/set_rgb is longer
+            logger.logRequest(makeEntry("/virtual/set_rgb", std::to_string(i), 200, 0)); // exact key
+            logger.logRequest(makeEntry("/general/connection", std::to_string(i), 200, 0)); // no key matches
+        }
+        logger.logRequest(makeEntry("/virtual/set_rgb", "error", 500, 0));
+        statistics = logger.getStatistics();
+    }
+
+    map<string, int> counts;
+    for (auto const& x : entries)
+        counts[x.endpoint]++;
+    CHECK(counts["/corsair/set_rgb"] == 4);
+    CHECK(counts["/all/set_rgb"] == 2);
+    CHECK(counts["/virtual/set_rgb"] == 1);
+    CHECK(counts["/general/connection"] == 8);
+    CHECK(statistics["sampled_out"] == 4 + 6 + 8);
+    CHECK(statistics["coalesced"] == 0);
+    CHECK(!entries.empty() && entries.back().parameters == "error");
+}
+
+/**
+ * A function that checks a run of identical entries is written once with its count and span, and that a different
+ * entry or the end of the logger ends the run.
+ */
+void testCoalescing() {
+    vector<LogEntry> entries;
+    mutex m;
+    map<string, uint64_t> statistics;
+    uint64_t start = getTimeUs();
+    {
+        PolicyLogger logger(new RecordingLogger(&entries, &m), {}, true);
+        for (uint64_t i = 0 ; i < 5 ; i++) {
+            LogEntry entry = makeEntry("/virtual/set_rgb", "red", 200, start + i * 100);
+            entry.latencyUs = 10 + i;
+            logger.logRequest(entry);
+        }
+        logger.logRequest(makeEntry("/virtual/set_rgb", "blue", 200, start + 1000)); // ends the run of red
+        {
+            lock_guard<mutex> lock(m);
+            CHECK(entries.size() == 1);
+        }
+        logger.logRequest(makeEntry("/virtual/set_rgb", "blue", 200, start + 2000));
+        logger.logRequest(makeEntry("/virtual/set_rgb", "blue", 500, start + 3000)); // other status, other run
+        logger.logRequest(makeEntry("/all/set_rgb", "red", 200, start + 3000)); // other endpoint, own run
+        statistics = logger.getStatistics();
+    } // the destructor writes the runs that are still pending
+
+    CHECK(entries.size() == 4);
+    if (entries.size() != 4)
+        return;
+    CHECK(entries[0].parameters == "red");
+    CHECK(entries[0].count == 5);
+    CHECK(entries[0].timeUs == start);
+    CHECK(entries[0].spanUs == 400);
+    CHECK(entries[0].latencyUs == 14); // the slowest of the run
+    CHECK(entries[1].parameters == "blue" && entries[1].statusCode == 200);
+    CHECK(entries[1].count == 2);
+    CHECK(entries[1].spanUs == 1000);
+
+    int errorRuns = 0;
+    for (size_t i = 2 ; i < 4 ; i++)
+        if (entries[i].statusCode == 500 && entries[i].count == 1) errorRuns++;
+    CHECK(errorRuns == 1);
+    CHECK(statistics["coalesced"] == 4 + 1);
+}
+
+/**
+ * A function that checks identical entries further apart than LOGGER_COALESCE_MAX_MS start a new run.
+ */
+void testCoalesceLimit() {
+    vector<LogEntry> entries;
+    mutex m;
+    uint64_t start = getTimeUs();
+    {
+        PolicyLogger logger(new RecordingLogger(&entries, &m), {}, true);
+        logger.logRequest(makeEntry("/virtual/set_rgb", "red", 200, start));
+        logger.logRequest(makeEntry("/virtual/set_rgb", "red", 200, start + (uint64_t) LOGGER_COALESCE_MAX_MS * 1000));
+    }
+    CHECK(entries.size() == 2);
+    for (auto const& x : entries)
+        CHECK(x.count == 1);
+}
+
+int main() {
+    testSampling();
+    testCoalescing();
+    testCoalesceLimit();
+    return finishTest();
+}
@@ -0,0 +1,207 @@
+//
+// @file : RazerEffectCacheTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks RazerEffectCache evicts least recently used effects and keeps Chroma SDK under its cap
+//
+
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TestUtils.h"
+#include "fakes/FakeRzEffectId.h"
+#include "../APIServer/SDKEngine/RazerSDK/RazerEffectCache.cpp" // built here, so that it sees FakeRzEffectId.h
+#include "../APIServer/Utils/Defines.h"
+
+using std::set;
+using std::string;
+using std::vector;
+
+
+/**
+ * A class that stands in for CreateEffect and DeleteEffect of Chroma SDK, and remembers which effects are alive.
+ */
+class FakeChroma {
+public:
+    set<uint64_t> liveEffects;
+    uint64_t nextId = 1;
+    uint64_t createCount = 0;
+    uint64_t deleteCount = 0;
+    uint64_t unknownDeleteCount = 0; // DeleteEffect of an effect that was not alive.
+    RZRESULT createResult = RZRESULT_SUCCESS;
+
+    /**
+     * A member function that fakes CreateEffect.
+     * @param effectId the new RZEFFECTID is stored here.
+     * @return returns createResult.
+     */
+    RZRESULT createEffect(RZEFFECTID* effectId) {
+        if (this->createResult != RZRESULT_SUCCESS) return this->createResult;
+        effectId->id = this->nextId++;
+        this->liveEffects.insert(effectId->id);
+        this->createCount++;
+        return RZRESULT_SUCCESS;
+    }
+
+    /**
+     * A member function that fakes DeleteEffect.
+     * @param effectId the effect to delete.
+     * @return returns RZRESULT_SUCCESS if the effect was alive, RZRESULT_NOT_FOUND if not.
+     */
+    RZRESULT deleteEffect(RZEFFECTID effectId) {
+        this->deleteCount++;
+        if (this->liveEffects.erase(effectId.id) == 0) {
+            this->unknownDeleteCount++;
+            return RZRESULT_NOT_FOUND;
+        }
+        return RZRESULT_SUCCESS;
+    }
+};
+
+/**
+ * A function that returns an RZEFFECTID.
+ * @param id the id to use.
+ * @return returns the RZEFFECTID.
+ */
+RZEFFECTID effectIdOf(uint64_t id) {
+    RZEFFECTID effectId;
+    effectId.id = id;
+    return effectId;
+}
+
+/**
+ * A function that checks a found effect becomes the most recently used one, so the least recently used is evicted.
+ */
+void testLruOrder() {
+    RazerEffectCache cache(3);
+    RZEFFECTID effectId;
+    CHECK(cache.insert("a", effectIdOf(1)).empty());
+    CHECK(cache.insert("b", effectIdOf(2)).empty());
+    CHECK(cache.insert("c", effectIdOf(3)).empty());
+    CHECK(cache.find("a", effectId) && effectId.id == 1); // a is used again, so b is now the oldest
+
+    vector<RZEFFECTID> evicted = cache.insert("d", effectIdOf(4));
+    CHECK(evicted.size() == 1 && evicted.front().id == 2);
+    CHECK(!cache.find("b", effectId));
+
+    evicted = cache.insert("e", effectIdOf(5)); // c was not used since it was inserted
+    CHECK(evicted.size() == 1 && evicted.front().id == 3);
+    CHECK(cache.find("a", effectId) && effectId.id == 1);
+    CHECK(cache.find("d", effectId) && effectId.id == 4);
+    CHECK(cache.find("e", effectId) && effectId.id == 5);
+}
+
+/**
+ * A function that checks the cache never keeps more effects than its capacity, and keeps at least one.
+ */
+void testHardCap() {
+    RazerEffectCache cache(4);
+    for (uint64_t i = 0 ; i < 100 ; i++) {
+        vector<RZEFFECTID> evicted = cache.insert("key" + std::to_string(i), effectIdOf(i));
+        CHECK(evicted.size() == (i < 4 ? 0 : 1));
+        CHECK(cache.cachedCount.load() <= 4);
+    }
+    CHECK(cache.cachedCount.load() == 4);
+
+    RazerEffectCache minimum(0);
+    CHECK(minimum.insert("a", effectIdOf(1)).empty());
+    CHECK(minimum.insert("b", effectIdOf(2)).size() == 1);
+    CHECK(minimum.cachedCount.load() == 1);
+}
+
+/**
+ * A function that checks hits, misses, evictions and the number of cached effects are counted, and clear returns
+ * every effect that was kept.
+ */
+void testCounters() {
+    RazerEffectCache cache(2);
+    RZEFFECTID effectId;
+    CHECK(!cache.find("a", effectId));
+    cache.insert("a", effectIdOf(1));
+    CHECK(!cache.find("b", effectId));
+    cache.insert("b", effectIdOf(2));
+    CHECK(cache.find("a", effectId));
+    CHECK(cache.find("a", effectId));
+    CHECK(!cache.find("c", effectId));
+    cache.insert("c", effectIdOf(3));
+
+    CHECK(cache.hitCount.load() == 2);
+    CHECK(cache.missCount.load() == 3);
+    CHECK(cache.evictionCount.load() == 1);
+    CHECK(cache.cachedCount.load() == 2);
+
+    vector<RZEFFECTID> removed = cache.clear();
+    CHECK(removed.size() == 2);
+    CHECK(cache.cachedCount.load() == 0);
+    CHECK(!cache.find("a", effectId));
+}
+
+/**
+ * A function that checks an effect that failed to be created is not kept, and nothing is evicted for it.
+ */
+void testFailedCreate() {
+    RazerEffectCache cache(1);
+    FakeChroma chroma;
+    auto create = [&chroma](RZEFFECTID* x) { return chroma.createEffect(x); };
+    auto remove = [&chroma](RZEFFECTID x) { return chroma.deleteEffect(x); };
+    RZEFFECTID effectId;
+
+    CHECK(cache.acquire("a", create, remove, effectId) == RZRESULT_SUCCESS);
+    chroma.createResult = RZRESULT_DEVICE_NOT_CONNECTED;
+    CHECK(cache.acquire("b", create, remove, effectId) == RZRESULT_DEVICE_NOT_CONNECTED);
+    CHECK(chroma.deleteCount == 0);
+    CHECK(cache.acquire("a", create, remove, effectId) == RZRESULT_SUCCESS); // still cached
+    CHECK(chroma.liveEffects.size() == 1);
+}
+
+/**
+ * A function that sets many colors the way RazerSDK::applyEffect does, and checks evicted effects are deleted so that
+ * Chroma SDK never has more than RAZER_EFFECT_CACHE_SIZE effects alive.
+ * Colors repeat, so that both hits and evictions happen all the time.
+ */
+void testSoak() {
+    RazerEffectCache cache(RAZER_EFFECT_CACHE_SIZE);
+    FakeChroma chroma;
+    auto create = [&chroma](RZEFFECTID* x) { return chroma.createEffect(x); };
+    auto remove = [&chroma](RZEFFECTID x) { return chroma.deleteEffect(x); };
+
+    const int effectType = 1; // CHROMA_STATIC
+    uint32_t seed = 12345;
+    uint64_t failureCount = 0;
+    for (int i = 0 ; i < 200000 ; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t color = (seed >> 16) % (RAZER_EFFECT_CACHE_SIZE * 4); // 4 times more colors than the cache keeps
+        int effectClass = (int) ((seed >> 8) % 6);
+
+        RZEFFECTID effectId;
+        string key = RazerEffectCache::makeKey(effectClass, effectType, &color, sizeof(color));
+        if (cache.acquire(key, create, remove, effectId) != RZRESULT_SUCCESS) failureCount++;
+        if (chroma.liveEffects.count(effectId.id) == 0) failureCount++; // the effect to set must be alive
+        if (chroma.liveEffects.size() > RAZER_EFFECT_CACHE_SIZE) failureCount++;
+    }
+    CHECK(failureCount == 0);
+    CHECK(chroma.unknownDeleteCount == 0);
+    CHECK(cache.hitCount.load() > 0);
+    CHECK(chroma.createCount == cache.missCount.load());
+    CHECK(chroma.deleteCount == cache.evictionCount.load());
+    CHECK(chroma.liveEffects.size() == cache.cachedCount.load());
+    printf("[+] %llu hits, %llu misses, %llu evictions\n", (unsigned long long) cache.hitCount.load(),
+           (unsigned long long) cache.missCount.load(), (unsigned long long) cache.evictionCount.load());
+
+    for (auto const& x : cache.clear()) // what RazerSDK::deleteCachedEffects does at disconnect
+        remove(x);
+    CHECK(chroma.liveEffects.empty());
+}
+
+/**
+ * A function that runs every check.
+ */
+int main() {
+    testLruOrder();
+    testHardCap();
+    testCounters();
+    testFailedCreate();
+    testSoak();
+    return finishTest();
+}
@@ -0,0 +1,137 @@
+//
+// @file : SDKExecutorTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks SDKExecutor runs jobs in order, and that submitLatest supersedes waiting jobs of a key
+//
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+
+#include "TestUtils.h"
+#include "../APIServer/SDKEngine/SDKExecutor.h"
+
+using std::vector;
+
+
+/**
+ * A class that holds the worker thread of an executor inside a job until it is opened, so that the following jobs
+ * stay in the queue while the test submits more.
+ */
+class Gate {
+private:
+    mutex m;
+    condition_variable cv;
+    bool isEntered = false;
+    bool isOpen = false;
+public:
+    /**
+     * A member function that is the job which waits for the gate to open.
+     */
+    void wait() {
+        unique_lock<mutex> lock(this->m);
+        this->isEntered = true;
+        this->cv.notify_all();
+        this->cv.wait(lock, [this] { return this->isOpen; });
+    }
+
+    /**
+     * A member function that waits until the worker thread is inside wait().
+     */
+    void waitEntered() {
+        unique_lock<mutex> lock(this->m);
+        this->cv.wait(lock, [this] { return this->isEntered; });
+    }
+
+    /**
+     * A member function that lets the worker thread go on.
+     */
+    void open() {
+        lock_guard<mutex> lock(this->m);
+        this->isOpen = true;
+        this->cv.notify_all();
+    }
+};
+
+/**
+ * A function that checks jobs without a key run in the order they were submitted, and a job that throws does not
+ * stop the worker.
+ */
+void testOrder() {
+    vector<int> ran;
+    {
+        SDKExecutor executor(16);
+        for (int i = 0 ; i < 5 ; i++)
+            CHECK(executor.submit([&ran, i] { ran.push_back(i); }));
+        CHECK(executor.submit([] { throw std::runtime_error("job failed"); }));
+        CHECK(executor.submit([&ran] { ran.push_back(5); }));
+        executor.stop(); // runs everything that was queued
+        CHECK(executor.executedCount == 7);
+        CHECK(!executor.submit([] {}));
+        CHECK(executor.refusedCount == 1);
+    }
+    CHECK((ran == vector<int>{0, 1, 2, 3, 4, 5}));
+}
+
+/**
+ * A function that checks a waiting job is superseded by a newer job with the same key, which goes to the back of the
+ * queue, while jobs of other keys are left alone.
+ */
+void testSupersede() {
+    vector<int> ran;
+    vector<int> superseded;
+    vector<int> listened;
+    Gate gate;
+    SDKExecutor executor(16);
+    executor.setJobListener([&listened](int key) { listened.push_back(key); });
+
+    CHECK(executor.submit([&gate] { gate.wait(); }));
+    gate.waitEntered();
+    CHECK(executor.submitLatest(1, [&ran] { ran.push_back(10); }, [&superseded] { superseded.push_back(10); }));
+    CHECK(executor.submitLatest(2, [&ran] { ran.push_back(20); }, [&superseded] { superseded.push_back(20); }));
+    CHECK(executor.submitLatest(1, [&ran] { ran.push_back(11); }, [&superseded] { superseded.push_back(11); }));
+    CHECK(executor.submitLatest(1, [&ran] { ran.push_back(12); }, [&superseded] { superseded.push_back(12); }));
+    CHECK(executor.getQueueLength() == 2);
+    CHECK((superseded == vector<int>{10, 11})); // called right away, from the submitting thread
+
+    gate.open();
+    executor.stop();
+    CHECK((ran == vector<int>{20, 12}));
+    CHECK((listened == vector<int>{-1, 2, 1}));
+    CHECK(executor.supersededCount == 2);
+    CHECK(executor.executedCount == 3);
+}
+
+/**
+ * A function that checks a full queue refuses new jobs, but still takes a job that supersedes a waiting one, and that
+ * a running job can no longer be superseded.
+ */
+void testCapacity() {
+    vector<int> ran;
+    Gate gate;
+    SDKExecutor executor(2);
+
+    CHECK(executor.submitLatest(1, [&gate] { gate.wait(); }, [] {}));
+    gate.waitEntered();
+    CHECK(executor.submitLatest(1, [&ran] { ran.push_back(1); }, [] {})); // the running job is not replaced
+    CHECK(executor.submit([&ran] { ran.push_back(2); }));
+    CHECK(executor.supersededCount == 0);
+
+    CHECK(!executor.submit([&ran] { ran.push_back(3); }));
+    CHECK(!executor.submitLatest(2, [&ran] { ran.push_back(4); }, [] {}));
+    CHECK(executor.submitLatest(1, [&ran] { ran.push_back(5); }, [] {})); // replaces 1, so it fits
+    CHECK(executor.refusedCount == 2);
+    CHECK(executor.supersededCount == 1);
+
+    gate.open();
+    executor.stop();
+    CHECK((ran == vector<int>{2, 5}));
+}
+
+int main() {
+    testOrder();
+    testSupersede();
+    testCapacity();
+    return finishTest();
+}
@@ -0,0 +1,102 @@
+//
+// @file : ShutdownSignalTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that checks a thread parked on ShutdownSignal uses no CPU, and wakes up from a signal handler
+//
+
+#include <csignal>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "TestUtils.h"
+#include "../APIServer/Utils/ShutdownSignal.h"
+
+#define IDLE_MEASURE_MS 2000 // How long the parked thread is watched
+#define IDLE_CPU_LIMIT_MS 20 // CPU time the whole process may use meanwhile, 1% of IDLE_MEASURE_MS
+
+static ShutdownSignal* testSignal = nullptr;
+static volatile sig_atomic_t receivedSignal = 0;
+
+
+/**
+ * A function that returns CPU time that the whole process used so far, in user and kernel mode.
+ * @return returns microseconds of CPU time.
+ */
+uint64_t getCpuTimeUs() {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+    uint64_t kernel = ((uint64_t) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 10; // 100 ns units
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+           (uint64_t) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+}
+
+/**
+ * A function that handles SIGTERM the way RESTServer does.
+ * @param signalNumber the signal that was received.
+ */
+void signalHandler(int signalNumber) {
+    receivedSignal = signalNumber;
+    if (testSignal != nullptr) testSignal->notify();
+}
+
+/**
+ * A function that checks a parked thread uses nearly no CPU while idle, and wakes up once a signal arrived.
+ */
+void testIdle() {
+    ShutdownSignal shutdownSignal;
+    testSignal = &shutdownSignal;
+    std::signal(SIGTERM, signalHandler);
+
+    std::atomic<bool> isAwake{false};
+    std::thread parkedThread([&shutdownSignal, &isAwake] {
+        shutdownSignal.wait();
+        isAwake = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // let the thread park
+    uint64_t startCpu = getCpuTimeUs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_MEASURE_MS));
+    uint64_t usedCpuUs = getCpuTimeUs() - startCpu;
+    printf("[+] Used %llu us of CPU in %d ms while parked\n", (unsigned long long) usedCpuUs, IDLE_MEASURE_MS);
+    CHECK(usedCpuUs < (uint64_t) IDLE_CPU_LIMIT_MS * 1000);
+    CHECK(!isAwake);
+
+    std::raise(SIGTERM);
+    parkedThread.join();
+    CHECK(isAwake);
+    CHECK(receivedSignal == SIGTERM);
+
+    std::signal(SIGTERM, SIG_DFL);
+    testSignal = nullptr;
+}
+
+/**
+ * A function that checks notify before wait does not get lost, and that notify can be called many times.
+ */
+void testEarlyNotify() {
+    ShutdownSignal shutdownSignal;
+    for (int i = 0 ; i < 100000 ; i++) // more than a pipe holds, so notify must never block
+        shutdownSignal.notify();
+    shutdownSignal.wait();
+    shutdownSignal.wait(); // stays notified, or this test would hang until ctest times out
+}
+
+int main() {
+    testIdle();
+    testEarlyNotify();
+    return finishTest();
+}
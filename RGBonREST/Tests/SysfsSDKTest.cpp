@@ -0,0 +1,171 @@
+//
+// @file : SysfsSDKTest.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A test that runs SysfsSDK against a copy of the fake LED class tree in fixtures/sysfs/leds
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "TestUtils.h"
+#include "../APIServer/SDKEngine/SysfsSDK/SysfsSDK.h"
+
+using std::string;
+using std::vector;
+using std::ifstream;
+
+
+/**
+ * A function that reads the first line of a file in the copied tree.
+ * SysfsSDK writes every value from offset 0 without truncating, just as sysfs takes it, so a shorter value leaves the
+ * rest of a longer one behind it in a regular file. The first line is always the value that was written last.
+ * @param path the path of the file.
+ * @return returns the first line, without the newline.
+ */
+string readValue(const string& path) {
+    ifstream file(path);
+    string line;
+    std::getline(file, line);
+    return line;
+}
+
+/**
+ * A function that returns the names of the devices of a DeviceType.
+ * @param sdk the connected SysfsSDK.
+ * @param deviceType the DeviceType to list.
+ * @return returns the names in the order of the device list.
+ */
+vector<string> getNames(SysfsSDK& sdk, DeviceType deviceType) {
+    vector<string> names;
+    for (auto const& x : *sdk.getDevices()[deviceType])
+        names.push_back(x->name);
+    return names;
+}
+
+/**
+ * A function that checks which nodes become which devices, and that a node without max_brightness is skipped.
+ * @param ledsPath the copied tree.
+ */
+void testConnect(const string& ledsPath) {
+    SysfsSDK sdk(ledsPath);
+    sdk.connect();
+    CHECK(sdk.isConnected);
+    CHECK((getNames(sdk, DeviceType::Keyboard) == vector<string>{"asus-kbd_backlight"}));
+    CHECK((getNames(sdk, DeviceType::Mouse) == vector<string>{"rgb-mouse"}));
+    CHECK((getNames(sdk, DeviceType::ETC) == vector<string>{"rgbw-strip", "status-led"}));
+
+    bool isThrown = false;
+    try {
+        sdk.connect();
+    } catch (SDKExceptions::SDKAlreadyConnected&) {
+        isThrown = true;
+    }
+    CHECK(isThrown);
+
+    sdk.disconnect();
+    CHECK(!sdk.isConnected);
+    isThrown = false;
+    try {
+        sdk.setRGB(DeviceType::ALL, 0, 0, 0);
+    } catch (SDKExceptions::SDKNotConnected&) {
+        isThrown = true;
+    }
+    CHECK(isThrown);
+}
+
+/**
+ * A function that checks setRGB writes brightness and multi_intensity scaled to max_brightness, only for the nodes of
+ * the DeviceType, and skips values that did not change.
+ * @param ledsPath the copied tree.
+ */
+void testSetRGB(const string& ledsPath) {
+    SysfsSDK sdk(ledsPath);
+    sdk.connect();
+
+    sdk.setRGB(DeviceType::ALL, 255, 128, 0);
+    CHECK(readValue(ledsPath + "/asus-kbd_backlight/brightness") == "3");
+    CHECK(readValue(ledsPath + "/rgb-mouse/multi_intensity") == "255 128 0");
+    CHECK(readValue(ledsPath + "/rgb-mouse/brightness") == "255");
+    CHECK(readValue(ledsPath + "/rgbw-strip/multi_intensity") == "100 50 0 0");
+    CHECK(readValue(ledsPath + "/rgbw-strip/brightness") == "100");
+    CHECK(readValue(ledsPath + "/status-led/brightness") == "100");
+    CHECK(sdk.getStatistics()["writes"] == 6);
+
+    sdk.setRGB(DeviceType::Keyboard, 0, 0, 0);
+    CHECK(readValue(ledsPath + "/asus-kbd_backlight/brightness") == "0");
+    CHECK(readValue(ledsPath + "/rgb-mouse/multi_intensity") == "255 128 0");
+
+    sdk.setRGB(DeviceType::Mouse, 255, 128, 0); // nothing changed
+    CHECK(sdk.getStatistics()["writes"] == 7);
+    CHECK(sdk.getStatistics()["writes_skipped"] == 2);
+
+    sdk.setRGB(DeviceType::ETC, 255, 255, 255);
+    CHECK(readValue(ledsPath + "/rgbw-strip/multi_intensity") == "100 100 100 100");
+    CHECK(readValue(ledsPath + "/status-led/brightness") == "100");
+
+    Device* mouse = sdk.getDevices()[DeviceType::Mouse]->front();
+    sdk.setLedColors(mouse, {{0, 0, 0, 255}});
+    CHECK(readValue(ledsPath + "/rgb-mouse/multi_intensity") == "0 0 255");
+
+    bool isThrown = false;
+    try {
+        sdk.setRGB(DeviceType::ALL, 256, 0, 0);
+    } catch (SDKExceptions::InvalidRGBValue&) {
+        isThrown = true;
+    }
+    CHECK(isThrown);
+    CHECK(sdk.getStatistics()["writes_failed"] == 0);
+}
+
+/**
+ * A function that checks a tree without any LED node can not be connected.
+ * @param emptyPath a directory without any node.
+ */
+void testNoDevices(const string& emptyPath) {
+    SysfsSDK sdk(emptyPath);
+    bool isThrown = false;
+    try {
+        sdk.connect();
+    } catch (SDKExceptions::NoDevicesConnected&) {
+        isThrown = true;
+    }
+    CHECK(isThrown);
+    CHECK(!sdk.isConnected);
+}
+
+/**
+ * A function that copies the fixture into a temporary directory, so that the committed files are never written, and
+ * runs every check.
+ * Usage: SysfsSDKTest <path of fixtures/sysfs/leds>
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: %s <path of fixtures/sysfs/leds>\n", argv[0]);
+        return 1;
+    }
+
+    char directory[] = "/tmp/rgbonrest_sysfs_XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        printf("[-] Cannot create a temporary directory\n");
+        return 1;
+    }
+    string ledsPath = string(directory) + "/leds";
+    string emptyPath = string(directory) + "/empty";
+    string command = "cp -R \"" + string(argv[1]) + "\" \"" + ledsPath + "\" && mkdir \"" + emptyPath + "\"";
+    if (system(command.c_str()) != 0) {
+        printf("[-] Cannot copy %s\n", argv[1]);
+        return 1;
+    }
+
+    testConnect(ledsPath);
+    testSetRGB(ledsPath);
+    testNoDevices(emptyPath);
+
+    command = "rm -rf \"" + string(directory) + "\"";
+    if (system(command.c_str()) != 0)
+        printf("[-] Cannot remove %s\n", directory);
+    return finishTest();
+}
@@ -0,0 +1,40 @@
+//
+// @file : TestUtils.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the check macros that every test uses
+//
+
+#ifndef RGBONREST_TESTUTILS_H
+#define RGBONREST_TESTUTILS_H
+#pragma once
+
+#include <cstdio>
+
+static int testFailures = 0; // every test is its own executable, so a single counter per test is enough
+
+/**
+ * A macro that checks a condition, and prints where it was when the condition was false.
+ * The test keeps running after a failed check, so that a single run shows every failure.
+ */
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("[-] %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        testFailures++; \
+    } \
+} while (0)
+
+/**
+ * A function that ends main of a test. The exit code tells ctest whether every check passed.
+ * @return returns 0 if every check passed, 1 if not.
+ */
+static int finishTest() {
+    if (testFailures == 0) {
+        printf("[+] All checks passed\n");
+        return 0;
+    }
+    printf("[-] %d checks failed\n", testFailures);
+    return 1;
+}
+
+
+#endif //RGBONREST_TESTUTILS_H
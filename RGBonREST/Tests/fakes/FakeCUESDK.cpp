@@ -0,0 +1,189 @@
+//
+// @file : FakeCUESDK.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the CUESDK functions CorsairSDK calls, answered from devices given to FakeCUESDK
+//
+
+#include <string>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+#include "FakeCUESDK.h"
+
+using std::string;
+using std::mutex;
+using std::lock_guard;
+
+static mutex fakeMutex;
+static vector<FakeCorsairDevice> fakeDevices;
+static vector<CorsairDeviceInfo> fakeDeviceInfos;
+static vector<vector<CorsairLedPosition>> fakeLedPositions;
+static vector<CorsairLedPositions> fakeLedPositionLists;
+static unsigned int fakeFlushLatencyMs = 0;
+static uint64_t fakeFlushCount = 0;
+static uint64_t fakePositionQueryCount = 0;
+static vector<FakeCorsairBufferCall> fakeBufferCalls;
+
+
+/**
+ * A static member function for class FakeCUESDK that replaces every device, and forgets every call before.
+ * LEDs of a device get ids from 1, in order, the same way iCUE reports its own LEDs.
+ * @param devices the devices to report, in the order of their device indices.
+ * @param flushLatencyMs how long each flush takes until devices acknowledged it.
+ */
+void FakeCUESDK::reset(const vector<FakeCorsairDevice>& devices, unsigned int flushLatencyMs) {
+    lock_guard<mutex> lock(fakeMutex);
+    fakeDevices = devices;
+    fakeDeviceInfos.assign(devices.size(), CorsairDeviceInfo());
+    fakeLedPositions.assign(devices.size(), vector<CorsairLedPosition>());
+    fakeLedPositionLists.assign(devices.size(), CorsairLedPositions());
+    for (size_t i = 0 ; i < devices.size() ; i++) {
+        fakeDeviceInfos[i].type = devices[i].type;
+        fakeDeviceInfos[i].model = "Fake Corsair Device";
+        for (int j = 0 ; j < devices[i].ledCount ; j++) {
+            CorsairLedPosition position = CorsairLedPosition();
+            position.ledId = static_cast<CorsairLedId>(j + 1);
+            fakeLedPositions[i].push_back(position);
+        }
+        fakeLedPositionLists[i].numberOfLed = devices[i].ledCount;
+        fakeLedPositionLists[i].pLedPosition = fakeLedPositions[i].data();
+    }
+    fakeFlushLatencyMs = flushLatencyMs;
+    fakeFlushCount = 0;
+    fakePositionQueryCount = 0;
+    fakeBufferCalls.clear();
+}
+
+/**
+ * A static member function for class FakeCUESDK that returns how many flushes were asked for since reset.
+ * @return returns the number of CorsairSetLedsColorsFlushBuffer and CorsairSetLedsColorsFlushBufferAsync calls.
+ */
+uint64_t FakeCUESDK::getFlushCount() {
+    lock_guard<mutex> lock(fakeMutex);
+    return fakeFlushCount;
+}
+
+/**
+ * A static member function for class FakeCUESDK that returns how many times LED positions were asked for since reset.
+ * @return returns the number of CorsairGetLedPositionsByDeviceIndex calls.
+ */
+uint64_t FakeCUESDK::getPositionQueryCount() {
+    lock_guard<mutex> lock(fakeMutex);
+    return fakePositionQueryCount;
+}
+
+/**
+ * A static member function for class FakeCUESDK that returns every call of CorsairSetLedsColorsBufferByDeviceIndex
+ * since reset.
+ * @return returns the calls, in the order they were made.
+ */
+vector<FakeCorsairBufferCall> FakeCUESDK::getBufferCalls() {
+    lock_guard<mutex> lock(fakeMutex);
+    return fakeBufferCalls;
+}
+
+/**
+ * A function that fakes CorsairPerformProtocolHandshake. The handshake always succeeds.
+ */
+CorsairProtocolDetails CorsairPerformProtocolHandshake() {
+    CorsairProtocolDetails details = CorsairProtocolDetails();
+    details.sdkVersion = "fake";
+    details.serverVersion = "fake";
+    return details;
+}
+
+/**
+ * A function that fakes CorsairGetLastError. No call of FakeCUESDK fails with an error.
+ */
+CorsairError CorsairGetLastError() {
+    return CE_Success;
+}
+
+/**
+ * A function that fakes CorsairRequestControl. Control is always granted.
+ */
+bool CorsairRequestControl(CorsairAccessMode accessMode) {
+    (void) accessMode;
+    return true;
+}
+
+/**
+ * A function that fakes CorsairReleaseControl.
+ */
+bool CorsairReleaseControl(CorsairAccessMode accessMode) {
+    (void) accessMode;
+    return true;
+}
+
+/**
+ * A function that fakes CorsairGetDeviceCount with the devices given to FakeCUESDK::reset.
+ */
+int CorsairGetDeviceCount() {
+    lock_guard<mutex> lock(fakeMutex);
+    return (int) fakeDevices.size();
+}
+
+/**
+ * A function that fakes CorsairGetDeviceInfo. The pointer stays valid until the next reset, like in iCUE.
+ */
+CorsairDeviceInfo* CorsairGetDeviceInfo(int deviceIndex) {
+    lock_guard<mutex> lock(fakeMutex);
+    if (deviceIndex < 0 || deviceIndex >= (int) fakeDeviceInfos.size()) return nullptr;
+    return &fakeDeviceInfos[deviceIndex];
+}
+
+/**
+ * A function that fakes CorsairGetLedPositionsByDeviceIndex. Devices without LEDs return nullptr.
+ */
+CorsairLedPositions* CorsairGetLedPositionsByDeviceIndex(int deviceIndex) {
+    lock_guard<mutex> lock(fakeMutex);
+    fakePositionQueryCount++;
+    if (deviceIndex < 0 || deviceIndex >= (int) fakeLedPositionLists.size()) return nullptr;
+    if (fakeLedPositionLists[deviceIndex].numberOfLed == 0) return nullptr; // iCUE has no positions for these
+    return &fakeLedPositionLists[deviceIndex];
+}
+
+/**
+ * A function that fakes CorsairSetLedsColorsBufferByDeviceIndex. Devices with failsBuffer return false.
+ */
+bool CorsairSetLedsColorsBufferByDeviceIndex(int deviceIndex, int size, CorsairLedColor* ledsColors) {
+    lock_guard<mutex> lock(fakeMutex);
+    fakeBufferCalls.push_back(FakeCorsairBufferCall{deviceIndex, ledsColors,
+                                                    vector<CorsairLedColor>(ledsColors, ledsColors + size)});
+    if (deviceIndex < 0 || deviceIndex >= (int) fakeDevices.size()) return false;
+    return !fakeDevices[deviceIndex].failsBuffer;
+}
+
+/**
+ * A function that fakes CorsairSetLedsColorsFlushBuffer. It counts the flush and blocks for the flush latency.
+ */
+bool CorsairSetLedsColorsFlushBuffer() {
+    unsigned int latencyMs;
+    {
+        lock_guard<mutex> lock(fakeMutex);
+        fakeFlushCount++;
+        latencyMs = fakeFlushLatencyMs;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs)); // iCUE sends the buffer to every device
+    return true;
+}
+
+/**
+ * A function that fakes CorsairSetLedsColorsFlushBufferAsync. It counts the flush and calls back on another
+ * thread once the flush latency passed.
+ */
+bool CorsairSetLedsColorsFlushBufferAsync(void (*callback)(void* context, bool result, CorsairError error),
+                                          void* context) {
+    unsigned int latencyMs;
+    {
+        lock_guard<mutex> lock(fakeMutex);
+        fakeFlushCount++;
+        latencyMs = fakeFlushLatencyMs;
+    }
+    std::thread([callback, context, latencyMs] { // iCUE answers on a thread of its own
+        std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs));
+        callback(context, true, CE_Success);
+    }).detach();
+    return true;
+}
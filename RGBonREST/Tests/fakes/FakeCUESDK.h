@@ -0,0 +1,50 @@
+//
+// @file : FakeCUESDK.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the controls of FakeCUESDK, which links in place of CUESDK so CorsairSDK runs without iCUE
+//
+
+#ifndef RGBONREST_FAKECUESDK_H
+#define RGBONREST_FAKECUESDK_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../../APIServer/SDKEngine/CorsairSDK/includes/CUESDK.h"
+
+using std::vector;
+
+
+/**
+ * A struct that describes a device that FakeCUESDK reports.
+ */
+typedef struct fakeCorsairDevice {
+    CorsairDeviceType type;
+    int ledCount;
+    bool failsBuffer; // CorsairSetLedsColorsBufferByDeviceIndex returns false for this device.
+} FakeCorsairDevice;
+
+/**
+ * A struct that records a call of CorsairSetLedsColorsBufferByDeviceIndex.
+ */
+typedef struct fakeCorsairBufferCall {
+    int deviceIndex;
+    const CorsairLedColor* ledsColors; // the array that was handed in, to tell whether the caller reused it.
+    vector<CorsairLedColor> leds; // a copy of the array at the time of the call.
+} FakeCorsairBufferCall;
+
+/**
+ * A class that controls the CUESDK functions that FakeCUESDK.cpp defines.
+ * Every function of CUESDK that CorsairSDK calls is answered from here, as if iCUE was running with these devices.
+ */
+class FakeCUESDK {
+public:
+    static void reset(const vector<FakeCorsairDevice>&, unsigned int);
+    static uint64_t getFlushCount();
+    static uint64_t getPositionQueryCount();
+    static vector<FakeCorsairBufferCall> getBufferCalls();
+};
+
+
+#endif //RGBONREST_FAKECUESDK_H
@@ -0,0 +1,25 @@
+//
+// @file : FakeRzEffectId.h
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A file that defines the Chroma SDK types RazerEffectCache needs, so it builds without windows.h
+//
+
+#ifndef RGBONREST_FAKERZEFFECTID_H
+#define RGBONREST_FAKERZEFFECTID_H
+#pragma once
+
+#include <cstdint>
+
+#define _RZCHROMASDKTYPES_H_ // RzChromaSDKTypes.h needs windows.h, so it is skipped and these are used instead
+
+typedef long RZRESULT;
+
+/**
+ * A struct that stands in for GUID, which Chroma SDK uses as RZEFFECTID.
+ */
+typedef struct fakeRzEffectId {
+    uint64_t id;
+} RZEFFECTID;
+
+
+#endif //RGBONREST_FAKERZEFFECTID_H
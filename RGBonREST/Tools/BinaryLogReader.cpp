@@ -0,0 +1,197 @@
+//
+// @file : BinaryLogReader.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A tool that converts segment files of BinaryLogger into CSV or a sqlite3 database
+//
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include <sqlite3.h>
+#include "../APIServer/RESTServer/Logger/BinaryLogFormat.h"
+#include "../APIServer/Utils/Misc.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::ifstream;
+using std::ofstream;
+
+
+/**
+ * A function that reads a segment file and adds its records and endpoint table.
+ * Slots that were never written are left out.
+ * @param fileName the name of the segment file.
+ * @param records the list to add records to.
+ * @param endpoints the endpoint id -> name map to add endpoints to.
+ * @return returns true if the file was a segment, false if not.
+ */
+bool readSegment(const string& fileName, vector<BinaryLogRecord>& records, map<uint16_t, string>& endpoints) {
+    ifstream file(fileName, std::ios::binary);
+    string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() < sizeof(BinaryLogHeader))
+        return false;
+
+    BinaryLogHeader header;
+    memcpy(&header, content.data(), sizeof(BinaryLogHeader));
+    if (memcmp(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic)) != 0 || header.version != BINARY_LOG_VERSION ||
+        header.headerSize != sizeof(BinaryLogHeader) || header.recordSize != sizeof(BinaryLogRecord) ||
+        header.endpointCount > BINARY_LOG_MAX_ENDPOINTS ||
+        content.size() < sizeof(BinaryLogHeader) + (size_t) header.recordCapacity * sizeof(BinaryLogRecord))
+        return false;
+
+    for (uint32_t i = 0 ; i < header.endpointCount ; i++)
+        endpoints[(uint16_t) (i + 1)] = string(header.endpoints[i], strnlen(header.endpoints[i], BINARY_LOG_ENDPOINT_NAME_SIZE));
+
+    for (uint32_t i = 0 ; i < header.recordCapacity ; i++) {
+        BinaryLogRecord record;
+        memcpy(&record, content.data() + sizeof(BinaryLogHeader) + i * sizeof(BinaryLogRecord), sizeof(BinaryLogRecord));
+        if (record.sequence != 0)
+            records.push_back(record);
+    }
+    return true;
+}
+
+/**
+ * A function that converts a timestamp of a record into local time.
+ * @param timestampUs microseconds since epoch.
+ * @return returns the time as YYYY-MM-DD HH:MM:SS.ffffff
+ */
+string convertTime(uint64_t timestampUs) {
+    time_t seconds = (time_t) (timestampUs / 1000000);
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", localtime(&seconds));
+    char result[80];
+    snprintf(result, sizeof(result), "%s.%06u", buffer, (unsigned int) (timestampUs % 1000000));
+    return result;
+}
+
+/**
+ * A function that returns the name of the endpoint of a record.
+ * @param endpoints the endpoint id -> name map.
+ * @param endpointId the endpoint id of the record.
+ * @return returns the name, or "Unknown" for endpoints that did not fit into the endpoint table.
+ */
+string convertEndpoint(const map<uint16_t, string>& endpoints, uint16_t endpointId) {
+    auto found = endpoints.find(endpointId);
+    return found == endpoints.end() ? "Unknown" : found->second;
+}
+
+/**
+ * A function that writes records as CSV. Target and color are left empty for requests that had none.
+ * @param fileName the name of the CSV file to write.
+ * @param records the records to write, sorted by sequence.
+ * @param endpoints the endpoint id -> name map.
+ * @return returns true if the file was written, false if not.
+ */
+bool writeCsv(const string& fileName, const vector<BinaryLogRecord>& records, const map<uint16_t, string>& endpoints) {
+    ofstream file(fileName);
+    if (!file)
+        return false;
+
+    file << "sequence,time,endpoint,target,r,g,b,status,latency_us,count,span_ms\n";
+    for (auto const& x : records) {
+        file << x.sequence << "," << convertTime(x.timestampUs) << "," << convertEndpoint(endpoints, x.endpointId) << ",";
+        file << (x.target >= 0 ? Misc::convertDeviceType(x.target) : "") << ",";
+        if (x.hasColor)
+            file << (int) x.r << "," << (int) x.g << "," << (int) x.b << ",";
+        else
+            file << ",,,";
+        file << x.statusCode << "," << x.latencyUs << "," << x.count << "," << x.spanMs << "\n";
+    }
+    return (bool) file;
+}
+
+/**
+ * A function that writes records into table binary_logs of a sqlite3 database, all in a single transaction.
+ * Records that are already in the table are replaced, so the same segments can be converted again.
+ * @param fileName the name of the database file to write.
+ * @param records the records to write, sorted by sequence.
+ * @param endpoints the endpoint id -> name map.
+ * @return returns true if the database was written, false if not.
+ */
+bool writeSqlite(const string& fileName, const vector<BinaryLogRecord>& records, const map<uint16_t, string>& endpoints) {
+    sqlite3* db = nullptr;
+    sqlite3_stmt* statement = nullptr;
+    if (sqlite3_open(fileName.c_str(), &db) != SQLITE_OK ||
+        sqlite3_exec(db, "CREATE TABLE IF NOT EXISTS binary_logs (sequence INTEGER PRIMARY KEY, time DATETIME, "
+                         "endpoint VARCHAR(255), target VARCHAR(255), r INTEGER, g INTEGER, b INTEGER, "
+                         "status INTEGER, latency_us INTEGER, count INTEGER, span_ms INTEGER);", nullptr, nullptr, nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO binary_logs VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11);",
+                           -1, &statement, nullptr) != SQLITE_OK) {
+        sqlite3_close(db);
+        return false;
+    }
+
+    bool isSuccess = sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    for (auto const& x : records) {
+        if (!isSuccess)
+            break;
+        sqlite3_bind_int64(statement, 1, (sqlite3_int64) x.sequence);
+        sqlite3_bind_text(statement, 2, convertTime(x.timestampUs).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(statement, 3, convertEndpoint(endpoints, x.endpointId).c_str(), -1, SQLITE_TRANSIENT);
+        if (x.target >= 0)
+            sqlite3_bind_text(statement, 4, Misc::convertDeviceType(x.target).c_str(), -1, SQLITE_TRANSIENT);
+        else
+            sqlite3_bind_null(statement, 4);
+        for (int i = 0 ; i < 3 ; i++) {
+            int value = i == 0 ? x.r : (i == 1 ? x.g : x.b);
+            if (x.hasColor)
+                sqlite3_bind_int(statement, 5 + i, value);
+            else
+                sqlite3_bind_null(statement, 5 + i);
+        }
+        sqlite3_bind_int(statement, 8, x.statusCode);
+        sqlite3_bind_int64(statement, 9, x.latencyUs);
+        sqlite3_bind_int64(statement, 10, x.count);
+        sqlite3_bind_int64(statement, 11, x.spanMs);
+        isSuccess = sqlite3_step(statement) == SQLITE_DONE;
+        sqlite3_reset(statement);
+    }
+    isSuccess = isSuccess && sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+    sqlite3_finalize(statement);
+    sqlite3_close(db);
+    return isSuccess;
+}
+
+/**
+ * A function that reads every segment that was given, and writes their records in the order they were logged.
+ * Usage: BinaryLogReader <csv | sqlite> <output file> <segment file> [segment file ...]
+ */
+int main(int argc, char** argv) {
+    if (argc < 4 || (strcmp(argv[1], "csv") != 0 && strcmp(argv[1], "sqlite") != 0)) {
+        printf("Usage: %s <csv | sqlite> <output file> <segment file> [segment file ...]\n", argv[0]);
+        return 1;
+    }
+
+    vector<BinaryLogRecord> records;
+    map<uint16_t, string> endpoints;
+    for (int i = 3 ; i < argc ; i++) {
+        if (!readSegment(argv[i], records, endpoints))
+            printf("[-] %s is not a log segment. Skipping it.\n", argv[i]);
+    }
+
+    std::sort(records.begin(), records.end(), [](const BinaryLogRecord& a, const BinaryLogRecord& b) {
+        return a.sequence < b.sequence;
+    });
+    records.erase(std::unique(records.begin(), records.end(), [](const BinaryLogRecord& a, const BinaryLogRecord& b) {
+        return a.sequence == b.sequence; // a segment that was given twice
+    }), records.end());
+
+    bool isSuccess = strcmp(argv[1], "csv") == 0 ? writeCsv(argv[2], records, endpoints) :
+                     writeSqlite(argv[2], records, endpoints);
+    if (!isSuccess) {
+        printf("[-] Cannot write %s\n", argv[2]);
+        return 1;
+    }
+    printf("[+] Wrote %zu records into %s\n", records.size(), argv[2]);
+    return 0;
+}
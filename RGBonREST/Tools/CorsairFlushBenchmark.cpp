@@ -0,0 +1,71 @@
+//
+// @file : CorsairFlushBenchmark.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A tool that measures how long CorsairSDK takes to set ALL against FakeCUESDK with a latency per flush
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../APIServer/SDKEngine/CorsairSDK/CorsairSDK.h"
+#include "../Tests/fakes/FakeCUESDK.h"
+
+using std::string;
+using std::vector;
+
+
+/**
+ * A function that sets colors with a CorsairSDK and measures how long a set took and how many flushes it needed.
+ * @param sdk the connected CorsairSDK to set colors with.
+ * @param deviceTypes the device types to set one by one for each round. {ALL} sets everything with a single setRGB.
+ * @param roundCount how many rounds to run.
+ * @param flushesPerRound the number of flushes a round needed is stored here.
+ * @return returns how many milliseconds a round took.
+ */
+double runBenchmark(CorsairSDK& sdk, const vector<DeviceType>& deviceTypes, int roundCount, double& flushesPerRound) {
+    uint64_t flushCount = FakeCUESDK::getFlushCount();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < roundCount ; i++) {
+        for (auto const& x : deviceTypes)
+            sdk.setRGB(x, i % 256, 0, 255 - i % 256);
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    flushesPerRound = (double) (FakeCUESDK::getFlushCount() - flushCount) / roundCount;
+    return elapsed / roundCount;
+}
+
+/**
+ * A function that compares setting ALL with a single flush against setting each device type with its own flush,
+ * which is what ALL cost before devices were buffered first.
+ * Usage: CorsairFlushBenchmark [flush latency ms] [round count]
+ */
+int main(int argc, char** argv) {
+    unsigned int latencyMs = argc > 1 ? (unsigned int) strtoul(argv[1], nullptr, 10) : 10;
+    int roundCount = argc > 2 ? atoi(argv[2]) : 20;
+    if (roundCount <= 0) roundCount = 1;
+
+    FakeCUESDK::reset({{CDT_Mouse, 4, false}, {CDT_Keyboard, 120, false}, {CDT_Headset, 2, false},
+                       {CDT_MouseMat, 15, false}, {CDT_HeadsetStand, 9, false}, {CDT_CommanderPro, 32, false},
+                       {CDT_MemoryModule, 10, false}, {CDT_Cooler, 16, false}, {CDT_Motherboard, 8, false},
+                       {CDT_GraphicsCard, 6, false}}, latencyMs);
+    CorsairSDK sdk(0); // synchronous flushes, so every flush is waited for
+    sdk.connect();
+
+    vector<DeviceType> perDeviceType = {DeviceType::Mouse, DeviceType::Keyboard, DeviceType::Headset,
+                                        DeviceType::HeadsetStand, DeviceType::RAM, DeviceType::GPU, DeviceType::ETC,
+                                        DeviceType::Mousemat, DeviceType::Mainboard, DeviceType::Cooler};
+    double allFlushes = 0;
+    double perDeviceTypeFlushes = 0;
+    double allMs = runBenchmark(sdk, {DeviceType::ALL}, roundCount, allFlushes);
+    double perDeviceTypeMs = runBenchmark(sdk, perDeviceType, roundCount, perDeviceTypeFlushes);
+
+    printf("flush latency: %u ms, rounds: %d\n", latencyMs, roundCount);
+    printf("%-18s %12s %12s\n", "mode", "flushes", "ms/round");
+    printf("%-18s %12.1f %12.2f\n", "ALL", allFlushes, allMs);
+    printf("%-18s %12.1f %12.2f\n", "per device type", perDeviceTypeFlushes, perDeviceTypeMs);
+    sdk.disconnect();
+    return 0;
+}
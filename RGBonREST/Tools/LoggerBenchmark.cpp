@@ -0,0 +1,65 @@
+//
+// @file : LoggerBenchmark.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A tool that measures how many log entries a second Sqlite3Logger writes at each synchronous level
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../APIServer/RESTServer/Logger/Sqlite3Logger.h"
+
+using std::vector;
+
+
+/**
+ * A function that removes a database file together with its WAL files, so that every run starts empty.
+ * @param fileName the name of the database file.
+ */
+void removeDatabase(const string& fileName) {
+    remove(fileName.c_str());
+    remove((fileName + "-wal").c_str());
+    remove((fileName + "-shm").c_str());
+}
+
+/**
+ * A function that logs entries with a Sqlite3Logger and measures how long it took until all of them were written.
+ * Entries are pushed only while the ring has room, so that the writer is measured instead of how fast entries drop.
+ * @param fileName the name of the database file to write.
+ * @param synchronous the synchronous level to open the database with.
+ * @param entryCount how many entries to log.
+ * @return returns how many entries were written a second.
+ */
+double runBenchmark(const string& fileName, const string& synchronous, uint64_t entryCount) {
+    removeDatabase(fileName);
+    auto start = std::chrono::steady_clock::now();
+    {
+        Sqlite3Logger logger(fileName, synchronous);
+        for (uint64_t i = 0 ; i < entryCount ; i++) {
+            while (i - logger.getStatistics()["logged"] >= LOGGER_RING_SIZE / 2) // let the writer catch up
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            logger.log("/corsair/set_rgb/", R"({"DeviceType": "Keyboard", "R": 255, "G": 0, "B": 0})", "Success");
+        }
+    } // the destructor returns after every entry was written
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    removeDatabase(fileName);
+    return (double) entryCount / elapsed;
+}
+
+/**
+ * A function that runs the benchmark for every synchronous level.
+ * Usage: LoggerBenchmark [entry count] [database file]
+ */
+int main(int argc, char** argv) {
+    uint64_t entryCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    string fileName = argc > 2 ? argv[2] : "logger_benchmark.db";
+    vector<string> levels = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+    printf("%-10s %15s\n", "level", "inserts/sec");
+    for (auto const& x : levels)
+        printf("%-10s %15.0f\n", x.c_str(), runBenchmark(fileName, x, entryCount));
+    return 0;
+}
@@ -0,0 +1,315 @@
+//
+// @file : OpenRGBReplayServer.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A tool that stands in for an OpenRGB server by replaying a recorded session, or records one from a real server
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <thread>
+
+#include "../APIServer/Utils/SocketUtils.h"
+#include "../APIServer/SDKEngine/OpenRGBSDK/OpenRGBProtocol.h"
+
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+using std::mutex;
+using std::lock_guard;
+
+#define REPLAY_RECEIVE_TIMEOUT_MS 10000 // How long the replay waits for a packet that the recording expects
+#define REPLAY_MAX_PACKET_SIZE 16777216
+
+
+/**
+ * A struct that stores a single line of a recording.
+ * A recording is a text file with a packet on every line, in the order they went over the connection:
+ *     C <device index> <packet id> <payload>    a packet that the client sent
+ *     S <device index> <packet id> <payload>    a packet that the server sent
+ * payload is hex, - for an empty payload, or * in a C line for any payload. Lines that start with # are comments.
+ */
+typedef struct recordedPacket {
+    char direction;
+    uint32_t deviceIndex;
+    uint32_t packetId;
+    bool isAnyPayload;
+    string payload;
+} RecordedPacket;
+
+
+/**
+ * A function that converts bytes into hex.
+ * @param bytes the bytes to convert.
+ * @return returns two lowercase hex digits for every byte, or - when there were no bytes.
+ */
+string toHex(const string& bytes) {
+    if (bytes.empty()) return "-";
+    static const char* digits = "0123456789abcdef";
+    string hex;
+    for (auto const& x : bytes) {
+        hex += digits[((uint8_t) x) >> 4];
+        hex += digits[((uint8_t) x) & 0x0F];
+    }
+    return hex;
+}
+
+/**
+ * A function that converts hex into bytes.
+ * @param hex the hex to convert, or - for no bytes.
+ * @param bytes the bytes are stored here.
+ * @return returns false if hex had an odd length or something that is not a hex digit.
+ */
+bool fromHex(const string& hex, string& bytes) {
+    bytes.clear();
+    if (hex == "-") return true;
+    if (hex.size() % 2 != 0) return false;
+    for (size_t i = 0 ; i < hex.size() ; i += 2) {
+        char* end;
+        string digits = hex.substr(i, 2);
+        long value = strtol(digits.c_str(), &end, 16);
+        if (*end != '\0') return false;
+        bytes += (char) value;
+    }
+    return true;
+}
+
+/**
+ * A function that reads a recording.
+ * @param fileName the name of the recording.
+ * @param packets every packet of the recording is stored here, in order.
+ * @return returns false if the file could not be read or had a malformed line.
+ */
+bool readRecording(const string& fileName, vector<RecordedPacket>& packets) {
+    ifstream file(fileName);
+    if (!file) return false;
+
+    string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        string direction, payload;
+        RecordedPacket packet;
+        stream >> direction >> packet.deviceIndex >> packet.packetId >> payload;
+        packet.direction = direction.empty() ? '?' : direction[0];
+        packet.isAnyPayload = payload == "*" && packet.direction == 'C';
+        if (stream.fail() || (packet.direction != 'C' && packet.direction != 'S') ||
+            (!packet.isAnyPayload && !fromHex(payload, packet.payload))) {
+            printf("[-] %s:%d is not a recorded packet\n", fileName.c_str(), lineNumber);
+            return false;
+        }
+        packets.push_back(packet);
+    }
+    return true;
+}
+
+/**
+ * A function that receives exactly the given number of bytes.
+ * @param socketHandle the socket to receive from.
+ * @param buffer the buffer to store bytes into.
+ * @param length the number of bytes to receive.
+ * @return returns true if every byte was received, false if the socket was closed, failed or timed out.
+ */
+bool receiveExactly(SocketHandle socketHandle, char* buffer, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        int result = recv(socketHandle, buffer + received, (int) (length - received), 0);
+        if (result <= 0) return false;
+        received += result;
+    }
+    return true;
+}
+
+/**
+ * A function that receives a whole packet.
+ * @param socketHandle the socket to receive from.
+ * @param packet the packet is stored here, without a direction.
+ * @return returns false if the socket was closed, failed, timed out or received something that is not a packet.
+ */
+bool receivePacket(SocketHandle socketHandle, RecordedPacket& packet) {
+    char header[OPENRGB_HEADER_SIZE];
+    uint32_t payloadSize;
+    if (!receiveExactly(socketHandle, header, OPENRGB_HEADER_SIZE) ||
+        !OpenRGBProtocol::parseHeader(header, packet.deviceIndex, packet.packetId, payloadSize) ||
+        payloadSize > REPLAY_MAX_PACKET_SIZE)
+        return false;
+
+    packet.isAnyPayload = false;
+    packet.payload.assign(payloadSize, '\0');
+    return payloadSize == 0 || receiveExactly(socketHandle, &packet.payload[0], payloadSize);
+}
+
+/**
+ * A function that sends a whole packet.
+ * @param socketHandle the socket to send to.
+ * @param packet the packet to send.
+ * @return returns true if every byte was sent, false if the connection failed.
+ */
+bool sendPacket(SocketHandle socketHandle, const RecordedPacket& packet) {
+    string buffer;
+    OpenRGBProtocol::appendPacket(buffer, packet.deviceIndex, packet.packetId, packet.payload);
+    size_t sent = 0;
+    while (sent < buffer.size()) {
+        int length = send(socketHandle, buffer.data() + sent, (int) (buffer.size() - sent), MSG_NOSIGNAL);
+        if (length <= 0) return false;
+        sent += length;
+    }
+    return true;
+}
+
+/**
+ * A function that listens on 127.0.0.1 and accepts a single connection.
+ * @param port the port to listen on.
+ * @return returns the accepted socket, or INVALID_SOCKET if listening or accepting failed.
+ */
+SocketHandle acceptClient(unsigned int port) {
+    sockaddr_in address{};
+    SocketUtils::fillAddress("127.0.0.1", port, address);
+    SocketHandle listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocket == INVALID_SOCKET) return INVALID_SOCKET;
+
+    int reuse = 1; // a previous run might have left the port in TIME_WAIT
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*) &reuse, sizeof(reuse));
+    if (bind(listenSocket, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR ||
+        listen(listenSocket, 1) == SOCKET_ERROR) {
+        SocketUtils::closeSocket(listenSocket);
+        return INVALID_SOCKET;
+    }
+
+    printf("[+] Waiting for a client on 127.0.0.1:%u\n", port);
+    fflush(stdout);
+    SocketHandle clientSocket = accept(listenSocket, nullptr, nullptr);
+    SocketUtils::closeSocket(listenSocket);
+    return clientSocket;
+}
+
+/**
+ * A function that replays a recording to a single client.
+ * S lines are sent as they are. C lines must be matched by the next packet from the client, which means the same
+ * device index, packet id and payload. After the last line, packets from the client are read until it disconnects.
+ * @param clientSocket the connected client.
+ * @param packets the recording.
+ * @return returns true if the client sent every packet that the recording expected.
+ */
+bool replay(SocketHandle clientSocket, const vector<RecordedPacket>& packets) {
+    SocketUtils::setReceiveTimeout(clientSocket, REPLAY_RECEIVE_TIMEOUT_MS);
+    for (size_t i = 0 ; i < packets.size() ; i++) {
+        const RecordedPacket& expected = packets[i];
+        if (expected.direction == 'S') {
+            if (!sendPacket(clientSocket, expected)) {
+                printf("[-] Packet %zu: cannot send to the client\n", i + 1);
+                return false;
+            }
+            continue;
+        }
+
+        RecordedPacket received;
+        if (!receivePacket(clientSocket, received)) {
+            printf("[-] Packet %zu: the client sent nothing, expected packet id %u\n", i + 1, expected.packetId);
+            return false;
+        }
+        if (received.deviceIndex != expected.deviceIndex || received.packetId != expected.packetId ||
+            (!expected.isAnyPayload && received.payload != expected.payload)) {
+            printf("[-] Packet %zu: expected C %u %u %s\n", i + 1, expected.deviceIndex, expected.packetId,
+                   expected.isAnyPayload ? "*" : toHex(expected.payload).c_str());
+            printf("[-] Packet %zu: received C %u %u %s\n", i + 1, received.deviceIndex, received.packetId,
+                   toHex(received.payload).c_str());
+            return false;
+        }
+    }
+
+    printf("[+] Replayed %zu packets\n", packets.size());
+    RecordedPacket received;
+    while (receivePacket(clientSocket, received)) // anything after the recording is fine
+        printf("[+] After the recording: C %u %u %s\n", received.deviceIndex, received.packetId,
+               toHex(received.payload).c_str());
+    return true;
+}
+
+/**
+ * A function that forwards packets from one socket to another and writes them into a recording.
+ * Returns when either side disconnects, and then shuts down both so that the other direction stops as well.
+ * @param from the socket to read from.
+ * @param to the socket to forward to.
+ * @param direction C when from is the client, S when from is the server.
+ * @param file the recording to write lines into.
+ * @param m the mutex that keeps lines of both directions whole.
+ */
+void forwardPackets(SocketHandle from, SocketHandle to, char direction, ofstream& file, mutex& m) {
+    RecordedPacket packet;
+    while (receivePacket(from, packet) && sendPacket(to, packet)) {
+        lock_guard<mutex> lock(m);
+        file << direction << " " << packet.deviceIndex << " " << packet.packetId << " " << toHex(packet.payload) << "\n";
+        file.flush();
+    }
+    SocketUtils::shutdownSocket(from);
+    SocketUtils::shutdownSocket(to);
+}
+
+/**
+ * A function that runs the tool.
+ * Usage: OpenRGBReplayServer replay <recording> [port]
+ *        OpenRGBReplayServer record <recording> <port> <OpenRGB host> <OpenRGB port>
+ * Either way a single client is served, then the tool exits. replay exits with 0 when the client matched the recording.
+ */
+int main(int argc, char** argv) {
+    bool isReplay = argc >= 3 && strcmp(argv[1], "replay") == 0;
+    bool isRecord = argc >= 6 && strcmp(argv[1], "record") == 0;
+    if (!isReplay && !isRecord) {
+        printf("Usage: %s replay <recording> [port]\n", argv[0]);
+        printf("       %s record <recording> <port> <OpenRGB host> <OpenRGB port>\n", argv[0]);
+        return 1;
+    }
+
+    vector<RecordedPacket> packets;
+    if (isReplay && !readRecording(argv[2], packets)) {
+        printf("[-] Cannot read %s\n", argv[2]);
+        return 1;
+    }
+    if (!SocketUtils::initialize()) return 1;
+
+    unsigned int port = argc > 3 ? (unsigned int) strtoul(argv[3], nullptr, 10) : 6742;
+    SocketHandle clientSocket = acceptClient(port);
+    if (clientSocket == INVALID_SOCKET) {
+        printf("[-] Cannot listen on port %u\n", port);
+        SocketUtils::cleanup();
+        return 1;
+    }
+
+    bool isSuccess;
+    if (isReplay) {
+        isSuccess = replay(clientSocket, packets);
+    } else {
+        sockaddr_in address{};
+        SocketHandle serverSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        ofstream file(argv[2]);
+        isSuccess = file && serverSocket != INVALID_SOCKET &&
+                    SocketUtils::fillAddress(argv[4], (unsigned int) strtoul(argv[5], nullptr, 10), address) &&
+                    connect(serverSocket, (sockaddr*) &address, sizeof(address)) != SOCKET_ERROR;
+        if (isSuccess) {
+            mutex m;
+            file << "# Recorded from " << argv[4] << ":" << argv[5] << "\n";
+            std::thread clientThread(forwardPackets, clientSocket, serverSocket, 'C', std::ref(file), std::ref(m));
+            forwardPackets(serverSocket, clientSocket, 'S', file, m);
+            clientThread.join();
+            printf("[+] Wrote %s\n", argv[2]);
+        } else {
+            printf("[-] Cannot record into %s from %s:%s\n", argv[2], argv[4], argv[5]);
+        }
+        if (serverSocket != INVALID_SOCKET) SocketUtils::closeSocket(serverSocket);
+    }
+
+    SocketUtils::shutdownSocket(clientSocket);
+    SocketUtils::closeSocket(clientSocket);
+    SocketUtils::cleanup();
+    return isSuccess ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+//
+// @file : SlowClientBenchmark.cpp
+// @author : Gooday2die (Isu Kim) @ dev.gooday2die@gmail.com
+// @brief : A tool that measures how many requests a second RESTServer answers while many clients send bodies slowly
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "../APIServer/Utils/SocketUtils.h"
+
+using std::string;
+using std::vector;
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::thread;
+
+#define SLOW_CLIENT_BYTE_INTERVAL_MS 100 // How long a slow client waits between every byte of its body
+#define BENCHMARK_RECEIVE_TIMEOUT_MS 10000 // How long a client waits for a reply before counting the request as failed
+#define BENCHMARK_FAST_CLIENTS 8 // How many clients send whole requests back to back
+
+
+/**
+ * A struct that stores where to send requests and what to send.
+ */
+typedef struct benchmarkTarget {
+    string ip;
+    unsigned int port;
+    string path;
+    string body;
+} BenchmarkTarget;
+
+/**
+ * A struct that stores what the fast clients saw during a phase.
+ */
+typedef struct phaseResult {
+    uint64_t replyCount;
+    uint64_t failureCount;
+    uint64_t slowReplyCount;
+    double requestsPerSecond;
+    double p50Ms;
+    double p99Ms;
+} PhaseResult;
+
+
+/**
+ * A function that connects to the server.
+ * @param target the server to connect to.
+ * @return returns the connected socket, or INVALID_SOCKET if it could not connect.
+ */
+SocketHandle connectTo(const BenchmarkTarget& target) {
+    sockaddr_in address;
+    if (!SocketUtils::fillAddress(target.ip, target.port, address)) return INVALID_SOCKET;
+
+    SocketHandle socketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (socketHandle == INVALID_SOCKET) return INVALID_SOCKET;
+    if (connect(socketHandle, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR) {
+        SocketUtils::closeSocket(socketHandle);
+        return INVALID_SOCKET;
+    }
+    SocketUtils::setReceiveTimeout(socketHandle, BENCHMARK_RECEIVE_TIMEOUT_MS);
+    return socketHandle;
+}
+
+/**
+ * A function that sends every byte of data.
+ * @param socketHandle the socket to send to.
+ * @param data the bytes to send.
+ * @return returns false if the connection failed.
+ */
+bool sendAll(SocketHandle socketHandle, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int result = send(socketHandle, data.data() + sent, (int) (data.size() - sent), MSG_NOSIGNAL);
+        if (result <= 0) return false;
+        sent += result;
+    }
+    return true;
+}
+
+/**
+ * A function that waits for a reply and reads it until the server closes the connection.
+ * @param socketHandle the socket to read from.
+ * @return returns true if the reply started with an HTTP status line.
+ */
+bool receiveReply(SocketHandle socketHandle) {
+    string reply;
+    char buffer[4096];
+    while (true) {
+        int result = recv(socketHandle, buffer, sizeof(buffer), 0);
+        if (result <= 0) break; // closed, or timed out
+        reply.append(buffer, result);
+    }
+    return reply.compare(0, 5, "HTTP/") == 0;
+}
+
+/**
+ * A function that builds the head of a POST request.
+ * @param target the server and the body to send.
+ * @return returns the request line and headers, without the body.
+ */
+string buildHead(const BenchmarkTarget& target) {
+    return "POST " + target.path + " HTTP/1.1\r\nHost: " + target.ip + "\r\nContent-Type: application/json\r\n"
+           "Content-Length: " + std::to_string(target.body.size()) + "\r\nConnection: close\r\n\r\n";
+}
+
+/**
+ * A function that is a slow client. It sends the head of a request at once, then its body a byte at a time, and
+ * starts over once it was answered, until isRunning is false.
+ * @param target the server and the body to send.
+ * @param isRunning the flag that stops the client.
+ * @param replyCount the number of replies the client got is added to this.
+ */
+void runSlowClient(const BenchmarkTarget& target, const atomic<bool>& isRunning, atomic<uint64_t>& replyCount) {
+    string head = buildHead(target);
+    while (isRunning) {
+        SocketHandle socketHandle = connectTo(target);
+        if (socketHandle == INVALID_SOCKET) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CLIENT_BYTE_INTERVAL_MS));
+            continue;
+        }
+
+        bool isSent = sendAll(socketHandle, head);
+        for (size_t i = 0 ; isSent && i < target.body.size() && isRunning ; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CLIENT_BYTE_INTERVAL_MS));
+            isSent = sendAll(socketHandle, target.body.substr(i, 1));
+        }
+        if (isSent && isRunning && receiveReply(socketHandle)) replyCount++;
+        SocketUtils::closeSocket(socketHandle);
+    }
+}
+
+/**
+ * A function that is a fast client. It sends whole requests back to back and records how long each took.
+ * @param target the server and the body to send.
+ * @param isRunning the flag that stops the client.
+ * @param latencies the milliseconds of every answered request are added to this.
+ * @param latencyMutex the mutex that guards latencies.
+ * @param failureCount the number of requests that were not answered is added to this.
+ */
+void runFastClient(const BenchmarkTarget& target, const atomic<bool>& isRunning, vector<double>& latencies,
+                   mutex& latencyMutex, atomic<uint64_t>& failureCount) {
+    string request = buildHead(target) + target.body;
+    vector<double> ownLatencies;
+    while (isRunning) {
+        auto start = std::chrono::steady_clock::now();
+        SocketHandle socketHandle = connectTo(target);
+        bool isAnswered = (socketHandle != INVALID_SOCKET) && sendAll(socketHandle, request) &&
+                          receiveReply(socketHandle);
+        if (socketHandle != INVALID_SOCKET) SocketUtils::closeSocket(socketHandle);
+
+        if (isAnswered)
+            ownLatencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        else
+            failureCount++;
+    }
+    lock_guard<mutex> lock(latencyMutex);
+    latencies.insert(latencies.end(), ownLatencies.begin(), ownLatencies.end());
+}
+
+/**
+ * A function that runs fast clients next to slow clients for a while and measures the fast clients.
+ * @param target the server and the body to send.
+ * @param slowClientCount how many slow clients to run.
+ * @param seconds how long to run.
+ * @return returns what the fast clients saw.
+ */
+PhaseResult runPhase(const BenchmarkTarget& target, unsigned int slowClientCount, unsigned int seconds) {
+    atomic<bool> isRunning{true};
+    atomic<uint64_t> slowReplyCount{0};
+    atomic<uint64_t> failureCount{0};
+    vector<double> latencies;
+    mutex latencyMutex;
+
+    vector<thread> slowClients;
+    for (unsigned int i = 0 ; i < slowClientCount ; i++)
+        slowClients.emplace_back(runSlowClient, std::cref(target), std::cref(isRunning), std::ref(slowReplyCount));
+    std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CLIENT_BYTE_INTERVAL_MS * 2)); // let them connect
+
+    auto start = std::chrono::steady_clock::now();
+    vector<thread> fastClients;
+    for (unsigned int i = 0 ; i < BENCHMARK_FAST_CLIENTS ; i++)
+        fastClients.emplace_back(runFastClient, std::cref(target), std::cref(isRunning), std::ref(latencies),
+                                 std::ref(latencyMutex), std::ref(failureCount));
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    isRunning = false;
+    for (auto& x : fastClients) x.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto& x : slowClients) x.join();
+
+    PhaseResult result = PhaseResult();
+    std::sort(latencies.begin(), latencies.end());
+    result.replyCount = latencies.size();
+    result.failureCount = failureCount.load();
+    result.slowReplyCount = slowReplyCount.load();
+    result.requestsPerSecond = (double) latencies.size() / elapsed;
+    if (!latencies.empty()) {
+        result.p50Ms = latencies[latencies.size() / 2];
+        result.p99Ms = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    }
+    return result;
+}
+
+/**
+ * A function that measures the fast clients alone, then next to slow clients.
+ * When handlers block a thread of the listener while a body arrives, slow clients take every thread and the second
+ * phase drops to almost nothing. When they do not, both phases should be close.
+ * Usage: SlowClientBenchmark <ip> <port> [slow client count] [seconds a phase] [path]
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("Usage: %s <ip> <port> [slow client count] [seconds a phase] [path]\n", argv[0]);
+        return 1;
+    }
+    BenchmarkTarget target;
+    target.ip = argv[1];
+    target.port = (unsigned int) strtoul(argv[2], nullptr, 10);
+    unsigned int slowClientCount = argc > 3 ? (unsigned int) strtoul(argv[3], nullptr, 10) : 64;
+    unsigned int seconds = argc > 4 ? (unsigned int) strtoul(argv[4], nullptr, 10) : 10;
+    target.path = argc > 5 ? argv[5] : "/virtual/set_rgb";
+    target.body = R"({"DeviceType": "Keyboard", "R": 255, "G": 0, "B": 0})";
+
+    if (!SocketUtils::initialize()) {
+        printf("[-] Could not initialize sockets\n");
+        return 1;
+    }
+    printf("%-14s %12s %10s %10s %10s %12s\n", "slow clients", "requests/s", "p50 ms", "p99 ms", "failed", "slow replies");
+    for (unsigned int x : {0u, slowClientCount}) {
+        PhaseResult result = runPhase(target, x, seconds);
+        printf("%-14u %12.1f %10.2f %10.2f %10llu %12llu\n", x, result.requestsPerSecond, result.p50Ms, result.p99Ms,
+               (unsigned long long) result.failureCount, (unsigned long long) result.slowReplyCount);
+    }
+    SocketUtils::cleanup();
+    return 0;
+}